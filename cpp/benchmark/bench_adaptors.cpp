@@ -0,0 +1,66 @@
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/adaptors.hpp"   // for Filter, Map
+#include "mamba/builtins/int.hpp"        // for Int
+#include "mamba/builtins/iteration.hpp"  // for ForEach
+#include "mamba/builtins/list.hpp"       // for List
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+List<Int> MakeList(Int size) {
+  List<Int> l;
+
+  for (Int i = 0; i < size; ++i) {
+    l.Append(i);
+  }
+
+  return l;
+}
+
+constexpr auto kIsEven = [](Int i) { return i % 2 == 0; };
+constexpr auto kSquare = [](Int i) { return i * i; };
+
+}  // anonymous namespace
+
+// sum(x * x for x in l if x % 2 == 0), materializing a list at every stage
+// as the generated code did before adaptors
+void BM_PipelineIntermediateLists(::benchmark::State& state) {
+  auto l = MakeList(state.range(0));
+
+  for (auto _ : state) {
+    List<Int> evens;
+    ForEach(l, [&evens](Int i) {
+      if (kIsEven(i)) {
+        evens.Append(i);
+      }
+    });
+
+    List<Int> squares;
+    ForEach(evens, [&squares](Int i) { squares.Append(kSquare(i)); });
+
+    Int sum = 0;
+    ForEach(squares, [&sum](Int i) { sum += i; });
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PipelineIntermediateLists)->Range(1 << 6, 1 << 16);
+
+void BM_PipelineAdaptors(::benchmark::State& state) {
+  auto l = MakeList(state.range(0));
+
+  for (auto _ : state) {
+    Int sum = 0;
+    ForEach(Map(kSquare, Filter(kIsEven, l)), [&sum](Int i) { sum += i; });
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PipelineAdaptors)->Range(1 << 6, 1 << 16);
+
+}  // namespace mamba::builtins::benchmark
@@ -0,0 +1,108 @@
+#include <algorithm>  // for lower_bound
+#include <vector>     // for vector
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/bisect.hpp"  // for BisectLeft, Insort
+#include "mamba/builtins/int.hpp"     // for Int
+#include "mamba/builtins/list.hpp"    // for List
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+// Pseudo-random values in [0, 2 * size), so that half of the searches miss
+std::vector<Int> MakeQueries(Int size) {
+  std::vector<Int> res;
+  unsigned int seed = 12345;
+
+  for (Int i = 0; i < 1024; ++i) {
+    seed = seed * 1103515245 + 12345;
+    res.emplace_back(static_cast<Int>((seed >> 8) % (2 * size)));
+  }
+
+  return res;
+}
+
+}  // anonymous namespace
+
+void BM_ListBisectLeft(::benchmark::State& state) {
+  List<Int> l;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    l.Append(2 * i);
+  }
+
+  const auto queries = MakeQueries(state.range(0));
+
+  for (auto _ : state) {
+    for (const auto x : queries) {
+      ::benchmark::DoNotOptimize(BisectLeft(l, x));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK(BM_ListBisectLeft)->Range(1 << 4, 1 << 22);
+
+// Baseline for the above, with a binary search that branches
+void BM_StdLowerBound(::benchmark::State& state) {
+  std::vector<Int> v;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    v.emplace_back(2 * i);
+  }
+
+  const auto queries = MakeQueries(state.range(0));
+
+  for (auto _ : state) {
+    for (const auto x : queries) {
+      ::benchmark::DoNotOptimize(std::lower_bound(v.cbegin(), v.cend(), x));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK(BM_StdLowerBound)->Range(1 << 4, 1 << 22);
+
+// Builds a sorted list of state.range(0) elements one insertion at a time
+void BM_ListInsort(::benchmark::State& state) {
+  const auto values = MakeQueries(state.range(0));
+
+  for (auto _ : state) {
+    List<Int> l;
+
+    for (Int i = 0; i < state.range(0); ++i) {
+      Insort(l, values[i % values.size()]);
+    }
+
+    ::benchmark::DoNotOptimize(l.Len());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListInsort)->Range(1 << 4, 1 << 14);
+
+// Baseline for the above, through List::Insert()
+void BM_ListInsertAtBisect(::benchmark::State& state) {
+  const auto values = MakeQueries(state.range(0));
+
+  for (auto _ : state) {
+    List<Int> l;
+
+    for (Int i = 0; i < state.range(0); ++i) {
+      const auto x = values[i % values.size()];
+      l.Insert(BisectRight(l, x), x);
+    }
+
+    ::benchmark::DoNotOptimize(l.Len());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListInsertAtBisect)->Range(1 << 4, 1 << 14);
+
+}  // namespace mamba::builtins::benchmark
@@ -0,0 +1,83 @@
+#include <deque>  // for deque
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/deque.hpp"  // for Deque
+#include "mamba/builtins/int.hpp"    // for Int
+#include "mamba/builtins/list.hpp"   // for List
+
+namespace mamba::builtins::benchmark {
+
+// A FIFO queue holding state.range(0) elements, as in a breadth-first search:
+// each iteration pops the first element and appends a new one
+void BM_DequeFifo(::benchmark::State& state) {
+  Deque<Int> d;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    d.Append(i);
+  }
+
+  for (auto _ : state) {
+    d.Append(d.PopLeft() + 1);
+  }
+
+  ::benchmark::DoNotOptimize(d.Len());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DequeFifo)->Range(1 << 4, 1 << 16);
+
+// Same as above with a list, whose Pop(0) shifts all the other elements
+void BM_ListFifo(::benchmark::State& state) {
+  List<Int> l;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    l.Append(i);
+  }
+
+  for (auto _ : state) {
+    l.Append(l.Pop(0) + 1);
+  }
+
+  ::benchmark::DoNotOptimize(l.Len());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ListFifo)->Range(1 << 4, 1 << 16);
+
+// Baseline for BM_DequeFifo
+void BM_StdDequeFifo(::benchmark::State& state) {
+  std::deque<Int> d;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    d.push_back(i);
+  }
+
+  for (auto _ : state) {
+    const auto elem = d.front();
+    d.pop_front();
+    d.push_back(elem + 1);
+  }
+
+  ::benchmark::DoNotOptimize(d.size());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StdDequeFifo)->Range(1 << 4, 1 << 16);
+
+// Sliding window of state.range(0) elements, kept by the maximum length
+void BM_DequeSlidingWindow(::benchmark::State& state) {
+  Deque<Int> d({}, state.range(0));
+  Int i = 0;
+
+  for (auto _ : state) {
+    d.Append(i++);
+  }
+
+  ::benchmark::DoNotOptimize(d.Len());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DequeSlidingWindow)->Range(1 << 4, 1 << 16);
+
+}  // namespace mamba::builtins::benchmark
@@ -0,0 +1,61 @@
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/__memory/handle.hpp"    // for handle_t
+#include "mamba/builtins/int.hpp"       // for Int
+#include "mamba/builtins/list.hpp"      // for List
+#include "mamba/builtins/sequence.hpp"  // for Len
+
+// Compares the code that the transpiler emits for a local list, depending on
+// whether escape analysis found that the list escapes its function, e.g.
+//
+//   def kernel(i: int) -> int:
+//       xs: list[int] = [i, i + 1, i + 2]
+//       xs.append(i + 3)
+//       return len(xs) + xs[0]
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+constexpr Int kCallsPerIteration = 4096;
+
+Int ValueKernel(Int i) {
+  List<Int> xs = {i, i + 1, i + 2};
+  xs.Append(i + 3);
+
+  return Len(xs) + xs[0];
+}
+
+Int HandleKernel(Int i) {
+  __memory::handle_t<List<Int>> xs = List<Int>::Init(i, i + 1, i + 2);
+  xs->Append(i + 3);
+
+  return Len(xs) + (*xs)[0];
+}
+
+}  // anonymous namespace
+
+void BM_LocalListValue(::benchmark::State& state) {
+  for (auto _ : state) {
+    for (Int i = 0; i < kCallsPerIteration; ++i) {
+      ::benchmark::DoNotOptimize(ValueKernel(i));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kCallsPerIteration);
+}
+
+BENCHMARK(BM_LocalListValue);
+
+void BM_LocalListHandle(::benchmark::State& state) {
+  for (auto _ : state) {
+    for (Int i = 0; i < kCallsPerIteration; ++i) {
+      ::benchmark::DoNotOptimize(HandleKernel(i));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kCallsPerIteration);
+}
+
+BENCHMARK(BM_LocalListHandle);
+
+}  // namespace mamba::builtins::benchmark
@@ -0,0 +1,69 @@
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/generator.hpp"  // for Generator
+#include "mamba/builtins/int.hpp"        // for Int
+#include "mamba/builtins/iteration.hpp"  // for ForEach
+#include "mamba/builtins/list.hpp"       // for List
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+Generator<Int>::handle Squares(Int n) {
+  for (Int i = 0; i < n; ++i) {
+    co_yield i * i;
+  }
+}
+
+List<Int> SquaresList(Int n) {
+  List<Int> res;
+
+  for (Int i = 0; i < n; ++i) {
+    res.Append(i * i);
+  }
+
+  return res;
+}
+
+}  // anonymous namespace
+
+// sum(squares(n)) where squares() yields its values one at a time...
+void BM_SumGenerator(::benchmark::State& state) {
+  for (auto _ : state) {
+    Int total = 0;
+    ForEach(Squares(state.range(0)), [&total](Int i) { total += i; });
+    ::benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SumGenerator)->Range(1 << 4, 1 << 16);
+
+// ...and where it returns a list of all of them
+void BM_SumMaterializedList(::benchmark::State& state) {
+  for (auto _ : state) {
+    Int total = 0;
+    ForEach(SquaresList(state.range(0)), [&total](Int i) { total += i; });
+    ::benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SumMaterializedList)->Range(1 << 4, 1 << 16);
+
+// Creates many short-lived generators, whose frames are recycled by the pool
+void BM_CreateSmallGenerators(::benchmark::State& state) {
+  for (auto _ : state) {
+    auto gen = Squares(4);
+    Int total = 0;
+    ForEach(gen, [&total](Int i) { total += i; });
+    ::benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CreateSmallGenerators);
+
+}  // namespace mamba::builtins::benchmark
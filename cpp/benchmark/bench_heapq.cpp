@@ -0,0 +1,104 @@
+#include <algorithm>  // for sort
+#include <vector>     // for vector
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/heapq.hpp"  // for HeapPush, HeapPop, NSmallest
+#include "mamba/builtins/int.hpp"    // for Int
+#include "mamba/builtins/list.hpp"   // for List
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+std::vector<Int> MakeValues(Int size) {
+  std::vector<Int> res;
+  unsigned int seed = 12345;
+
+  for (Int i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    res.emplace_back(static_cast<Int>(seed >> 8));
+  }
+
+  return res;
+}
+
+// Pops the smallest element of a heap of state.range(0) elements and pushes
+// a new one, as e.g. a priority queue or a k-way merge does
+template <std::size_t Arity>
+void BM_HeapPushPop(::benchmark::State& state) {
+  const auto values = MakeValues(state.range(0) + 1024);
+  List<Int> heap;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    heap.Append(values[i]);
+  }
+
+  Heapify<Arity>(heap);
+
+  std::size_t i = 0;
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(HeapPop<Arity>(heap));
+    HeapPush<Arity>(heap, values[i++ % values.size()]);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // anonymous namespace
+
+BENCHMARK(BM_HeapPushPop<2>)->Range(1 << 4, 1 << 22);
+BENCHMARK(BM_HeapPushPop<4>)->Range(1 << 4, 1 << 22);
+
+// The 100 smallest of state.range(0) elements
+void BM_NSmallest(::benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  List<Int> l;
+
+  for (const auto value : values) {
+    l.Append(value);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(NSmallest(100, l));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_NSmallest)->Range(1 << 8, 1 << 20);
+
+// The smallest half of state.range(0) elements
+void BM_NSmallestHalf(::benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  List<Int> l;
+
+  for (const auto value : values) {
+    l.Append(value);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(NSmallest(state.range(0) / 2, l));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_NSmallestHalf)->Range(1 << 8, 1 << 20);
+
+// Baseline for the above, sorting a copy of all elements
+void BM_SortedPrefix(::benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+
+  for (auto _ : state) {
+    auto copy = values;
+    std::sort(copy.begin(), copy.end());
+    ::benchmark::DoNotOptimize(copy.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SortedPrefix)->Range(1 << 8, 1 << 20);
+
+}  // namespace mamba::builtins::benchmark
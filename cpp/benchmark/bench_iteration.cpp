@@ -0,0 +1,210 @@
+#include <vector>  // for vector
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/__memory/handle.hpp"     // for Init
+#include "mamba/builtins/error.hpp"      // for StopIteration
+#include "mamba/builtins/int.hpp"        // for Int
+#include "mamba/builtins/iteration.hpp"  // for ForEach, Next, TryNext
+#include "mamba/builtins/list.hpp"       // for List
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+constexpr Int kNumberOfLists = 1024;
+constexpr Int kListSize = 4;
+
+std::vector<List<Int>> MakeSmallLists() {
+  std::vector<List<Int>> lists(kNumberOfLists);
+
+  for (Int i = 0; i < kNumberOfLists; ++i) {
+    for (Int j = 0; j < kListSize; ++j) {
+      lists[i].Append(i + j);
+    }
+  }
+
+  return lists;
+}
+
+// Consumes exactly Len() elements so that StopIteration does not dominate
+template <typename It>
+Int Consume(It& it) {
+  Int sum = 0;
+
+  for (Int j = 0; j < kListSize; ++j) {
+    sum += Next(*it);
+  }
+
+  return sum;
+}
+
+}  // anonymous namespace
+
+void BM_IterSmallListsPooled(::benchmark::State& state) {
+  auto lists = MakeSmallLists();
+
+  for (auto _ : state) {
+    for (auto& l : lists) {
+      auto it = l.Iter();
+      ::benchmark::DoNotOptimize(Consume(it));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumberOfLists);
+}
+
+BENCHMARK(BM_IterSmallListsPooled);
+
+// Baseline allocating every iterator from the global heap, as Iter() did
+// before iterators were pooled
+void BM_IterSmallListsGlobalHeap(::benchmark::State& state) {
+  auto lists = MakeSmallLists();
+
+  for (auto _ : state) {
+    for (auto& l : lists) {
+      auto it = __memory::Init<details::ListIterator<Int>>(l.begin(), l.end());
+      ::benchmark::DoNotOptimize(Consume(it));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumberOfLists);
+}
+
+BENCHMARK(BM_IterSmallListsGlobalHeap);
+
+// Drains every list until it is exhausted, the way loops did before TryNext(),
+// i.e. by catching StopIteration
+void BM_DrainSmallListsStopIteration(::benchmark::State& state) {
+  auto lists = MakeSmallLists();
+
+  for (auto _ : state) {
+    for (auto& l : lists) {
+      auto it = l.Iter();
+      Int sum = 0;
+
+      try {
+        while (true) {
+          sum += Next(*it);
+        }
+      } catch (const StopIteration&) {
+      }
+
+      ::benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumberOfLists);
+}
+
+BENCHMARK(BM_DrainSmallListsStopIteration);
+
+void BM_DrainSmallListsTryNext(::benchmark::State& state) {
+  auto lists = MakeSmallLists();
+
+  for (auto _ : state) {
+    for (auto& l : lists) {
+      auto it = l.Iter();
+      Int sum = 0;
+
+      while (auto elem = TryNext(*it)) {
+        sum += *elem;
+      }
+
+      ::benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumberOfLists);
+}
+
+BENCHMARK(BM_DrainSmallListsTryNext);
+
+// Sums a list through the type-erased Iterator<T>, one virtual call per
+// element
+void BM_SumListVirtual(::benchmark::State& state) {
+  List<Int> l;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    l.Append(i);
+  }
+
+  for (auto _ : state) {
+    auto it = l.Iter();
+    Int sum = 0;
+
+    while (auto elem = TryNext(*it)) {
+      sum += *elem;
+    }
+
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SumListVirtual)->Range(1 << 4, 1 << 16);
+
+void BM_SumListForEach(::benchmark::State& state) {
+  List<Int> l;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    l.Append(i);
+  }
+
+  for (auto _ : state) {
+    Int sum = 0;
+    ForEach(l, [&sum](Int elem) { sum += elem; });
+    ::benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SumListForEach)->Range(1 << 4, 1 << 16);
+
+// Copies a list through its type-erased Iterator<T>, as List(It&) does for
+// iterables without a concrete iterator, one virtual call per element...
+void BM_CopyListTryNext(::benchmark::State& state) {
+  List<Int> l;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    l.Append(i);
+  }
+
+  for (auto _ : state) {
+    auto it = l.Iter();
+    List<Int> copy;
+
+    while (auto elem = TryNext(*it)) {
+      copy.Append(*elem);
+    }
+
+    ::benchmark::DoNotOptimize(copy);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CopyListTryNext)->Range(1 << 4, 1 << 16);
+
+// ...and one virtual call per Iterator<T>::kBatchSize elements
+void BM_CopyListNextBatch(::benchmark::State& state) {
+  List<Int> l;
+
+  for (Int i = 0; i < state.range(0); ++i) {
+    l.Append(i);
+  }
+
+  for (auto _ : state) {
+    auto it = l.Iter();
+    List<Int> copy;
+    copy.Extend(*it);
+    ::benchmark::DoNotOptimize(copy);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CopyListNextBatch)->Range(1 << 4, 1 << 16);
+
+}  // namespace mamba::builtins::benchmark
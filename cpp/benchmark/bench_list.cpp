@@ -0,0 +1,220 @@
+#include <algorithm>  // for count_if, find
+#include <vector>     // for vector
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/__memory/storage.hpp"      // for SmallStorage, VectorStorage
+#include "mamba/builtins/comparators.hpp"  // for Eq
+#include "mamba/builtins/float.hpp"        // for Float
+#include "mamba/builtins/int.hpp"          // for Int
+#include "mamba/builtins/iteration.hpp"    // for ForEach, Iter
+#include "mamba/builtins/list.hpp"         // for List
+#include "mamba/builtins/sequence.hpp"     // for Max
+#include "mamba/builtins/slice_view.hpp"   // for kEndIndex
+#include "mamba/builtins/tuple.hpp"        // for Tuple
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+template <typename S>
+List<Int, S> MakeList(Int size) {
+  List<Int, S> l;
+
+  for (Int i = 0; i < size; ++i) {
+    l.Append(i);
+  }
+
+  return l;
+}
+
+// Elements 0, 1, ..., 99, 0, 1, ..., so that any search for -1 is a full scan
+template <typename T>
+std::vector<T> MakeNumbers(Int size) {
+  std::vector<T> res;
+
+  for (Int i = 0; i < size; ++i) {
+    res.emplace_back(static_cast<T>(i % 100));
+  }
+
+  return res;
+}
+
+}  // anonymous namespace
+
+// Simulates passing a read-mostly list to the next stage of a pipeline, which
+// copies it defensively but only reads it
+template <typename S>
+void BM_ListCopyThenRead(::benchmark::State& state) {
+  const auto l = MakeList<S>(state.range(0));
+
+  for (auto _ : state) {
+    const auto copy = l.Copy();
+    const auto& stage_input = *copy;
+    ::benchmark::DoNotOptimize(stage_input.Len() + stage_input[-1]);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ListCopyThenRead, __memory::VectorStorage)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ListCopyThenRead, __memory::CopyOnWriteStorage)
+    ->Range(1 << 10, 1 << 20);
+
+// Creates a short-lived list of a few numbers and appends to it, which is how
+// most lists are used
+template <typename S>
+void BM_SmallListCreateAndAppend(::benchmark::State& state) {
+  const auto size = state.range(0);
+
+  for (auto _ : state) {
+    auto l = List<Int, S>::Init(1, 2);
+
+    for (Int i = 2; i < size; ++i) {
+      l->Append(i);
+    }
+
+    ::benchmark::DoNotOptimize((*l)[-1]);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_SmallListCreateAndAppend, __memory::VectorStorage)
+    ->DenseRange(2, 8, 2)
+    ->Arg(16);
+BENCHMARK_TEMPLATE(BM_SmallListCreateAndAppend, __memory::SmallStorage<>)
+    ->DenseRange(2, 8, 2)
+    ->Arg(16);
+
+// Reads every step-th element of a list, i.e. max(l[::step])
+void BM_ListSliceStepped(::benchmark::State& state) {
+  const auto l = MakeList<__memory::VectorStorage>(1 << 20);
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(Max(l.Slice(0, kEndIndex, state.range(0))));
+  }
+}
+
+BENCHMARK(BM_ListSliceStepped)->RangeMultiplier(4)->Range(1, 64);
+
+void BM_ListViewStepped(::benchmark::State& state) {
+  const auto l = MakeList<__memory::VectorStorage>(1 << 20);
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(Max(l.View(0, kEndIndex, state.range(0))));
+  }
+}
+
+BENCHMARK(BM_ListViewStepped)->RangeMultiplier(4)->Range(1, 64);
+
+template <typename T>
+void BM_ListContainsMissing(::benchmark::State& state) {
+  List<T> l;
+
+  for (const auto elem : MakeNumbers<T>(state.range(0))) {
+    l.Append(elem);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(l.Contains(-1));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListContainsMissing, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_ListContainsMissing, Float)->Range(1 << 10, 10 << 20);
+
+template <typename T>
+void BM_ListCount(::benchmark::State& state) {
+  List<T> l;
+
+  for (const auto elem : MakeNumbers<T>(state.range(0))) {
+    l.Append(elem);
+  }
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(l.Count(42));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListCount, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_ListCount, Float)->Range(1 << 10, 10 << 20);
+
+// Baselines for the above, with the scalar loops List used before
+template <typename T>
+void BM_StdFindMissing(::benchmark::State& state) {
+  const auto v = MakeNumbers<T>(state.range(0));
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(std::find(v.cbegin(), v.cend(), -1));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_StdFindMissing, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_StdFindMissing, Float)->Range(1 << 10, 10 << 20);
+
+template <typename T>
+void BM_StdCountIf(::benchmark::State& state) {
+  const auto v = MakeNumbers<T>(state.range(0));
+  const T elem = 42;
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(std::count_if(
+        v.cbegin(), v.cend(),
+        [elem](const T val) { return operators::Eq(val, elem); }));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_StdCountIf, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_StdCountIf, Float)->Range(1 << 10, 10 << 20);
+
+// Creates a list from a tuple, whose elements are copied in bulk
+void BM_ListFromTuple(::benchmark::State& state) {
+  auto l = MakeList<__memory::VectorStorage>(state.range(0));
+  Tuple<Int> t(l);
+
+  for (auto _ : state) {
+    const List<Int> res(t);
+    ::benchmark::DoNotOptimize(res[-1]);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListFromTuple)->Range(1 << 4, 1 << 20);
+
+// Creates a list from a type-erased iterator, which reserves room for its
+// LengthHint() elements
+void BM_ListFromIterator(::benchmark::State& state) {
+  auto l = MakeList<__memory::VectorStorage>(state.range(0));
+
+  for (auto _ : state) {
+    const List<Int> res(*Iter(l));
+    ::benchmark::DoNotOptimize(res[-1]);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListFromIterator)->Range(1 << 4, 1 << 20);
+
+// Baseline for the above, appending elements one at a time
+void BM_ListAppendFromIterator(::benchmark::State& state) {
+  auto l = MakeList<__memory::VectorStorage>(state.range(0));
+
+  for (auto _ : state) {
+    List<Int> res;
+    ForEach(Iter(l), [&res](Int elem) { res.Append(elem); });
+    ::benchmark::DoNotOptimize(res[-1]);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListAppendFromIterator)->Range(1 << 4, 1 << 20);
+
+}  // namespace mamba::builtins::benchmark
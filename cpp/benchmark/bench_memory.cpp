@@ -0,0 +1,52 @@
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/__memory/arena.hpp"     // for Arena
+#include "mamba/__memory/resource.hpp"  // for CountingResource, ResourceScope
+#include "mamba/builtins/int.hpp"       // for Int
+#include "mamba/builtins/list.hpp"      // for List
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+constexpr Int kListsPerRequest = 4096;
+
+// Simulates a request that creates many short-lived lists
+void CreateShortLivedLists() {
+  for (Int i = 0; i < kListsPerRequest; ++i) {
+    auto l = List<Int>::Init(i, i + 1, i + 2);
+    ::benchmark::DoNotOptimize(l);
+  }
+}
+
+}  // anonymous namespace
+
+void BM_ListInitGlobalHeap(::benchmark::State& state) {
+  __memory::CountingResource heap;
+  __memory::ResourceScope scope(&heap);
+
+  for (auto _ : state) {
+    CreateShortLivedLists();
+  }
+
+  state.counters["handle_mallocs_per_request"] = ::benchmark::Counter(
+      heap.Stats().allocations, ::benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_ListInitGlobalHeap);
+
+void BM_ListInitArena(::benchmark::State& state) {
+  __memory::CountingResource heap;
+  __memory::ResourceScope scope(&heap);
+
+  for (auto _ : state) {
+    __memory::Arena arena(__memory::Arena::kDefaultInitialSize, &heap);
+    CreateShortLivedLists();
+  }
+
+  state.counters["handle_mallocs_per_request"] = ::benchmark::Counter(
+      heap.Stats().allocations, ::benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_ListInitArena);
+
+}  // namespace mamba::builtins::benchmark
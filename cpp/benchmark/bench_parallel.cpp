@@ -0,0 +1,52 @@
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/adaptors.hpp"  // for Map
+#include "mamba/builtins/int.hpp"       // for Int
+#include "mamba/builtins/list.hpp"      // for List
+#include "mamba/builtins/parallel.hpp"  // for ParallelMap
+#include "mamba/builtins/range.hpp"     // for Range
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+// Number of steps of the Collatz sequence from i to 1, i.e. uneven work per
+// element that the workers have to balance
+Int CollatzSteps(Int i) {
+  Int steps = 0;
+
+  for (auto x = static_cast<long long>(i) + 1; x != 1; ++steps) {
+    x = x % 2 == 0 ? x / 2 : 3 * x + 1;
+  }
+
+  return steps;
+}
+
+}  // anonymous namespace
+
+void BM_CollatzMap(::benchmark::State& state) {
+  const Range r(state.range(0));
+
+  for (auto _ : state) {
+    const List<Int> l(Map(CollatzSteps, r));
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CollatzMap)->Range(1 << 10, 1 << 18)->UseRealTime();
+
+void BM_CollatzParallelMap(::benchmark::State& state) {
+  const Range r(state.range(0));
+
+  for (auto _ : state) {
+    const auto l = ParallelMap(CollatzSteps, r);
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CollatzParallelMap)->Range(1 << 10, 1 << 18)->UseRealTime();
+
+}  // namespace mamba::builtins::benchmark
@@ -0,0 +1,61 @@
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/int.hpp"        // for Int
+#include "mamba/builtins/iteration.hpp"  // for ForEach, TryNext
+#include "mamba/builtins/range.hpp"      // for Range
+
+namespace mamba::builtins::benchmark {
+
+// for i in range(n): total += i, as the transpiler emits it
+void BM_RangeCountedLoop(::benchmark::State& state) {
+  const Int n = state.range(0);
+
+  for (auto _ : state) {
+    Int total = 0;
+
+    for (Int i = 0; i < n; i += 1) {
+      total += i;
+    }
+
+    ::benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RangeCountedLoop)->Range(1 << 4, 1 << 16);
+
+void BM_RangeForEach(::benchmark::State& state) {
+  const Range r(state.range(0));
+
+  for (auto _ : state) {
+    Int total = 0;
+    ForEach(r, [&total](Int i) { total += i; });
+    ::benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RangeForEach)->Range(1 << 4, 1 << 16);
+
+void BM_RangeIterator(::benchmark::State& state) {
+  const Range r(state.range(0));
+
+  for (auto _ : state) {
+    auto it = r.Iter();
+    Int total = 0;
+
+    while (auto i = TryNext(*it)) {
+      total += *i;
+    }
+
+    ::benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RangeIterator)->Range(1 << 4, 1 << 16);
+
+}  // namespace mamba::builtins::benchmark
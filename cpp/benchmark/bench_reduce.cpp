@@ -0,0 +1,117 @@
+#include <algorithm>  // for max_element
+#include <numeric>    // for accumulate
+#include <vector>     // for vector
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/builtins/float.hpp"     // for Float
+#include "mamba/builtins/int.hpp"       // for Int
+#include "mamba/builtins/list.hpp"      // for List
+#include "mamba/builtins/sequence.hpp"  // for Sum, Max, Any, Summation
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+template <typename T>
+std::vector<T> MakeNumbers(Int size) {
+  std::vector<T> res;
+
+  for (Int i = 0; i < size; ++i) {
+    res.emplace_back(static_cast<T>(i % 1000));
+  }
+
+  return res;
+}
+
+template <typename T>
+List<T> ToList(const std::vector<T>& input) {
+  List<T> res;
+
+  for (const auto elem : input) {
+    res.Append(elem);
+  }
+
+  return res;
+}
+
+}  // anonymous namespace
+
+template <typename T, Summation S>
+void BM_ListSum(::benchmark::State& state) {
+  const auto l = ToList(MakeNumbers<T>(state.range(0)));
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(Sum(l, 0, S));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListSum, Int, Summation::kCompensated)
+    ->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_ListSum, Float, Summation::kCompensated)
+    ->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_ListSum, Float, Summation::kPairwise)
+    ->Range(1 << 10, 10 << 20);
+
+// Baseline for the above, adding one element at a time
+template <typename T>
+void BM_StdAccumulate(::benchmark::State& state) {
+  const auto v = MakeNumbers<T>(state.range(0));
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(std::accumulate(v.cbegin(), v.cend(), T{0}));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_StdAccumulate, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_StdAccumulate, Float)->Range(1 << 10, 10 << 20);
+
+template <typename T>
+void BM_ListMax(::benchmark::State& state) {
+  const auto l = ToList(MakeNumbers<T>(state.range(0)));
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(Max(l));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListMax, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_ListMax, Float)->Range(1 << 10, 10 << 20);
+
+// Baseline for the above, with std::max_element as List::Max() used before
+// it was vectorized
+template <typename T>
+void BM_StdMaxElement(::benchmark::State& state) {
+  const auto v = MakeNumbers<T>(state.range(0));
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(*std::max_element(v.cbegin(), v.cend()));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_StdMaxElement, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_StdMaxElement, Float)->Range(1 << 10, 10 << 20);
+
+// All elements are zero, so that Any() scans the whole list
+template <typename T>
+void BM_ListAnyZeros(::benchmark::State& state) {
+  const auto l = ToList(std::vector<T>(state.range(0)));
+
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(Any(l));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListAnyZeros, Int)->Range(1 << 10, 10 << 20);
+BENCHMARK_TEMPLATE(BM_ListAnyZeros, Float)->Range(1 << 10, 10 << 20);
+
+}  // namespace mamba::builtins::benchmark
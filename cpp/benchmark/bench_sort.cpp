@@ -0,0 +1,272 @@
+#include <algorithm>  // for sort, stable_sort, swap
+#include <cstddef>    // for size_t
+#include <limits>     // for numeric_limits
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "benchmark/benchmark.h"  // for State, BENCHMARK, DoNotOptimize
+
+#include "mamba/__memory/handle.hpp"        // for handle_t, Init
+#include "mamba/__utils/parallel_sort.hpp"  // for SetParallelSortThreshold
+#include "mamba/builtins/as_str.hpp"        // for AsStr
+#include "mamba/builtins/bool.hpp"          // for Bool
+#include "mamba/builtins/comparators.hpp"   // for Lt
+#include "mamba/builtins/float.hpp"         // for Float
+#include "mamba/builtins/int.hpp"           // for Int
+#include "mamba/builtins/list.hpp"          // for List
+#include "mamba/builtins/object.hpp"        // for Object
+#include "mamba/builtins/str.hpp"           // for Str
+
+namespace mamba::builtins::benchmark {
+namespace {
+
+enum class Shape { kRandom, kNearlySorted };
+
+std::vector<Int> MakeInput(Int size, Shape shape) {
+  std::vector<Int> res(size);
+  unsigned int seed = 12345;
+  const auto next = [&seed]() {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<Int>(seed >> 8);
+  };
+
+  for (Int i = 0; i < size; ++i) {
+    res[i] = shape == Shape::kRandom ? next() : i;
+  }
+
+  if (shape == Shape::kNearlySorted) {
+    // Sorted, except for 1% of the elements swapped with random others
+    for (Int i = 0; i < size / 100; ++i) {
+      std::swap(res[next() % size], res[next() % size]);
+    }
+  }
+
+  return res;
+}
+
+List<Int> ToList(const std::vector<Int>& input) {
+  List<Int> res;
+
+  for (const auto elem : input) {
+    res.Append(elem);
+  }
+
+  return res;
+}
+
+// Stands in for a Python str key, since Str itself has no Lt() yet
+struct Name : public Object, public __memory::EnableHandleFromThis<Name> {
+ public:
+  using self = Name;
+  using handle = __memory::handle_t<self>;
+
+  Name(Str value) : value_(std::move(value)) {}
+
+  static handle Init(Str value) {
+    return __memory::Init<self>(std::move(value));
+  }
+
+  Str Repr() const override { return "'" + value_ + "'"; }
+
+  Bool Lt(const self& other) const { return value_.compare(other.value_) < 0; }
+  Bool Lt(const handle& other) const { return Lt(*other); }
+
+ private:
+  Str value_;
+};
+
+// Stands in for a Python (major, minor) tuple key, which costs an allocation
+// per key() call
+struct Version : public Object,
+                 public __memory::EnableHandleFromThis<Version> {
+ public:
+  using self = Version;
+  using handle = __memory::handle_t<self>;
+
+  Version(Int major, Int minor) : major_(major), minor_(minor) {}
+
+  static handle Init(Int major, Int minor) {
+    return __memory::Init<self>(major, minor);
+  }
+
+  Str Repr() const override {
+    return "(" + AsStr(major_) + ", " + AsStr(minor_) + ")";
+  }
+
+  Bool Lt(const self& other) const {
+    return major_ < other.major_ ||
+           (major_ == other.major_ && minor_ < other.minor_);
+  }
+
+  Bool Lt(const handle& other) const { return Lt(*other); }
+
+ private:
+  Int major_;
+  Int minor_;
+};
+
+Name::handle StrKey(const Int i) {
+  return Name::Init(AsStr(i));
+}
+
+Version::handle VersionKey(const Int i) {
+  return Version::Init(i % 1024, i / 1024);
+}
+
+}  // anonymous namespace
+
+template <Shape S>
+void BM_ListSort(::benchmark::State& state) {
+  const auto input = ToList(MakeInput(state.range(0), S));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto l = input;
+    state.ResumeTiming();
+
+    l.Sort();
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListSort, Shape::kRandom)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_ListSort, Shape::kNearlySorted)->Range(1 << 10, 1 << 22);
+
+// Baseline for the above, with std::sort as List::Sort() used before it was
+// stable
+template <Shape S>
+void BM_StdSort(::benchmark::State& state) {
+  const auto input = MakeInput(state.range(0), S);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto v = input;
+    state.ResumeTiming();
+
+    std::sort(v.begin(), v.end(),
+              [](const Int a, const Int b) { return operators::Lt(a, b); });
+    ::benchmark::DoNotOptimize(v);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_StdSort, Shape::kRandom)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_StdSort, Shape::kNearlySorted)->Range(1 << 10, 1 << 22);
+
+void BM_ListSortFloat(::benchmark::State& state) {
+  List<Float> input;
+
+  for (const auto elem : MakeInput(state.range(0), Shape::kRandom)) {
+    input.Append(static_cast<Float>(elem) / 1024 - 4096);
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto l = input;
+    state.ResumeTiming();
+
+    l.Sort();
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListSortFloat)->Range(1 << 10, 1 << 22);
+
+void BM_ListSortBool(::benchmark::State& state) {
+  List<Bool> input;
+
+  for (const auto elem : MakeInput(state.range(0), Shape::kRandom)) {
+    input.Append(elem % 2 == 0);
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto l = input;
+    state.ResumeTiming();
+
+    l.Sort();
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ListSortBool)->Range(1 << 10, 1 << 22);
+
+template <auto Key>
+void BM_ListSortWithKey(::benchmark::State& state) {
+  const auto input = ToList(MakeInput(state.range(0), Shape::kRandom));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto l = input;
+    state.ResumeTiming();
+
+    l.Sort(Key);
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListSortWithKey, StrKey)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ListSortWithKey, VersionKey)->Range(1 << 10, 1 << 20);
+
+// Baseline for the above, calling the key twice per comparison as
+// List::Sort(key) did before it computed the keys up front
+template <auto Key>
+void BM_StdStableSortWithKey(::benchmark::State& state) {
+  const auto input = MakeInput(state.range(0), Shape::kRandom);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto v = input;
+    state.ResumeTiming();
+
+    std::stable_sort(v.begin(), v.end(), [](const Int a, const Int b) {
+      return operators::Lt(Key(a), Key(b));
+    });
+    ::benchmark::DoNotOptimize(v);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_StdStableSortWithKey, StrKey)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_StdStableSortWithKey, VersionKey)
+    ->Range(1 << 10, 1 << 20);
+
+// Sorts with and without threads, to compare on large lists
+template <bool Parallel>
+void BM_ListSortThreads(::benchmark::State& state) {
+  const auto input = ToList(MakeInput(state.range(0), Shape::kRandom));
+  const auto threshold = __utils::ParallelSortThreshold();
+  __utils::SetParallelSortThreshold(
+      Parallel ? 0 : std::numeric_limits<std::size_t>::max());
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto l = input;
+    state.ResumeTiming();
+
+    l.Sort(VersionKey);
+    ::benchmark::DoNotOptimize(l);
+  }
+
+  __utils::SetParallelSortThreshold(threshold);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ListSortThreads, false)
+    ->Range(1 << 16, 1 << 22)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ListSortThreads, true)
+    ->Range(1 << 16, 1 << 22)
+    ->UseRealTime();
+
+}  // namespace mamba::builtins::benchmark
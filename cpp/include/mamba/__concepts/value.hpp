@@ -17,6 +17,12 @@ concept Value =
     std::same_as<T, __types::Int> || std::same_as<T, __types::Float> ||
     std::same_as<T, __types::Bool> || std::same_as<T, __types::None>;
 
+/// @brief Values that sum() adds, where Bool counts as 0 or 1.
+template <typename T>
+concept Number = std::same_as<T, __types::Int> ||
+                 std::same_as<T, __types::Float> ||
+                 std::same_as<T, __types::Bool>;
+
 template <typename T>
 concept EquatableValue = Value<T> && requires(const T t) {
   { t == t } -> std::same_as<bool>;
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "mamba/__memory/resource.hpp"
+
+namespace mamba::builtins::__memory {
+
+/// @brief Region allocator for handles. While an arena is alive, every Init()
+/// on the creating thread carves its object out of the arena's buffers
+/// instead of going to the global heap, and individual deallocations are
+/// no-ops. Everything is released in one shot when the arena is destroyed.
+/// @note Every handle created inside the arena must be destroyed before the
+/// arena is, so arenas are meant to be scoped to a function or a request.
+class Arena {
+ public:
+  static constexpr std::size_t kDefaultInitialSize = 64 * 1024;
+
+  explicit Arena(
+      std::size_t initial_size = kDefaultInitialSize,
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : upstream_(upstream),
+        buffer_(initial_size, &upstream_),
+        scope_(&buffer_) {}
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /// @brief Releases all memory allocated from the arena so far. Any handle
+  /// still referring to an object in the arena is left dangling.
+  void Release() { buffer_.release(); }
+
+  /// @brief Returns the allocations the arena itself made from its upstream
+  /// resource, i.e. how often it actually had to go to the heap.
+  const AllocationStats& UpstreamStats() const { return upstream_.Stats(); }
+
+  std::pmr::memory_resource* Resource() { return &buffer_; }
+
+ private:
+  CountingResource upstream_;
+  std::pmr::monotonic_buffer_resource buffer_;
+  ResourceScope scope_;
+};
+
+}  // namespace mamba::builtins::__memory
+
+// IWYU pragma: private
@@ -1,17 +1,33 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 
 #include "mamba/__concepts/object.hpp"
+#include "mamba/__memory/intrusive.hpp"
+#include "mamba/__memory/resource.hpp"
 
 namespace mamba::builtins::__memory {
 
 // Simple alias without constraints. Adding concepts::Object here makes it
-// impossible to evaluate T because it is not a complete type at this point
+// impossible to evaluate T because it is not a complete type at this point.
+// Defining MAMBA_INTRUSIVE_HANDLES switches every handle to an intrusive,
+// non-atomic reference count (see intrusive.hpp) for single-threaded programs.
+// kThreadSafeHandles tells whether handles to the same object can be copied
+// from several threads at once.
+#if defined(MAMBA_INTRUSIVE_HANDLES)
+template <typename T>
+using handle_t = IntrusiveHandle<T>;
+
+inline constexpr bool kThreadSafeHandles = kAtomicRefCount;
+#else   // defined(MAMBA_INTRUSIVE_HANDLES)
 template <typename T>
 using handle_t = std::shared_ptr<T>;
 
+inline constexpr bool kThreadSafeHandles = true;
+#endif  // defined(MAMBA_INTRUSIVE_HANDLES)
+
 template <typename T, typename U>
 concept HandleOf = __concepts::Object<U> && requires {
   typename std::enable_if_t<std::is_same_v<T, handle_t<U>>>;
@@ -24,11 +40,53 @@ concept HandleOf = __concepts::Object<U> && requires {
 template <typename T>
 concept Handle = HandleOf<T, typename T::element_type>;
 
+/// @brief Base class for objects that need to hand out handles to themselves,
+/// e.g. iterators returning themselves from Iter(). Objects managed by
+/// handles derive from this instead of std::enable_shared_from_this so that
+/// they work with either handle policy.
+#if defined(MAMBA_INTRUSIVE_HANDLES)
+template <typename T>
+class EnableHandleFromThis : public RefCounted {
+ public:
+  handle_t<T> HandleFromThis() { return handle_t<T>(static_cast<T*>(this)); }
+
+  /// @brief Returns a handle to this object, or an empty handle if no handle
+  /// manages it, e.g. because it is a local variable.
+  handle_t<T> TryHandleFromThis() const {
+    if (UseCount() == 0) {
+      return nullptr;
+    }
+
+    return handle_t<T>(const_cast<T*>(static_cast<const T*>(this)));
+  }
+};
+#else   // defined(MAMBA_INTRUSIVE_HANDLES)
+template <typename T>
+class EnableHandleFromThis : public std::enable_shared_from_this<T> {
+ public:
+  handle_t<T> HandleFromThis() { return this->shared_from_this(); }
+
+  /// @brief Returns a handle to this object, or an empty handle if no handle
+  /// manages it, e.g. because it is a local variable.
+  handle_t<T> TryHandleFromThis() const {
+    return std::const_pointer_cast<T>(this->weak_from_this().lock());
+  }
+};
+#endif  // defined(MAMBA_INTRUSIVE_HANDLES)
+
 /// @brief Instantiates an object of type @tparam T with @p args and returns
-/// a handle to the object.
+/// a handle to the object. The object and its reference count are allocated
+/// together from the current memory resource.
+/// @see resource.hpp
 template <__concepts::Object T, typename... Args>
 static handle_t<T> Init(Args&&... args) {
-  return std::make_shared<T>(std::forward<Args>(args)...);
+#if defined(MAMBA_INTRUSIVE_HANDLES)
+  return InitIntrusive<T>(CurrentResource(), std::forward<Args>(args)...);
+#else   // defined(MAMBA_INTRUSIVE_HANDLES)
+  return std::allocate_shared<T>(
+      std::pmr::polymorphic_allocator<T>(CurrentResource()),
+      std::forward<Args>(args)...);
+#endif  // defined(MAMBA_INTRUSIVE_HANDLES)
 }
 
 }  // namespace mamba::builtins::__memory
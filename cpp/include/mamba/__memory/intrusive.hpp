@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mamba::builtins::__memory {
+
+#if defined(MAMBA_ATOMIC_REFCOUNT)
+inline constexpr bool kAtomicRefCount = true;
+#else   // defined(MAMBA_ATOMIC_REFCOUNT)
+inline constexpr bool kAtomicRefCount = false;
+#endif  // defined(MAMBA_ATOMIC_REFCOUNT)
+
+// Forward declaration
+template <typename T>
+class IntrusiveHandle;
+
+/// @brief Base class that stores the reference count of an object in the
+/// object itself, so that handles to it need neither a separate control block
+/// nor, unless MAMBA_ATOMIC_REFCOUNT is defined, atomic operations.
+/// @note Objects that were not created through InitIntrusive() (e.g. locals
+/// on the stack) are never destroyed by their handles.
+class RefCounted {
+ public:
+  using count_type = std::conditional_t<kAtomicRefCount,
+                                        std::atomic<std::size_t>,
+                                        std::size_t>;
+
+  RefCounted() = default;
+
+  // A copy is a new object, so it does not inherit the count or the way the
+  // original was allocated
+  RefCounted(const RefCounted&) noexcept {}
+  RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+
+  void IncRef() const noexcept { Increment(count_); }
+
+  void DecRef() const noexcept {
+    if (Decrement(count_) && destroy_) {
+      destroy_(const_cast<RefCounted*>(this));
+    }
+  }
+
+  std::size_t UseCount() const noexcept { return Load(count_); }
+
+ protected:
+  ~RefCounted() = default;
+
+ private:
+  template <typename T, typename... Args>
+  friend IntrusiveHandle<T> InitIntrusive(std::pmr::memory_resource* resource,
+                                          Args&&... args);
+
+  static void Increment(std::size_t& count) { ++count; }
+
+  static void Increment(std::atomic<std::size_t>& count) {
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @brief Returns whether this was the last reference.
+  static bool Decrement(std::size_t& count) { return --count == 0; }
+
+  static bool Decrement(std::atomic<std::size_t>& count) {
+    return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  static std::size_t Load(const std::size_t& count) { return count; }
+
+  static std::size_t Load(const std::atomic<std::size_t>& count) {
+    return count.load(std::memory_order_relaxed);
+  }
+
+  mutable count_type count_ = 0;
+
+  // Set by InitIntrusive(), which is the only place that knows the concrete
+  // type and the resource that the object was allocated from
+  void (*destroy_)(RefCounted*) = nullptr;
+  std::pmr::memory_resource* resource_ = nullptr;
+};
+
+/// @brief Handle to an object whose reference count lives in its RefCounted
+/// base. Like std::shared_ptr, it stores the pointer to the count separately
+/// from the object pointer, so that it converts freely to handles of base
+/// classes that do not derive RefCounted themselves (e.g. Iterator<T>).
+template <typename T>
+class IntrusiveHandle {
+ public:
+  using element_type = T;
+
+  constexpr IntrusiveHandle() noexcept = default;
+  constexpr IntrusiveHandle(std::nullptr_t) noexcept {}
+
+  explicit IntrusiveHandle(T* ptr) noexcept
+    requires std::derived_from<T, RefCounted>
+      : IntrusiveHandle(ptr, ptr) {}
+
+  IntrusiveHandle(T* ptr, const RefCounted* ref) noexcept
+      : ptr_(ptr), ref_(ref) {
+    if (ref_) {
+      ref_->IncRef();
+    }
+  }
+
+  IntrusiveHandle(const IntrusiveHandle& other) noexcept
+      : IntrusiveHandle(other.ptr_, other.ref_) {}
+
+  IntrusiveHandle(IntrusiveHandle&& other) noexcept
+      : ptr_(std::exchange(other.ptr_, nullptr)),
+        ref_(std::exchange(other.ref_, nullptr)) {}
+
+  template <typename U>
+    requires std::convertible_to<U*, T*>
+  IntrusiveHandle(const IntrusiveHandle<U>& other) noexcept
+      : IntrusiveHandle(other.ptr_, other.ref_) {}
+
+  template <typename U>
+    requires std::convertible_to<U*, T*>
+  IntrusiveHandle(IntrusiveHandle<U>&& other) noexcept
+      : ptr_(std::exchange(other.ptr_, nullptr)),
+        ref_(std::exchange(other.ref_, nullptr)) {}
+
+  ~IntrusiveHandle() {
+    if (ref_) {
+      ref_->DecRef();
+    }
+  }
+
+  IntrusiveHandle& operator=(IntrusiveHandle other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  void reset() noexcept { IntrusiveHandle().swap(*this); }
+
+  void swap(IntrusiveHandle& other) noexcept {
+    std::swap(ptr_, other.ptr_);
+    std::swap(ref_, other.ref_);
+  }
+
+  T* get() const noexcept { return ptr_; }
+  T& operator*() const noexcept { return *ptr_; }
+  T* operator->() const noexcept { return ptr_; }
+
+  explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+  long use_count() const noexcept {
+    return ref_ ? static_cast<long>(ref_->UseCount()) : 0;
+  }
+
+ private:
+  template <typename U>
+  friend class IntrusiveHandle;
+
+  T* ptr_ = nullptr;
+  const RefCounted* ref_ = nullptr;
+};
+
+// Comparisons mirror those of std::shared_ptr, i.e. they compare identity
+
+template <typename T, typename U>
+bool operator==(const IntrusiveHandle<T>& lhs,
+                const IntrusiveHandle<U>& rhs) noexcept {
+  return lhs.get() == rhs.get();
+}
+
+template <typename T>
+bool operator==(const IntrusiveHandle<T>& lhs, std::nullptr_t) noexcept {
+  return !lhs;
+}
+
+template <typename T, typename U>
+std::strong_ordering operator<=>(const IntrusiveHandle<T>& lhs,
+                                 const IntrusiveHandle<U>& rhs) noexcept {
+  return std::compare_three_way()(lhs.get(), rhs.get());
+}
+
+/// @brief Allocates an object of type @tparam T from @p resource, constructs
+/// it with @p args and returns the first handle to it. The object returns its
+/// memory to @p resource once the last handle to it is destroyed.
+template <typename T, typename... Args>
+IntrusiveHandle<T> InitIntrusive(std::pmr::memory_resource* resource,
+                                 Args&&... args) {
+  static_assert(std::derived_from<T, RefCounted>,
+                "Objects behind intrusive handles must derive RefCounted");
+
+  void* memory = resource->allocate(sizeof(T), alignof(T));
+  T* ptr = nullptr;
+
+  try {
+    ptr = ::new (memory) T(std::forward<Args>(args)...);
+  } catch (...) {
+    resource->deallocate(memory, sizeof(T), alignof(T));
+    throw;
+  }
+
+  RefCounted* ref = ptr;
+  ref->resource_ = resource;
+  ref->destroy_ = [](RefCounted* base) {
+    auto* object = static_cast<T*>(base);
+    auto* object_resource = base->resource_;
+
+    object->~T();
+    object_resource->deallocate(object, sizeof(T), alignof(T));
+  };
+
+  return IntrusiveHandle<T>(ptr);
+}
+
+}  // namespace mamba::builtins::__memory
+
+template <typename T>
+struct std::hash<mamba::builtins::__memory::IntrusiveHandle<T>> {
+  std::size_t operator()(
+      const mamba::builtins::__memory::IntrusiveHandle<T>& handle)
+      const noexcept {
+    return std::hash<T*>()(handle.get());
+  }
+};
+
+// IWYU pragma: private
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+#include "mamba/__concepts/object.hpp"
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/intrusive.hpp"
+
+namespace mamba::builtins::__memory {
+
+/// @brief Memory resource for small objects that keeps one free list per size
+/// class. Freed blocks are pushed onto the free list of their size and popped
+/// by the next allocation of that size, so a steady stream of short-lived
+/// objects never touches @p upstream after warming up. New blocks are carved
+/// out of slabs that are only returned to @p upstream on destruction.
+/// @note Not synchronized.
+class FreeListResource : public std::pmr::memory_resource {
+ public:
+  static constexpr std::size_t kGranularity = alignof(std::max_align_t);
+  static constexpr std::size_t kMaxBlockSize = 256;
+  static constexpr std::size_t kSlabSize = 16 * 1024;
+
+  explicit FreeListResource(
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : upstream_(upstream) {}
+
+  FreeListResource(const FreeListResource&) = delete;
+  FreeListResource& operator=(const FreeListResource&) = delete;
+
+  ~FreeListResource() override { Release(); }
+
+  /// @brief Returns whether blocks of @p bytes aligned to @p alignment come
+  /// from the free lists, rather than straight from the upstream resource.
+  static bool IsSmall(std::size_t bytes, std::size_t alignment) {
+    return bytes <= kMaxBlockSize && alignment <= kGranularity;
+  }
+
+  /// @brief Returns all slabs to the upstream resource. Any object still
+  /// allocated from this resource is left dangling.
+  void Release() {
+    while (slabs_) {
+      upstream_->deallocate(std::exchange(slabs_, slabs_->next), kSlabSize,
+                            kGranularity);
+    }
+
+    free_lists_.fill(nullptr);
+    cursor_ = nullptr;
+    slab_end_ = nullptr;
+  }
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  static constexpr std::size_t kNumberOfSizeClasses =
+      kMaxBlockSize / kGranularity;
+
+  static std::size_t SizeClass(std::size_t bytes) {
+    return (std::max<std::size_t>(bytes, 1) - 1) / kGranularity;
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (!IsSmall(bytes, alignment)) {
+      return upstream_->allocate(bytes, alignment);
+    }
+
+    const auto size_class = SizeClass(bytes);
+
+    if (auto* block = free_lists_[size_class]) {
+      free_lists_[size_class] = block->next;
+      return block;
+    }
+
+    return Carve((size_class + 1) * kGranularity);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    if (!IsSmall(bytes, alignment)) {
+      upstream_->deallocate(ptr, bytes, alignment);
+      return;
+    }
+
+    auto& free_list = free_lists_[SizeClass(bytes)];
+    free_list = ::new (ptr) Block{free_list};
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  void* Carve(std::size_t block_size) {
+    if (static_cast<std::size_t>(slab_end_ - cursor_) < block_size) {
+      // The first granule of every slab links it to the previous slab
+      auto* slab = static_cast<std::byte*>(
+          upstream_->allocate(kSlabSize, kGranularity));
+      slabs_ = ::new (slab) Block{slabs_};
+      cursor_ = slab + kGranularity;
+      slab_end_ = slab + kSlabSize;
+    }
+
+    return std::exchange(cursor_, cursor_ + block_size);
+  }
+
+  std::pmr::memory_resource* upstream_;
+  std::array<Block*, kNumberOfSizeClasses> free_lists_{};
+  Block* slabs_ = nullptr;
+  std::byte* cursor_ = nullptr;
+  std::byte* slab_end_ = nullptr;
+};
+
+/// @brief Pool of a single thread, its owner, for small, short-lived objects
+/// such as iterators. Only the owner allocates from it, through a
+/// FreeListResource, but any thread may deallocate: blocks freed by other
+/// threads, e.g. iterators returned by ParallelMap(), are pushed onto a
+/// lock-free list that the owner drains on its next allocation. Once the
+/// owner exits, the pool lives on until the last of its blocks is freed.
+class ThreadLocalPool final : public std::pmr::memory_resource {
+ public:
+  /// @brief Returns the pool of the calling thread, creating it on first use.
+  static ThreadLocalPool* Current() {
+    if (owned_) {
+      return owned_;
+    }
+
+    // Only the first call on each thread pays for the guard of the owner
+    thread_local Owner owner;
+
+    return owner.pool;
+  }
+
+  ThreadLocalPool(const ThreadLocalPool&) = delete;
+  ThreadLocalPool& operator=(const ThreadLocalPool&) = delete;
+
+ private:
+  // Block freed by a thread other than the owner
+  struct RemoteBlock {
+    RemoteBlock* next;
+    std::size_t bytes;
+  };
+
+  static_assert(sizeof(RemoteBlock) <= FreeListResource::kGranularity);
+
+  // Creates the pool of its thread, and orphans it when the thread exits
+  struct Owner {
+    Owner() : pool(new ThreadLocalPool()) { owned_ = pool; }
+    ~Owner() { pool->Orphan(); }
+
+    ThreadLocalPool* pool;
+  };
+
+  ThreadLocalPool() = default;
+  ~ThreadLocalPool() override = default;
+
+  /// @brief Marks the end of the remote list of a pool whose owner exited.
+  static RemoteBlock* Orphaned() {
+    static RemoteBlock sentinel{};
+
+    return &sentinel;
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (!FreeListResource::IsSmall(bytes, alignment)) {
+      return upstream_->allocate(bytes, alignment);
+    }
+
+    if (remote_.load(std::memory_order_relaxed)) {
+      Drain(remote_.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    ++live_;
+
+    return local_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    if (!FreeListResource::IsSmall(bytes, alignment)) {
+      upstream_->deallocate(ptr, bytes, alignment);
+    } else if (owned_ == this) {
+      --live_;
+      local_.deallocate(ptr, bytes, alignment);
+    } else {
+      DeallocateRemote(ptr, bytes);
+    }
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  void DeallocateRemote(void* ptr, std::size_t bytes) {
+    auto* block = ::new (ptr) RemoteBlock{nullptr, bytes};
+    auto* head = remote_.load(std::memory_order_relaxed);
+
+    do {
+      if (head == Orphaned()) {
+        // The block is only reclaimed with the whole pool
+        if (orphaned_live_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          delete this;
+        }
+
+        return;
+      }
+
+      block->next = head;
+    } while (!remote_.compare_exchange_weak(head, block,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+  }
+
+  /// @brief Returns the remote blocks from @p head on to the free lists.
+  void Drain(RemoteBlock* head) {
+    while (head) {
+      auto* block = std::exchange(head, head->next);
+
+      --live_;
+      local_.deallocate(block, block->bytes, FreeListResource::kGranularity);
+    }
+  }
+
+  /// @brief Called by the owner when it exits. Other threads may still hold
+  /// blocks of the pool, so it is deleted by whichever thread frees the last
+  /// one, possibly right here.
+  void Orphan() {
+    owned_ = nullptr;
+    Drain(remote_.exchange(Orphaned(), std::memory_order_acq_rel));
+
+    const auto live = static_cast<std::ptrdiff_t>(live_);
+
+    if (orphaned_live_.fetch_add(live, std::memory_order_acq_rel) + live ==
+        0) {
+      delete this;
+    }
+  }
+
+  // Pool owned by the calling thread, if any, so that deallocating can tell
+  // whether it runs on the owner of the pool
+  static inline thread_local ThreadLocalPool* owned_ = nullptr;
+
+  std::pmr::memory_resource* upstream_ = std::pmr::new_delete_resource();
+  FreeListResource local_{upstream_};
+
+  // Small blocks allocated by the owner that it has not seen freed yet
+  std::size_t live_ = 0;
+
+  std::atomic<RemoteBlock*> remote_ = nullptr;
+
+  // Small blocks still live once the owner exited, minus those freed since.
+  // Remote frees may bring it below 0 before the owner adds its count.
+  std::atomic<std::ptrdiff_t> orphaned_live_ = 0;
+};
+
+/// @brief Returns the pool of the calling thread for small, short-lived
+/// objects such as iterators.
+/// @see ThreadLocalPool
+inline std::pmr::memory_resource* PoolResource() {
+  return ThreadLocalPool::Current();
+}
+
+/// @brief Like Init(), but allocates the object from the pool of the calling
+/// thread instead of the current resource. The last handle to the object may
+/// be released on any thread, even after the creating thread exited.
+/// @see PoolResource()
+template <__concepts::Object T, typename... Args>
+static handle_t<T> InitPooled(Args&&... args) {
+#if defined(MAMBA_INTRUSIVE_HANDLES)
+  return InitIntrusive<T>(PoolResource(), std::forward<Args>(args)...);
+#else   // defined(MAMBA_INTRUSIVE_HANDLES)
+  return std::allocate_shared<T>(
+      std::pmr::polymorphic_allocator<T>(PoolResource()),
+      std::forward<Args>(args)...);
+#endif  // defined(MAMBA_INTRUSIVE_HANDLES)
+}
+
+// Size of the header of blocks from AllocatePooled(), which keeps the
+// alignment of the rest of the block
+inline constexpr std::size_t kPooledHeaderSize = alignof(std::max_align_t);
+
+/// @brief Allocates @p bytes from the pool of the calling thread for objects
+/// that are not managed by handles, e.g. coroutine frames. The block records
+/// its pool in a header, so that DeallocatePooled() can free it on any
+/// thread.
+inline void* AllocatePooled(std::size_t bytes) {
+  auto* pool = PoolResource();
+  auto* block = static_cast<std::byte*>(
+      pool->allocate(bytes + kPooledHeaderSize, kPooledHeaderSize));
+
+  ::new (block) std::pmr::memory_resource*(pool);
+
+  return block + kPooledHeaderSize;
+}
+
+/// @brief Frees @p ptr of @p bytes, which AllocatePooled() returned.
+inline void DeallocatePooled(void* ptr, std::size_t bytes) {
+  auto* block = static_cast<std::byte*>(ptr) - kPooledHeaderSize;
+  auto* pool = *std::launder(
+      reinterpret_cast<std::pmr::memory_resource**>(block));
+
+  pool->deallocate(block, bytes + kPooledHeaderSize, kPooledHeaderSize);
+}
+
+}  // namespace mamba::builtins::__memory
+
+// IWYU pragma: private
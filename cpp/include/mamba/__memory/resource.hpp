@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+
+namespace mamba::builtins::__memory {
+
+/// @brief Returns the memory resource that Init() allocates new objects from
+/// on the calling thread. Defaults to the global heap.
+inline std::pmr::memory_resource*& CurrentResource() {
+  thread_local std::pmr::memory_resource* resource =
+      std::pmr::new_delete_resource();
+
+  return resource;
+}
+
+/// @brief Makes @p resource the current resource of the calling thread for the
+/// lifetime of the scope, then restores the previous one.
+class ResourceScope {
+ public:
+  explicit ResourceScope(std::pmr::memory_resource* resource)
+      : previous_(std::exchange(CurrentResource(), resource)) {}
+
+  ResourceScope(const ResourceScope&) = delete;
+  ResourceScope& operator=(const ResourceScope&) = delete;
+
+  ~ResourceScope() { CurrentResource() = previous_; }
+
+ private:
+  std::pmr::memory_resource* previous_;
+};
+
+struct AllocationStats {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytes_allocated = 0;
+  std::size_t bytes_deallocated = 0;
+};
+
+/// @brief Memory resource that forwards to @p upstream and counts the
+/// allocations and deallocations that pass through it.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  explicit CountingResource(
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : upstream_(upstream) {}
+
+  const AllocationStats& Stats() const { return stats_; }
+
+  void ResetStats() { stats_ = {}; }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    auto* ptr = upstream_->allocate(bytes, alignment);
+
+    ++stats_.allocations;
+    stats_.bytes_allocated += bytes;
+
+    return ptr;
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    upstream_->deallocate(ptr, bytes, alignment);
+
+    ++stats_.deallocations;
+    stats_.bytes_deallocated += bytes;
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource* upstream_;
+  AllocationStats stats_;
+};
+
+}  // namespace mamba::builtins::__memory
+
+// IWYU pragma: private
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "mamba/__utils/cow_vector.hpp"
+#include "mamba/__utils/small_vector.hpp"
+
+namespace mamba::builtins::__memory {
+
+/// @brief Storage policy that gives every container its own buffer, so that
+/// copies are eager. This is the default.
+struct VectorStorage {
+  template <typename T>
+  using type = std::vector<T>;
+};
+
+/// @brief Storage policy that shares the buffer between copies of a container
+/// until one of them is mutated, which makes copying O(1) for read-mostly
+/// containers.
+/// @see cow_vector.hpp
+struct CopyOnWriteStorage {
+  template <typename T>
+  using type = __utils::CowVector<T>;
+};
+
+/// @brief Storage policy that keeps up to @tparam N elements inside the
+/// container itself, so that small containers need no buffer on the heap.
+/// @see small_vector.hpp
+template <std::size_t N = 8>
+struct SmallStorage {
+  template <typename T>
+  using type = __utils::SmallVector<T, N>;
+};
+
+template <typename S>
+concept StoragePolicy = requires { typename S::template type<int>; };
+
+}  // namespace mamba::builtins::__memory
+
+// IWYU pragma: private
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Vector whose copies share one buffer until either of them is
+/// mutated, at which point the mutated one detaches with its own copy of the
+/// buffer. Only the subset of the std::vector interface that containers use is
+/// provided. Every non-const member function detaches, including the
+/// non-const begin(), end() and operator[], since they allow writes.
+/// @note Like reallocation of a std::vector, detaching invalidates iterators
+/// that were obtained before, though they keep pointing into the buffer that
+/// is still shared by the other vectors.
+template <typename T>
+class CowVector {
+ public:
+  using vector_type = std::vector<T>;
+  using value_type = T;
+  using size_type = vector_type::size_type;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = vector_type::iterator;
+  using const_iterator = vector_type::const_iterator;
+
+  CowVector() = default;
+
+  // Copies share the buffer, moves steal it
+  CowVector(const CowVector&) = default;
+  CowVector(CowVector&&) noexcept = default;
+  CowVector& operator=(const CowVector&) = default;
+  CowVector& operator=(CowVector&&) noexcept = default;
+
+  /// @brief Returns whether the buffer is shared with another vector.
+  bool IsShared() const noexcept { return data_ && data_.use_count() > 1; }
+
+  size_type size() const noexcept { return Get().size(); }
+  size_type capacity() const noexcept { return Get().capacity(); }
+  bool empty() const noexcept { return Get().empty(); }
+
+  const_iterator begin() const noexcept { return Get().cbegin(); }
+  const_iterator end() const noexcept { return Get().cend(); }
+  const_iterator cbegin() const noexcept { return Get().cbegin(); }
+  const_iterator cend() const noexcept { return Get().cend(); }
+
+  iterator begin() { return Mutable().begin(); }
+  iterator end() { return Mutable().end(); }
+
+  const_reference operator[](size_type idx) const { return Get()[idx]; }
+  reference operator[](size_type idx) { return Mutable()[idx]; }
+
+  void reserve(size_type n) {
+    // Detaching already allocates, so do it with the requested capacity
+    if (IsShared()) {
+      auto data = std::make_shared<vector_type>();
+      data->reserve(std::max(n, size()));
+      data->insert(data->end(), data_->cbegin(), data_->cend());
+      data_ = std::move(data);
+      return;
+    }
+
+    Mutable().reserve(n);
+  }
+
+  void clear() {
+    // No need to copy elements that are about to be dropped
+    if (IsShared()) {
+      data_.reset();
+      return;
+    }
+
+    Mutable().clear();
+  }
+
+  void resize(size_type n) { Mutable().resize(n); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    return Mutable().emplace_back(std::forward<Args>(args)...);
+  }
+
+  void push_back(const T& value) { Mutable().push_back(value); }
+  void pop_back() { Mutable().pop_back(); }
+
+  iterator insert(const_iterator pos, const T& value) {
+    const auto offset = pos - Get().cbegin();
+    auto& data = Mutable();
+
+    return data.insert(data.cbegin() + offset, value);
+  }
+
+  /// @brief Inserts [@p first, @p last) before @p pos. As with std::vector,
+  /// the range must not be in this vector.
+  template <std::forward_iterator It>
+  iterator insert(const_iterator pos, It first, It last) {
+    const auto offset = pos - Get().cbegin();
+    auto& data = Mutable();
+
+    return data.insert(data.cbegin() + offset, first, last);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    const auto first_offset = first - Get().cbegin();
+    const auto last_offset = last - Get().cbegin();
+    auto& data = Mutable();
+
+    return data.erase(data.cbegin() + first_offset,
+                      data.cbegin() + last_offset);
+  }
+
+  bool operator==(const CowVector& other) const {
+    return data_ == other.data_ || Get() == other.Get();
+  }
+
+ private:
+  const vector_type& Get() const noexcept {
+    static const vector_type kEmpty;
+
+    return data_ ? *data_ : kEmpty;
+  }
+
+  vector_type& Mutable() {
+    if (!data_) {
+      data_ = std::make_shared<vector_type>();
+    } else if (data_.use_count() > 1) {
+      data_ = std::make_shared<vector_type>(*data_);
+    }
+
+    return *data_;
+  }
+
+  std::shared_ptr<vector_type> data_;
+};
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Moves the element at @p pos of the @tparam Arity -ary heap at
+/// @p first towards the root, stopping at @p start, while it is less than its
+/// parent as per @p lt. This is Python's heapq._siftdown(), which runs after
+/// appending to the heap.
+template <std::size_t Arity, std::random_access_iterator It, typename Compare>
+void SiftTowardsRoot(It first,
+                     std::iter_difference_t<It> start,
+                     std::iter_difference_t<It> pos,
+                     const Compare& lt) {
+  static_assert(Arity >= 2, "Heaps have at least two children per node");
+
+  std::iter_value_t<It> elem = std::move(first[pos]);
+
+  while (pos > start) {
+    const auto parent = (pos - 1) / static_cast<decltype(pos)>(Arity);
+
+    if (!lt(elem, first[parent])) {
+      break;
+    }
+
+    first[pos] = std::move(first[parent]);
+    pos = parent;
+  }
+
+  first[pos] = std::move(elem);
+}
+
+/// @brief Restores the @tparam Arity -ary heap of @p n elements at @p first
+/// after the element at @p pos was replaced, given that the subtrees below
+/// @p pos are heaps. This is Python's heapq._siftup(): the smallest child is
+/// moved up until a leaf is reached, without comparing it to the replaced
+/// element, which is then sifted back towards @p pos. Replaced elements
+/// mostly come from the bottom of the heap, so this takes about half the
+/// comparisons of stopping on the way down.
+/// @note For binary heaps, ties between children are broken as Python does,
+/// so that the heap has the same layout as in Python.
+template <std::size_t Arity, std::random_access_iterator It, typename Compare>
+void SiftTowardsLeaf(It first,
+                     std::iter_difference_t<It> n,
+                     std::iter_difference_t<It> pos,
+                     const Compare& lt) {
+  using index = std::iter_difference_t<It>;
+
+  static_assert(Arity >= 2, "Heaps have at least two children per node");
+
+  constexpr auto kArity = static_cast<index>(Arity);
+
+  const auto start = pos;
+  std::iter_value_t<It> elem = std::move(first[pos]);
+
+  for (auto child = kArity * pos + 1; child < n; child = kArity * pos + 1) {
+    const auto last_child = std::min(child + kArity, n);
+    auto smallest = child;
+
+    // The children of a node are contiguous, so with four of them, they
+    // often share a cache line
+    for (auto other = child + 1; other < last_child; ++other) {
+      if (!lt(first[smallest], first[other])) {
+        smallest = other;
+      }
+    }
+
+    first[pos] = std::move(first[smallest]);
+    pos = smallest;
+  }
+
+  first[pos] = std::move(elem);
+  SiftTowardsRoot<Arity>(first, start, pos, lt);
+}
+
+/// @brief Rearranges the @p n elements at @p first into a @tparam Arity -ary
+/// heap as per @p lt, in O(n), bottom-up like Python's heapq.heapify().
+template <std::size_t Arity, std::random_access_iterator It, typename Compare>
+void MakeHeap(It first, std::iter_difference_t<It> n, const Compare& lt) {
+  constexpr auto kArity = static_cast<std::iter_difference_t<It>>(Arity);
+
+  if (n < 2) {
+    return;
+  }
+
+  for (auto pos = (n - 2) / kArity; pos >= 0; --pos) {
+    SiftTowardsLeaf<Arity>(first, n, pos, lt);
+  }
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
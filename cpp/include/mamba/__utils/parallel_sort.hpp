@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "mamba/__utils/thread_pool.hpp"
+
+// Number of elements from which List::Sort() sorts in parallel by default
+#if !defined(MAMBA_PARALLEL_SORT_THRESHOLD)
+#define MAMBA_PARALLEL_SORT_THRESHOLD (1 << 17)
+#endif  // !defined(MAMBA_PARALLEL_SORT_THRESHOLD)
+
+namespace mamba::builtins::__utils {
+namespace details {
+
+// Pieces that every merge of a level is split into, per thread, so that
+// threads finishing early can steal the rest
+inline constexpr std::size_t kMergePiecesPerThread = 4;
+
+inline std::atomic<std::size_t>& ParallelSortThresholdStorage() {
+  // With a single hardware thread, the merges would only add work
+  static std::atomic<std::size_t> threshold =
+      ThreadPool::DefaultSize() > 1 ? MAMBA_PARALLEL_SORT_THRESHOLD
+                                    : std::numeric_limits<std::size_t>::max();
+  return threshold;
+}
+
+/// @brief Returns how many of the first @p d elements of the stable merge of
+/// @p a[0, @p na) and @p b[0, @p nb) come from @p a, by binary search.
+template <typename It, typename Compare>
+std::size_t CoRank(std::size_t d,
+                   It a,
+                   std::size_t na,
+                   It b,
+                   std::size_t nb,
+                   const Compare& lt) {
+  auto lo = d > nb ? d - nb : 0;
+  auto hi = std::min(d, na);
+
+  while (lo < hi) {
+    const auto i = lo + (hi - lo) / 2;
+    const auto j = d - i;
+
+    // Elements of a go first on ties, so a[i] belongs in the prefix unless
+    // b[j - 1] is strictly less
+    if (j > 0 && !lt(b[j - 1], a[i])) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+
+  return lo;
+}
+
+/// @brief Merges [@p a, @p a_end) and [@p b, @p b_end) into @p out by moving
+/// their elements, taking from @p a first on ties. If @p lt throws, the rest
+/// of both ranges is moved to @p out unmerged before rethrowing, so that
+/// @p out still gets every element.
+template <typename In, typename Out, typename Compare>
+void MoveMerge(In a, In a_end, In b, In b_end, Out out, const Compare& lt) {
+  try {
+    while (a != a_end && b != b_end) {
+      if (lt(*b, *a)) {
+        *out = std::move(*b);
+        ++b;
+      } else {
+        *out = std::move(*a);
+        ++a;
+      }
+
+      ++out;
+    }
+  } catch (...) {
+    std::move(b, b_end, std::move(a, a_end, out));
+    throw;
+  }
+
+  std::move(b, b_end, std::move(a, a_end, out));
+}
+
+/// @brief Merges every pair of consecutive sorted runs of @p width elements
+/// of @p src[0, @p n) into @p dst. Each merge is split into pieces at
+/// CoRank() boundaries, which are merged concurrently. If @p lt throws,
+/// @p dst still gets every element before the exception is rethrown.
+template <typename In, typename Out, typename Compare>
+void MergeLevel(In src,
+                Out dst,
+                std::size_t n,
+                std::size_t width,
+                std::size_t num_threads,
+                const Compare& lt) {
+  const auto num_pairs = (n + 2 * width - 1) / (2 * width);
+  const auto pieces = std::max<std::size_t>(
+      num_threads * kMergePiecesPerThread / num_pairs, 1);
+
+  // Boundaries are all found before any element moves, since the binary
+  // searches of a piece read the elements of its neighbours
+  std::vector<std::pair<std::size_t, std::size_t>> splits;
+  splits.reserve(num_pairs * (pieces + 1));
+
+  try {
+    for (std::size_t pair = 0; pair < num_pairs; ++pair) {
+      const auto lo = pair * 2 * width;
+      const auto mid = std::min(lo + width, n);
+      const auto hi = std::min(lo + 2 * width, n);
+
+      for (std::size_t piece = 0; piece <= pieces; ++piece) {
+        const auto d = (hi - lo) * piece / pieces;
+        const auto i = CoRank(d, src + lo, mid - lo, src + mid, hi - mid, lt);
+
+        splits.emplace_back(i, d - i);
+      }
+    }
+  } catch (...) {
+    std::move(src, src + n, dst);
+    throw;
+  }
+
+  ParallelChunks(num_pairs * pieces, 1, [&](std::size_t task, std::size_t) {
+    const auto pair = task / pieces;
+    const auto lo = pair * 2 * width;
+    const auto mid = std::min(lo + width, n);
+    const auto [i0, j0] = splits[pair * (pieces + 1) + task % pieces];
+    const auto [i1, j1] = splits[pair * (pieces + 1) + task % pieces + 1];
+
+    MoveMerge(src + lo + i0, src + lo + i1, src + mid + j0, src + mid + j1,
+              dst + lo + i0 + j0, lt);
+  });
+}
+
+}  // namespace details
+
+/// @brief Returns the number of elements from which List::Sort() sorts in
+/// parallel, which defaults to MAMBA_PARALLEL_SORT_THRESHOLD, or to never on
+/// machines with a single hardware thread.
+inline std::size_t ParallelSortThreshold() {
+  return details::ParallelSortThresholdStorage().load(
+      std::memory_order_relaxed);
+}
+
+/// @brief Sets the number of elements from which List::Sort() sorts in
+/// parallel, for all threads.
+inline void SetParallelSortThreshold(std::size_t n) {
+  details::ParallelSortThresholdStorage().store(n, std::memory_order_relaxed);
+}
+
+/// @brief Sorts [@p first, @p last) on the default thread pool: one run per
+/// thread is sorted with @p sort(run_first, run_last), then the runs are
+/// merged pairwise with @p lt, each merge itself split between the threads.
+/// The result is stable if @p sort is, and since a stable sort has a single
+/// result, it does not depend on the number of threads or their timing.
+/// If @p sort or @p lt throws, the range is left as some permutation of its
+/// elements.
+/// @note @p sort and @p lt are called concurrently.
+template <std::random_access_iterator It, typename Compare, typename Sort>
+void ParallelMergeSort(It first, It last, const Compare& lt, const Sort& sort) {
+  using value_type = std::iter_value_t<It>;
+
+  const auto n = static_cast<std::size_t>(last - first);
+  // The calling thread works alongside the workers
+  const auto num_threads = ThreadPool::Default().Size() + 1;
+  const auto run = (n + std::bit_ceil(num_threads) - 1) /
+                   std::bit_ceil(num_threads);
+
+  ParallelChunks(n, run, [&](std::size_t lo, std::size_t hi) {
+    sort(first + lo, first + hi);
+  });
+
+  if (n <= run) {
+    return;
+  }
+
+  // Levels merge back and forth between the range and the buffer
+  std::vector<value_type> buffer(n);
+  bool in_buffer = false;
+
+  try {
+    for (auto width = run; width < n; width *= 2) {
+      if (in_buffer) {
+        details::MergeLevel(buffer.begin(), first, n, width, num_threads, lt);
+      } else {
+        details::MergeLevel(first, buffer.begin(), n, width, num_threads, lt);
+      }
+
+      in_buffer = !in_buffer;
+    }
+  } catch (...) {
+    // The failed level still moved every element to its destination
+    if (!in_buffer) {
+      std::move(buffer.begin(), buffer.end(), first);
+    }
+
+    throw;
+  }
+
+  if (in_buffer) {
+    ParallelChunks(n, run, [&](std::size_t lo, std::size_t hi) {
+      std::move(buffer.begin() + lo, buffer.begin() + hi, first + lo);
+    });
+  }
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
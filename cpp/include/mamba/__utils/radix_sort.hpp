@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Number of elements of type @tparam T below which RadixSort() loses
+/// to a comparison sort, since it always makes a full pass to histogram the
+/// digits and allocates a buffer as large as the input. Its fixed cost grows
+/// with the number of digits, i.e. with sizeof(T).
+template <typename T>
+inline constexpr std::size_t kRadixSortThreshold = 128 * sizeof(T);
+
+namespace details {
+
+/// @brief Maps @p v to an unsigned key such that the keys of two integers
+/// compare like the integers, by flipping the sign bit.
+template <std::signed_integral T>
+constexpr std::make_unsigned_t<T> RadixKey(T v) {
+  using key_type = std::make_unsigned_t<T>;
+
+  constexpr auto kSignBit = key_type{1} << (sizeof(key_type) * CHAR_BIT - 1);
+
+  return static_cast<key_type>(v) ^ kSignBit;
+}
+
+/// @brief Maps @p v to an unsigned key such that the keys of two non-NaN
+/// floats compare like the floats. Negative floats have all of their bits
+/// flipped, since their magnitude grows the other way, and positive floats
+/// have only their sign bit flipped.
+template <std::floating_point T>
+  requires(sizeof(T) == sizeof(std::uint64_t))
+constexpr std::uint64_t RadixKey(T v) {
+  constexpr auto kSignBit = std::uint64_t{1} << 63;
+
+  // -0.0 and 0.0 compare equal, so they must share a key to keep their order
+  const auto bits = std::bit_cast<std::uint64_t>(v == 0 ? T{0} : v);
+
+  return (bits & kSignBit) != 0 ? ~bits : bits | kSignBit;
+}
+
+template <typename T>
+concept RadixSortable = requires(T v) {
+  { RadixKey(v) } -> std::unsigned_integral;
+};
+
+}  // namespace details
+
+/// @brief Sorts @p values in place with a least significant digit radix sort
+/// on 8-bit digits, which is stable and makes at most sizeof(T) + 2 passes
+/// over them. Passes over digits that are the same for every value, e.g. the
+/// high bytes of small integers, are skipped. With @p reverse, the values are
+/// sorted in descending order, still stably.
+/// @return false, leaving @p values untouched, if any of them is NaN, since
+/// NaN compares neither less nor greater than anything and has no place in
+/// the order, or if they are mostly made of long sorted runs, which TimSort
+/// merges faster than the passes here.
+template <typename T>
+  requires details::RadixSortable<T>
+bool RadixSort(std::span<T> values, bool reverse) {
+  using key_type = decltype(details::RadixKey(std::declval<T>()));
+
+  constexpr std::size_t kDigitBits = 8;
+  constexpr std::size_t kNumberOfBuckets = std::size_t{1} << kDigitBits;
+  constexpr std::size_t kNumberOfPasses = sizeof(key_type);
+
+  // Average length of the ascending or descending runs above which the
+  // values are left to TimSort
+  constexpr std::size_t kMinAverageRun = 16;
+
+  if (values.empty()) {
+    return true;
+  }
+
+  const auto key = [reverse](const T v) {
+    return reverse ? static_cast<key_type>(~details::RadixKey(v))
+                   : details::RadixKey(v);
+  };
+
+  const auto digit = [](const key_type k, const std::size_t pass) {
+    return static_cast<std::size_t>(k >> (pass * kDigitBits)) &
+           (kNumberOfBuckets - 1);
+  };
+
+  // Check for NaN and count the changes of direction in a first, cheap pass,
+  // so that presorted values are handed to TimSort quickly
+  std::size_t ascents = 0;
+  std::size_t descents = 0;
+  key_type previous = key(values[0]);
+
+  for (const auto v : values) {
+    if constexpr (std::floating_point<T>) {
+      if (v != v) {
+        return false;
+      }
+    }
+
+    const auto k = key(v);
+    ascents += previous < k;
+    descents += k < previous;
+    previous = k;
+  }
+
+  const auto n = values.size();
+
+  if (std::min(ascents, descents) * kMinAverageRun < n) {
+    return false;
+  }
+
+  // Histogram every digit up front in a single pass over the values
+  std::array<std::array<std::size_t, kNumberOfBuckets>, kNumberOfPasses>
+      counts{};
+
+  for (const auto v : values) {
+    const auto k = key(v);
+
+    for (std::size_t pass = 0; pass < kNumberOfPasses; ++pass) {
+      ++counts[pass][digit(k, pass)];
+    }
+  }
+
+  std::vector<T> buffer(n);
+  std::span<T> from = values;
+  std::span<T> to = buffer;
+
+  for (std::size_t pass = 0; pass < kNumberOfPasses; ++pass) {
+    auto& offsets = counts[pass];
+
+    // If every value has the same digit, the pass would leave them as is
+    if (offsets[digit(key(from[0]), pass)] == n) {
+      continue;
+    }
+
+    std::size_t offset = 0;
+
+    for (auto& count : offsets) {
+      offset += std::exchange(count, offset);
+    }
+
+    for (const auto v : from) {
+      to[offsets[digit(key(v), pass)]++] = v;
+    }
+
+    std::swap(from, to);
+  }
+
+  if (from.data() != values.data()) {
+    std::copy(from.begin(), from.end(), values.begin());
+  }
+
+  return true;
+}
+
+/// @brief Sorts [@p first, @p last) of booleans in place by counting them.
+/// Equal booleans are indistinguishable, so this is trivially stable.
+template <std::forward_iterator It>
+  requires std::same_as<std::iter_value_t<It>, bool>
+void CountingSort(It first, It last, bool reverse) {
+  const auto trues = std::count(first, last, true);
+  const auto falses = std::distance(first, last) - trues;
+
+  auto mid = std::fill_n(first, reverse ? trues : falses, reverse);
+  std::fill_n(mid, reverse ? falses : trues, !reverse);
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
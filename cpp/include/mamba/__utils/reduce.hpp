@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "mamba/__utils/simd.hpp"
+#include "mamba/__utils/thread_pool.hpp"
+
+// Number of elements from which the reductions of sequence.hpp run in
+// parallel by default
+#if !defined(MAMBA_PARALLEL_REDUCE_THRESHOLD)
+#define MAMBA_PARALLEL_REDUCE_THRESHOLD (1 << 20)
+#endif  // !defined(MAMBA_PARALLEL_REDUCE_THRESHOLD)
+
+namespace mamba::builtins::__utils {
+namespace details {
+
+// Elements per block, which a single thread reduces with the kernels of
+// simd.hpp. A power of two, so that blocks line up with the halves that
+// Reduce() splits its input into.
+inline constexpr std::size_t kReduceBlockSize = 1 << 14;
+
+// Elements up to which PairwiseSum() adds with a single kernel call, which
+// keeps one running sum per lane and vector, i.e. 128 additions per sum
+inline constexpr std::size_t kPairwiseSumLeafSize = 2048;
+
+// Blocks per thread, so that threads finishing early can steal the rest
+inline constexpr std::size_t kReduceBlocksPerThread = 4;
+
+inline std::atomic<std::size_t>& ParallelReduceThresholdStorage() {
+  // With a single hardware thread, the blocks would only add work
+  static std::atomic<std::size_t> threshold =
+      ThreadPool::DefaultSize() > 1 ? MAMBA_PARALLEL_REDUCE_THRESHOLD
+                                    : std::numeric_limits<std::size_t>::max();
+  return threshold;
+}
+
+inline std::size_t ParallelChunkOfBlocks(std::size_t num_blocks) {
+  const auto num_threads = ThreadPool::Default().Size() + 1;
+  return std::max<std::size_t>(
+      num_blocks / (num_threads * kReduceBlocksPerThread), 1);
+}
+
+/// @brief Combines @p partials[0, @p n) like Reduce() combines the halves of
+/// its input: the first part is the largest power of two smaller than @p n.
+template <typename Partial, typename Combine>
+Partial CombinePartials(const Partial* partials,
+                        std::size_t n,
+                        const Combine& combine) {
+  if (n == 1) {
+    return partials[0];
+  }
+
+  const auto mid = std::bit_floor(n - 1);
+
+  return combine(CombinePartials(partials, mid, combine),
+                 CombinePartials(partials + mid, n - mid, combine));
+}
+
+/// @brief Reduces @p values to a single value by calling @p leaf on blocks of
+/// up to kReduceBlockSize elements and @p combine on pairs of results, in a
+/// balanced tree. The tree only depends on the number of values, so with an
+/// exact @p combine, or a deterministic one as the additions of floats are,
+/// the result does not depend on whether the blocks ran in parallel.
+template <typename T, typename Leaf, typename Combine>
+auto Reduce(std::span<const T> values,
+            const Leaf& leaf,
+            const Combine& combine) {
+  using partial = std::invoke_result_t<const Leaf&, std::span<const T>>;
+
+  const auto n = values.size();
+
+  if (n <= kReduceBlockSize) {
+    return leaf(values);
+  }
+
+  if (n < ParallelReduceThresholdStorage().load(std::memory_order_relaxed)) {
+    // The first half is always a whole number of blocks
+    const auto mid = std::bit_floor(n - 1);
+
+    return combine(Reduce(values.first(mid), leaf, combine),
+                   Reduce(values.subspan(mid), leaf, combine));
+  }
+
+  const auto num_blocks = (n + kReduceBlockSize - 1) / kReduceBlockSize;
+  std::vector<partial> partials(num_blocks);
+
+  ParallelChunks(num_blocks, ParallelChunkOfBlocks(num_blocks),
+                 [&](std::size_t lo, std::size_t hi) {
+                   for (auto block = lo; block < hi; ++block) {
+                     const auto first = block * kReduceBlockSize;
+                     partials[block] = leaf(values.subspan(
+                         first, std::min(kReduceBlockSize, n - first)));
+                   }
+                 });
+
+  return CombinePartials(partials.data(), num_blocks, combine);
+}
+
+/// @brief Pairwise sum of @p values, whose rounding error grows with the
+/// logarithm of their number rather than with their number.
+template <std::floating_point T>
+T PairwiseSum(std::span<const T> values) {
+  if (values.size() <= kPairwiseSumLeafSize) {
+    return SumBlock(values);
+  }
+
+  const auto mid = std::bit_floor(values.size() - 1);
+
+  return PairwiseSum(values.first(mid)) + PairwiseSum(values.subspan(mid));
+}
+
+/// @brief Whether any element of @p values equals @p x if @tparam Equal, or
+/// differs from @p x otherwise. Above the parallel threshold, blocks are
+/// searched in parallel, and skipped once any of them had a match.
+template <bool Equal, typename T>
+bool Contains(std::span<const T> values, T x) {
+  const auto find = [x](std::span<const T> block) {
+    if constexpr (Equal) {
+      return FindEqual(block, x) != block.size();
+    } else {
+      return FindNotEqual(block, x) != block.size();
+    }
+  };
+
+  const auto n = values.size();
+
+  if (n < ParallelReduceThresholdStorage().load(std::memory_order_relaxed) ||
+      n <= kReduceBlockSize) {
+    return find(values);
+  }
+
+  const auto num_blocks = (n + kReduceBlockSize - 1) / kReduceBlockSize;
+  std::atomic<bool> found = false;
+
+  ParallelChunks(num_blocks, ParallelChunkOfBlocks(num_blocks),
+                 [&](std::size_t lo, std::size_t hi) {
+                   for (auto block = lo; block < hi; ++block) {
+                     if (found.load(std::memory_order_relaxed)) {
+                       return;
+                     }
+
+                     const auto first = block * kReduceBlockSize;
+
+                     if (find(values.subspan(
+                             first, std::min(kReduceBlockSize, n - first)))) {
+                       found.store(true, std::memory_order_relaxed);
+                     }
+                   }
+                 });
+
+  return found.load(std::memory_order_relaxed);
+}
+
+/// @brief Returns the first element of @p values that compares equal to
+/// @p extremum, which has the sign of the first zero when @p extremum is
+/// zero, as std::min_element() and std::max_element() would.
+template <std::floating_point T>
+T FirstEqual(std::span<const T> values, T extremum) {
+  return extremum == 0 ? values[FindEqual(values, extremum)] : extremum;
+}
+
+}  // namespace details
+
+/// @brief Returns the number of elements from which the reductions of
+/// sequence.hpp run in parallel, which defaults to
+/// MAMBA_PARALLEL_REDUCE_THRESHOLD, or to never on machines with a single
+/// hardware thread.
+inline std::size_t ParallelReduceThreshold() {
+  return details::ParallelReduceThresholdStorage().load(
+      std::memory_order_relaxed);
+}
+
+/// @brief Sets the number of elements from which the reductions of
+/// sequence.hpp run in parallel, for all threads.
+inline void SetParallelReduceThreshold(std::size_t n) {
+  details::ParallelReduceThresholdStorage().store(n,
+                                                  std::memory_order_relaxed);
+}
+
+/// @brief Returns the sum of @p values. Integers wrap around on overflow.
+/// Floats are summed pairwise, so the result may differ from adding them in
+/// order, in the last bits.
+template <SimdElement T>
+T Sum(std::span<const T> values) {
+  if constexpr (std::floating_point<T>) {
+    return details::Reduce(values, details::PairwiseSum<T>,
+                           [](const T a, const T b) { return a + b; });
+  } else {
+    return details::Reduce(values, SumBlock<T>, [](const T a, const T b) {
+      using unsigned_type = std::make_unsigned_t<T>;
+      return static_cast<T>(static_cast<unsigned_type>(a) +
+                            static_cast<unsigned_type>(b));
+    });
+  }
+}
+
+/// @brief Returns the sum of @p values, with the rounding errors of the
+/// additions tracked and added back at the end, like Python's sum() does for
+/// floats. Slower than Sum(), but exact unless the errors themselves round.
+template <SimdElement T>
+  requires std::floating_point<T>
+T CompensatedSum(std::span<const T> values) {
+  const auto res = details::Reduce(
+      values, CompensatedSumBlock<T>,
+      [](Compensated<T> a, const Compensated<T>& b) {
+        details::TwoSum(a.sum, a.error, b.sum);
+        a.error += b.error;
+        return a;
+      });
+
+  // Infinities make NaN errors, which would hide them
+  return std::isfinite(res.error) ? res.sum + res.error : res.sum;
+}
+
+/// @brief Returns the smallest of @p values, which must not be empty. Ties
+/// and NaN are resolved like std::min_element() does.
+template <SimdElement T>
+T Min(std::span<const T> values) {
+  const auto res = details::Reduce(
+      values, MinBlock<T>, [](const Extremum<T>& a, const Extremum<T>& b) {
+        return Extremum<T>{b.value < a.value ? b.value : a.value,
+                           a.nan || b.nan};
+      });
+
+  if constexpr (std::floating_point<T>) {
+    // NaN compares false to everything, so the result depends on its place
+    if (res.nan) {
+      return *std::min_element(values.begin(), values.end());
+    }
+
+    return details::FirstEqual(values, res.value);
+  } else {
+    return res.value;
+  }
+}
+
+/// @brief Returns the biggest of @p values, which must not be empty. Ties
+/// and NaN are resolved like std::max_element() does.
+template <SimdElement T>
+T Max(std::span<const T> values) {
+  const auto res = details::Reduce(
+      values, MaxBlock<T>, [](const Extremum<T>& a, const Extremum<T>& b) {
+        return Extremum<T>{a.value < b.value ? b.value : a.value,
+                           a.nan || b.nan};
+      });
+
+  if constexpr (std::floating_point<T>) {
+    if (res.nan) {
+      return *std::max_element(values.begin(), values.end());
+    }
+
+    return details::FirstEqual(values, res.value);
+  } else {
+    return res.value;
+  }
+}
+
+/// @brief Returns whether any of @p values is not zero.
+template <SimdElement T>
+bool AnyNonZero(std::span<const T> values) {
+  return details::Contains<false>(values, T{0});
+}
+
+/// @brief Returns whether all of @p values are not zero.
+template <SimdElement T>
+bool AllNonZero(std::span<const T> values) {
+  return !details::Contains<true>(values, T{0});
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
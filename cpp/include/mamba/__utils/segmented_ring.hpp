@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Double-ended queue that stores its elements in fixed-size blocks,
+/// whose addresses are kept in a ring of power-of-two size. Adding or
+/// removing an element at either end is O(1), and so is indexing. Growing the
+/// ring moves the block addresses, never the elements, so references to the
+/// elements stay valid until they are removed.
+/// @note Blocks that become empty are kept in the ring and reused, so like
+/// std::vector's capacity, the memory held only grows until shrink_to_fit()
+/// is called or the ring is destroyed.
+template <typename T>
+class SegmentedRing {
+  template <bool Const>
+  class Iterator;
+
+ public:
+  /// @brief Elements per block. A power of two so that locating an element
+  /// is a shift and a mask, of about 4 KiB so that scanning a block streams
+  /// through memory.
+  static constexpr std::size_t kBlockSize =
+      std::bit_floor(std::max<std::size_t>(4096 / sizeof(T), 16));
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SegmentedRing() noexcept = default;
+
+  SegmentedRing(const SegmentedRing& other) : SegmentedRing() {
+    for (size_type i = 0; i < other.size_; ++i) {
+      push_back(other[i]);
+    }
+  }
+
+  SegmentedRing(SegmentedRing&& other) noexcept { swap(other); }
+
+  SegmentedRing& operator=(const SegmentedRing& other) {
+    if (this != &other) {
+      SegmentedRing copy(other);
+      swap(copy);
+    }
+
+    return *this;
+  }
+
+  SegmentedRing& operator=(SegmentedRing&& other) noexcept {
+    if (this != &other) {
+      SegmentedRing moved(std::move(other));
+      swap(moved);
+    }
+
+    return *this;
+  }
+
+  ~SegmentedRing() {
+    clear();
+    shrink_to_fit();
+  }
+
+  void swap(SegmentedRing& other) noexcept {
+    std::swap(map_, other.map_);
+    std::swap(first_, other.first_);
+    std::swap(offset_, other.offset_);
+    std::swap(size_, other.size_);
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  reference operator[](size_type idx) noexcept { return *Address(idx); }
+
+  const_reference operator[](size_type idx) const noexcept {
+    return *Address(idx);
+  }
+
+  reference front() noexcept { return *Address(0); }
+  const_reference front() const noexcept { return *Address(0); }
+  reference back() noexcept { return *Address(size_ - 1); }
+  const_reference back() const noexcept { return *Address(size_ - 1); }
+
+  iterator begin() noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, size_}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, size_}; }
+  const_iterator cbegin() const noexcept { return {this, 0}; }
+  const_iterator cend() const noexcept { return {this, size_}; }
+
+  /// @brief Returns the elements from index @p first that are contiguous in
+  /// memory, i.e. up to the end of their block, and before index @p last.
+  /// Loops over the returned spans visit [@p first, @p last) a block at a
+  /// time, which lets them use the kernels of simd.hpp.
+  std::span<const T> Segment(size_type first, size_type last) const noexcept {
+    const auto pos = offset_ + first;
+    const auto in_block = kBlockSize - pos % kBlockSize;
+
+    return {Address(first), std::min(in_block, last - first)};
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    const auto pos = offset_ + size_;
+
+    // Only the first element of a block may need a new block
+    if (pos % kBlockSize != 0) {
+      auto* elem =
+          std::construct_at(Address(size_), std::forward<Args>(args)...);
+      ++size_;
+
+      return *elem;
+    }
+
+    if (pos / kBlockSize == map_.size()) {
+      Grow();
+    }
+
+    auto*& block = map_[Slot(pos / kBlockSize)];
+
+    if (block == nullptr) {
+      block = Allocate();
+    }
+
+    auto* elem = std::construct_at(block + pos % kBlockSize,
+                                   std::forward<Args>(args)...);
+    ++size_;
+
+    return *elem;
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    if (offset_ == 0) {
+      if (UsedBlocks() == map_.size()) {
+        Grow();
+      }
+
+      auto*& block = map_[Slot(map_.size() - 1)];
+
+      if (block == nullptr) {
+        block = Allocate();
+      }
+
+      // The new element is constructed first, so that the ring is left as it
+      // was if that throws
+      auto* elem = std::construct_at(block + kBlockSize - 1,
+                                     std::forward<Args>(args)...);
+      first_ = Slot(map_.size() - 1);
+      offset_ = kBlockSize - 1;
+      ++size_;
+
+      return *elem;
+    }
+
+    auto* elem = std::construct_at(Address(0) - 1, std::forward<Args>(args)...);
+    --offset_;
+    ++size_;
+
+    return *elem;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  void pop_back() noexcept {
+    std::destroy_at(Address(size_ - 1));
+    --size_;
+  }
+
+  void pop_front() noexcept {
+    std::destroy_at(Address(0));
+    --size_;
+
+    if (++offset_ == kBlockSize) {
+      offset_ = 0;
+      first_ = Slot(1);
+    }
+  }
+
+  /// @brief Inserts @p value before index @p idx, shifting the elements on
+  /// the shorter side of @p idx by one.
+  void insert(size_type idx, T value) {
+    if (idx == 0) {
+      emplace_front(std::move(value));
+      return;
+    } else if (idx < size_ / 2) {
+      emplace_front(std::move(front()));
+      std::move(begin() + 2, begin() + idx + 1, begin() + 1);
+    } else if (idx == size_) {
+      emplace_back(std::move(value));
+      return;
+    } else {
+      emplace_back(std::move(back()));
+      std::move_backward(begin() + idx, end() - 2, end() - 1);
+    }
+
+    (*this)[idx] = std::move(value);
+  }
+
+  /// @brief Removes the element at index @p idx, shifting the elements on
+  /// the shorter side of @p idx by one.
+  void erase(size_type idx) {
+    if (idx < size_ / 2) {
+      std::move_backward(begin(), begin() + idx, begin() + idx + 1);
+      pop_front();
+    } else {
+      std::move(begin() + idx + 1, end(), begin() + idx);
+      pop_back();
+    }
+  }
+
+  /// @brief Removes all elements and keeps the blocks for reuse.
+  void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_type i = 0; i < size_; ++i) {
+        std::destroy_at(Address(i));
+      }
+    }
+
+    size_ = 0;
+    offset_ = 0;
+  }
+
+  /// @brief Frees the blocks that hold no elements.
+  void shrink_to_fit() noexcept {
+    const auto used = UsedBlocks();
+
+    for (size_type k = used; k < map_.size(); ++k) {
+      auto*& block = map_[Slot(k)];
+
+      if (block != nullptr) {
+        std::allocator<T>().deallocate(block, kBlockSize);
+        block = nullptr;
+      }
+    }
+
+    if (used == 0) {
+      map_ = {};
+      first_ = 0;
+      offset_ = 0;
+    }
+  }
+
+ private:
+  static T* Allocate() { return std::allocator<T>().allocate(kBlockSize); }
+
+  // Blocks from first_ that hold elements. A ring emptied by popping still
+  // uses the block that offset_ points into.
+  size_type UsedBlocks() const noexcept {
+    return (offset_ + size_ + kBlockSize - 1) / kBlockSize;
+  }
+
+  // Map slot of the k-th block from the first one
+  size_type Slot(size_type k) const noexcept {
+    return (first_ + k) & (map_.size() - 1);
+  }
+
+  T* Address(size_type idx) const noexcept {
+    const auto pos = offset_ + idx;
+    return map_[Slot(pos / kBlockSize)] + pos % kBlockSize;
+  }
+
+  // Doubles the ring, with the blocks from first_ moved to its start in
+  // order, spare ones included
+  void Grow() {
+    std::vector<T*> map(std::max<size_type>(map_.size() * 2, 4), nullptr);
+
+    for (size_type k = 0; k < map_.size(); ++k) {
+      map[k] = map_[Slot(k)];
+    }
+
+    map_ = std::move(map);
+    first_ = 0;
+  }
+
+  std::vector<T*> map_;
+  size_type first_ = 0;
+  size_type offset_ = 0;
+  size_type size_ = 0;
+};
+
+template <typename T>
+template <bool Const>
+class SegmentedRing<T>::Iterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const T*, T*>;
+  using reference = std::conditional_t<Const, const T&, T&>;
+
+  using ring = std::conditional_t<Const, const SegmentedRing, SegmentedRing>;
+
+  Iterator() noexcept = default;
+  Iterator(ring* r, size_type idx) noexcept : ring_(r), idx_(idx) {}
+
+  operator Iterator<true>() const noexcept
+    requires(!Const)
+  {
+    return {ring_, idx_};
+  }
+
+  reference operator*() const noexcept { return (*ring_)[idx_]; }
+  pointer operator->() const noexcept { return &(*ring_)[idx_]; }
+
+  reference operator[](difference_type n) const noexcept {
+    return (*ring_)[idx_ + n];
+  }
+
+  Iterator& operator++() noexcept {
+    ++idx_;
+    return *this;
+  }
+
+  Iterator operator++(int) noexcept { return {ring_, idx_++}; }
+
+  Iterator& operator--() noexcept {
+    --idx_;
+    return *this;
+  }
+
+  Iterator operator--(int) noexcept { return {ring_, idx_--}; }
+
+  Iterator& operator+=(difference_type n) noexcept {
+    idx_ += n;
+    return *this;
+  }
+
+  Iterator& operator-=(difference_type n) noexcept {
+    idx_ -= n;
+    return *this;
+  }
+
+  Iterator operator+(difference_type n) const noexcept {
+    return {ring_, idx_ + n};
+  }
+
+  friend Iterator operator+(difference_type n, const Iterator& it) noexcept {
+    return it + n;
+  }
+
+  Iterator operator-(difference_type n) const noexcept {
+    return {ring_, idx_ - n};
+  }
+
+  difference_type operator-(const Iterator& other) const noexcept {
+    return static_cast<difference_type>(idx_) -
+           static_cast<difference_type>(other.idx_);
+  }
+
+  // All comparisons are spelled out, so that the operator templates for
+  // objects never get a say
+  bool operator==(const Iterator& other) const noexcept {
+    return idx_ == other.idx_;
+  }
+
+  bool operator!=(const Iterator& other) const noexcept {
+    return idx_ != other.idx_;
+  }
+
+  bool operator<(const Iterator& other) const noexcept {
+    return idx_ < other.idx_;
+  }
+
+  bool operator>(const Iterator& other) const noexcept {
+    return idx_ > other.idx_;
+  }
+
+  bool operator<=(const Iterator& other) const noexcept {
+    return idx_ <= other.idx_;
+  }
+
+  bool operator>=(const Iterator& other) const noexcept {
+    return idx_ >= other.idx_;
+  }
+
+  std::strong_ordering operator<=>(const Iterator& other) const noexcept {
+    return idx_ <=> other.idx_;
+  }
+
+ private:
+  ring* ring_ = nullptr;
+  size_type idx_ = 0;
+};
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
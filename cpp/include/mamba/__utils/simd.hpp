@@ -0,0 +1,417 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Element types that the kernels below vectorize, i.e. 32 and 64-bit
+/// numbers, such as Int and Float.
+template <typename T>
+concept SimdElement = std::is_arithmetic_v<T> && !std::same_as<T, bool> &&
+                      (sizeof(T) == 4 || sizeof(T) == 8);
+
+/// @brief Sum of floats as an unevaluated pair, where @p error holds the
+/// rounding errors of the additions that made @p sum.
+template <std::floating_point T>
+struct Compensated {
+  T sum;
+  T error;
+};
+
+/// @brief Smallest or biggest of some values, unless @p nan is set, in which
+/// case some of them were NaN and @p value is meaningless.
+template <SimdElement T>
+struct Extremum {
+  T value;
+  bool nan;
+};
+
+namespace details {
+
+#if defined(__GNUC__)
+
+// The kernels below are written with the GCC/Clang vector extensions rather
+// than intrinsics, so the same code compiles to SSE2 or NEON, and to AVX2 in
+// the functions that are only called when the CPU supports it. A vector is
+// one AVX2 register, or two SSE2/NEON ones.
+inline constexpr std::size_t kVectorBytes = 32;
+
+// Vectors handled per iteration, so that several operations are in flight
+inline constexpr std::size_t kUnroll = 4;
+
+template <typename T>
+using Vector [[gnu::vector_size(kVectorBytes)]] = T;
+
+// Lanes are -1 where the comparison holds, and 0 elsewhere
+template <typename T>
+using Mask = decltype(Vector<T>{} == Vector<T>{});
+
+// Vectors are returned through references, since returning them by value
+// changes the ABI between the generic and the AVX2 builds (-Wpsabi)
+template <typename V>
+[[gnu::always_inline]] inline void Load(V& v, const void* data) {
+  std::memcpy(&v, data, sizeof(v));
+}
+
+template <typename T>
+[[gnu::always_inline]] inline bool Any(const Mask<T>& mask) {
+  Vector<std::uint64_t> bits;
+  std::memcpy(&bits, &mask, sizeof(bits));
+  return (bits[0] | bits[1] | bits[2] | bits[3]) != 0;
+}
+
+// Replaces the lanes of v where mask is set with those of other
+template <typename V, typename M>
+[[gnu::always_inline]] inline void Blend(V& v, const M& mask, const V& other) {
+  M bits;
+  M other_bits;
+  std::memcpy(&bits, &v, sizeof(v));
+  std::memcpy(&other_bits, &other, sizeof(other));
+
+  bits = (other_bits & mask) | (bits & ~mask);
+  std::memcpy(&v, &bits, sizeof(v));
+}
+
+#endif  // defined(__GNUC__)
+
+// Adds x to sum and the rounding error of the addition to error, whatever
+// the magnitudes of sum and x (Knuth's TwoSum). Works on vectors as well.
+template <typename T>
+[[gnu::always_inline]] inline void TwoSum(T& sum, T& error, const T& x) {
+  const T t = sum + x;
+  const T z = t - sum;
+
+  error += (sum - (t - z)) + (x - z);
+  sum = t;
+}
+
+// Each kernel is a Run() function that is inlined both into a generic build
+// and into an AVX2 build. Without the vector extensions, only the scalar
+// loops that finish the vectorized ones remain.
+
+template <bool Equal>
+struct FindKernel {
+  template <typename T>
+  [[gnu::always_inline]] static std::size_t Run(const T* data,
+                                                std::size_t n,
+                                                T x) {
+    std::size_t i = 0;
+
+#if defined(__GNUC__)
+    constexpr std::size_t kLanes = kVectorBytes / sizeof(T);
+    constexpr std::size_t kStep = kLanes * kUnroll;
+
+    const auto needle = Vector<T>{} + x;
+
+    for (; i + kStep <= n; i += kStep) {
+      Mask<T> found{};
+
+      for (std::size_t u = 0; u < kUnroll; ++u) {
+        Vector<T> v;
+        Load(v, data + i + u * kLanes);
+
+        if constexpr (Equal) {
+          found |= v == needle;
+        } else {
+          found |= v != needle;
+        }
+      }
+
+      // The match is somewhere in this step, which the loop below finds
+      if (Any<T>(found)) {
+        break;
+      }
+    }
+#endif  // defined(__GNUC__)
+
+    for (; i < n; ++i) {
+      if ((data[i] == x) == Equal) {
+        return i;
+      }
+    }
+
+    return n;
+  }
+};
+
+struct CountEqualKernel {
+  template <typename T>
+  [[gnu::always_inline]] static std::size_t Run(const T* data,
+                                                std::size_t n,
+                                                T x) {
+    std::size_t res = 0;
+    std::size_t i = 0;
+
+#if defined(__GNUC__)
+    constexpr std::size_t kLanes = kVectorBytes / sizeof(T);
+    constexpr std::size_t kStep = kLanes * kUnroll;
+
+    const auto needle = Vector<T>{} + x;
+    Mask<T> counts[kUnroll] = {};
+
+    // Subtracting the -1 lanes of the masks counts the matches of each lane
+    for (; i + kStep <= n; i += kStep) {
+      for (std::size_t u = 0; u < kUnroll; ++u) {
+        Vector<T> v;
+        Load(v, data + i + u * kLanes);
+        counts[u] -= v == needle;
+      }
+    }
+
+    for (std::size_t u = 0; u < kUnroll; ++u) {
+      for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        res += static_cast<std::size_t>(counts[u][lane]);
+      }
+    }
+#endif  // defined(__GNUC__)
+
+    for (; i < n; ++i) {
+      res += data[i] == x;
+    }
+
+    return res;
+  }
+};
+
+struct SumKernel {
+  template <typename T>
+  [[gnu::always_inline]] static T Run(const T* data, std::size_t n) {
+    // Integers are added as unsigned, so that overflows wrap around
+    using sum_type = typename std::conditional_t<std::integral<T>,
+                                                 std::make_unsigned<T>,
+                                                 std::type_identity<T>>::type;
+
+    sum_type res = 0;
+    std::size_t i = 0;
+
+#if defined(__GNUC__)
+    constexpr std::size_t kLanes = kVectorBytes / sizeof(T);
+    constexpr std::size_t kStep = kLanes * kUnroll;
+
+    // One sum per lane of each vector, so that the additions of an iteration
+    // do not wait for each other
+    Vector<sum_type> sums[kUnroll] = {};
+
+    for (; i + kStep <= n; i += kStep) {
+      for (std::size_t u = 0; u < kUnroll; ++u) {
+        Vector<sum_type> v;
+        Load(v, data + i + u * kLanes);
+        sums[u] += v;
+      }
+    }
+
+    const auto total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      res += total[lane];
+    }
+#endif  // defined(__GNUC__)
+
+    for (; i < n; ++i) {
+      res += static_cast<sum_type>(data[i]);
+    }
+
+    return static_cast<T>(res);
+  }
+};
+
+struct CompensatedSumKernel {
+  template <typename T>
+  [[gnu::always_inline]] static Compensated<T> Run(const T* data,
+                                                   std::size_t n) {
+    Compensated<T> res{0, 0};
+    std::size_t i = 0;
+
+#if defined(__GNUC__)
+    constexpr std::size_t kLanes = kVectorBytes / sizeof(T);
+    constexpr std::size_t kStep = kLanes * kUnroll;
+
+    Vector<T> sums[kUnroll] = {};
+    Vector<T> errors[kUnroll] = {};
+
+    for (; i + kStep <= n; i += kStep) {
+      for (std::size_t u = 0; u < kUnroll; ++u) {
+        Vector<T> v;
+        Load(v, data + i + u * kLanes);
+        TwoSum(sums[u], errors[u], v);
+      }
+    }
+
+    for (std::size_t u = 0; u < kUnroll; ++u) {
+      for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        TwoSum(res.sum, res.error, sums[u][lane]);
+        res.error += errors[u][lane];
+      }
+    }
+#endif  // defined(__GNUC__)
+
+    for (; i < n; ++i) {
+      TwoSum(res.sum, res.error, data[i]);
+    }
+
+    return res;
+  }
+};
+
+template <bool Max>
+struct ExtremumKernel {
+  template <typename T>
+  [[gnu::always_inline]] static Extremum<T> Run(const T* data, std::size_t n) {
+    T res = data[0];
+    bool nan = false;
+    std::size_t i = 0;
+
+    const auto better = [](const T a, const T b) {
+      if constexpr (Max) {
+        return b < a;
+      } else {
+        return a < b;
+      }
+    };
+
+#if defined(__GNUC__)
+    constexpr std::size_t kLanes = kVectorBytes / sizeof(T);
+    constexpr std::size_t kStep = kLanes * kUnroll;
+
+    if (n >= kStep) {
+      Vector<T> best[kUnroll];
+      Mask<T> nans{};
+
+      for (auto& b : best) {
+        b = Vector<T>{} + res;
+      }
+
+      for (; i + kStep <= n; i += kStep) {
+        for (std::size_t u = 0; u < kUnroll; ++u) {
+          Vector<T> v;
+          Load(v, data + i + u * kLanes);
+
+          if constexpr (Max) {
+            Blend(best[u], best[u] < v, v);
+          } else {
+            Blend(best[u], v < best[u], v);
+          }
+
+          if constexpr (std::floating_point<T>) {
+            nans |= v != v;
+          }
+        }
+      }
+
+      for (std::size_t u = 0; u < kUnroll; ++u) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+          if (better(best[u][lane], res)) {
+            res = best[u][lane];
+          }
+        }
+      }
+
+      nan = Any<T>(nans);
+    }
+#endif  // defined(__GNUC__)
+
+    for (; i < n; ++i) {
+      if constexpr (std::floating_point<T>) {
+        nan |= data[i] != data[i];
+      }
+
+      if (better(data[i], res)) {
+        res = data[i];
+      }
+    }
+
+    return {res, nan};
+  }
+};
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+inline bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+template <typename Kernel, typename... Args>
+[[gnu::target("avx2")]] auto RunAvx2(const Args... args) {
+  return Kernel::Run(args...);
+}
+
+#endif  // defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+/// @brief Runs @tparam Kernel with @p args, in its AVX2 build if the CPU
+/// supports it.
+template <typename Kernel, typename... Args>
+auto Run(const Args... args) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  if (HasAvx2()) {
+    return RunAvx2<Kernel>(args...);
+  }
+#endif  // defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+  return Kernel::Run(args...);
+}
+
+}  // namespace details
+
+/// @brief Returns the index of the first element of @p values that equals
+/// @p x, or the size of @p values if there is none.
+template <SimdElement T>
+std::size_t FindEqual(std::span<const T> values, T x) {
+  return details::Run<details::FindKernel<true>>(values.data(), values.size(),
+                                                 x);
+}
+
+/// @brief Returns the index of the first element of @p values that does not
+/// equal @p x, or the size of @p values if there is none.
+template <SimdElement T>
+std::size_t FindNotEqual(std::span<const T> values, T x) {
+  return details::Run<details::FindKernel<false>>(values.data(),
+                                                  values.size(), x);
+}
+
+/// @brief Returns the number of elements of @p values that equal @p x.
+template <SimdElement T>
+std::size_t CountEqual(std::span<const T> values, T x) {
+  return details::Run<details::CountEqualKernel>(values.data(), values.size(),
+                                                 x);
+}
+
+/// @brief Returns the sum of @p values, which wraps around on overflow for
+/// integers. Floats are added into one running sum per lane and vector, so
+/// the rounding differs from adding them in order.
+template <SimdElement T>
+T SumBlock(std::span<const T> values) {
+  return details::Run<details::SumKernel>(values.data(), values.size());
+}
+
+/// @brief Returns the sum of @p values along with the rounding errors made
+/// while adding them.
+template <SimdElement T>
+  requires std::floating_point<T>
+Compensated<T> CompensatedSumBlock(std::span<const T> values) {
+  return details::Run<details::CompensatedSumKernel>(values.data(),
+                                                     values.size());
+}
+
+/// @brief Returns the smallest of @p values, which must not be empty.
+template <SimdElement T>
+Extremum<T> MinBlock(std::span<const T> values) {
+  return details::Run<details::ExtremumKernel<false>>(values.data(),
+                                                      values.size());
+}
+
+/// @brief Returns the biggest of @p values, which must not be empty.
+template <SimdElement T>
+Extremum<T> MaxBlock(std::span<const T> values) {
+  return details::Run<details::ExtremumKernel<true>>(values.data(),
+                                                     values.size());
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Vector that stores up to @tparam N elements inline and only
+/// allocates a buffer on the heap when it grows beyond that. Only the subset
+/// of the std::vector interface that containers use is provided.
+/// @note Unlike std::vector, moving a vector whose elements are inline moves
+/// the elements one by one, so it invalidates iterators.
+template <typename T, std::size_t N>
+class SmallVector {
+ public:
+  static_assert(N > 0, "Use std::vector for vectors without inline capacity");
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() noexcept : data_(Inline()) {}
+
+  SmallVector(const SmallVector& other) : SmallVector() {
+    reserve(other.size_);
+    std::uninitialized_copy(other.begin(), other.end(), data_);
+    size_ = other.size_;
+  }
+
+  SmallVector(SmallVector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : SmallVector() {
+    Steal(other);
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size_);
+      std::uninitialized_copy(other.begin(), other.end(), data_);
+      size_ = other.size_;
+    }
+
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      Deallocate();
+      Steal(other);
+    }
+
+    return *this;
+  }
+
+  ~SmallVector() {
+    clear();
+    Deallocate();
+  }
+
+  /// @brief Returns whether the elements are stored inline.
+  bool IsInline() const noexcept { return data_ == Inline(); }
+
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  iterator begin() noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+  const_iterator cbegin() const noexcept { return data_; }
+  const_iterator cend() const noexcept { return data_ + size_; }
+
+  reference operator[](size_type idx) { return data_[idx]; }
+  const_reference operator[](size_type idx) const { return data_[idx]; }
+
+  reference back() { return data_[size_ - 1]; }
+
+  void reserve(size_type n) {
+    if (n > capacity_) {
+      Reallocate(n);
+    }
+  }
+
+  void clear() noexcept {
+    std::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  void resize(size_type n) {
+    if (n < size_) {
+      std::destroy(begin() + n, end());
+    } else {
+      reserve(n);
+      std::uninitialized_value_construct(end(), data_ + n);
+    }
+
+    size_ = n;
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      // The arguments may refer to elements of this vector, so construct the
+      // new element before the old buffer goes away
+      T elem(std::forward<Args>(args)...);
+      Reallocate(capacity_ * 2);
+      ::new (static_cast<void*>(end())) T(std::move(elem));
+    } else {
+      ::new (static_cast<void*>(end())) T(std::forward<Args>(args)...);
+    }
+
+    return data_[size_++];
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+
+  void pop_back() {
+    --size_;
+    std::destroy_at(end());
+  }
+
+  iterator insert(const_iterator pos, const T& value) {
+    const auto idx = pos - cbegin();
+    T elem(value);
+
+    if (static_cast<size_type>(idx) == size_) {
+      emplace_back(std::move(elem));
+    } else {
+      emplace_back(std::move(back()));
+      std::move_backward(begin() + idx, end() - 2, end() - 1);
+      data_[idx] = std::move(elem);
+    }
+
+    return begin() + idx;
+  }
+
+  /// @brief Inserts [@p first, @p last) before @p pos, with at most one
+  /// reallocation. As with std::vector, the range must not be in this vector.
+  template <std::forward_iterator It>
+  iterator insert(const_iterator pos, It first, It last) {
+    const auto idx = pos - cbegin();
+    const auto n = static_cast<size_type>(std::distance(first, last));
+
+    if (size_ + n > capacity_) {
+      Reallocate(std::max(size_ + n, capacity_ * 2));
+    }
+
+    // Append, then rotate the new elements into place
+    std::uninitialized_copy(first, last, end());
+    size_ += n;
+    std::rotate(begin() + idx, end() - n, end());
+
+    return begin() + idx;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    auto* mutable_first = begin() + (first - cbegin());
+
+    // Moving the tail onto itself would leave moved-from elements behind
+    if (first == last) {
+      return mutable_first;
+    }
+
+    auto* mutable_last = begin() + (last - cbegin());
+    auto* new_end = std::move(mutable_last, end(), mutable_first);
+
+    std::destroy(new_end, end());
+    size_ = new_end - begin();
+
+    return mutable_first;
+  }
+
+  bool operator==(const SmallVector& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+ private:
+  T* Inline() noexcept {
+    return std::launder(reinterpret_cast<T*>(inline_));
+  }
+
+  const T* Inline() const noexcept {
+    return std::launder(reinterpret_cast<const T*>(inline_));
+  }
+
+  void Reallocate(size_type n) {
+    auto* data = std::allocator<T>().allocate(n);
+
+    std::uninitialized_move(begin(), end(), data);
+    std::destroy(begin(), end());
+    Deallocate();
+
+    data_ = data;
+    capacity_ = n;
+  }
+
+  void Deallocate() noexcept {
+    if (!IsInline()) {
+      std::allocator<T>().deallocate(data_, capacity_);
+      data_ = Inline();
+      capacity_ = N;
+    }
+  }
+
+  // Expects this vector to be empty and inline
+  void Steal(SmallVector& other) {
+    if (other.IsInline()) {
+      std::uninitialized_move(other.begin(), other.end(), data_);
+      size_ = other.size_;
+      other.clear();
+      return;
+    }
+
+    data_ = std::exchange(other.data_, other.Inline());
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, N);
+  }
+
+  alignas(T) std::byte inline_[N * sizeof(T)];
+  T* data_;
+  size_type size_ = 0;
+  size_type capacity_ = N;
+};
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mamba::builtins::__utils {
+
+/// @brief Fixed set of worker threads that run submitted tasks. Every worker
+/// owns a deque of tasks: tasks submitted from a worker go to the back of its
+/// own deque, which it pops from last-in first-out for locality, and idle
+/// workers steal from the front of the deques of the others. Threads waiting
+/// for tasks to finish run pending tasks in the meantime, so tasks can submit
+/// and wait for tasks of their own without deadlocking.
+/// @note Tasks must not throw.
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(std::size_t num_threads = DefaultSize()) {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      queues_.emplace_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(num_threads);
+
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      workers_.emplace_back([this, i] { Work(i); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Runs the remaining tasks, then joins the workers.
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /// @brief Returns the pool shared by the whole process, with one worker per
+  /// hardware thread.
+  static ThreadPool& Default() {
+    static ThreadPool pool;
+
+    return pool;
+  }
+
+  static std::size_t DefaultSize() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  /// @brief Returns the number of workers.
+  std::size_t Size() const { return workers_.size(); }
+
+  void Submit(Task task) {
+    // Workers keep their own tasks, anyone else spreads them over all workers
+    const auto index = current_pool_ == this
+                           ? current_index_
+                           : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                 queues_.size();
+
+    {
+      auto& queue = *queues_[index];
+      std::lock_guard lock(queue.mutex);
+      queue.tasks.emplace_back(std::move(task));
+    }
+
+    {
+      std::lock_guard lock(mutex_);
+      pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    cv_.notify_one();
+  }
+
+  /// @brief Runs pending tasks on the calling thread until @p done returns
+  /// true, and yields whenever there is nothing to run.
+  template <typename F>
+  void WaitUntil(F&& done) {
+    const auto index = current_pool_ == this ? current_index_ : 0;
+
+    while (!done()) {
+      if (auto task = TryPop(index)) {
+        (*task)();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void Work(std::size_t index) {
+    current_pool_ = this;
+    current_index_ = index;
+
+    for (;;) {
+      if (auto task = TryPop(index)) {
+        (*task)();
+        continue;
+      }
+
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] {
+        return stop_ || pending_.load(std::memory_order_relaxed) > 0;
+      });
+
+      if (stop_ && pending_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+  /// @brief Pops the newest task of the queue at @p index, or else steals the
+  /// oldest task of another queue.
+  std::optional<Task> TryPop(std::size_t index) {
+    if (auto task = Pop(*queues_[index], /*newest=*/true)) {
+      return task;
+    }
+
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+      auto& queue = *queues_[(index + i) % queues_.size()];
+
+      if (auto task = Pop(queue, /*newest=*/false)) {
+        return task;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<Task> Pop(Queue& queue, bool newest) {
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+      return std::nullopt;
+    }
+
+    Task task;
+
+    if (newest) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+    return task;
+  }
+
+  inline static thread_local ThreadPool* current_pool_ = nullptr;
+  inline static thread_local std::size_t current_index_ = 0;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> next_queue_ = 0;
+
+  // Guards stop_ and increments of pending_, so that workers cannot miss a
+  // notification between checking for tasks and going to sleep
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<std::size_t> pending_ = 0;
+  bool stop_ = false;
+};
+
+/// @brief Calls @p f(begin, end) for consecutive chunks of [0, @p n) on the
+/// default thread pool, including the calling thread, and returns once all
+/// calls returned. Rethrows the first exception thrown by @p f, if any.
+template <typename F>
+void ParallelChunks(std::size_t n, std::size_t chunk, const F& f) {
+  if (n <= chunk) {
+    if (n > 0) {
+      f(std::size_t{0}, n);
+    }
+
+    return;
+  }
+
+  auto& pool = ThreadPool::Default();
+  const auto num_chunks = (n + chunk - 1) / chunk;
+
+  std::atomic<std::size_t> remaining = num_chunks;
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto run = [&](std::size_t begin) {
+    try {
+      f(begin, std::min(begin + chunk, n));
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+
+    remaining.fetch_sub(1, std::memory_order_release);
+  };
+
+  for (std::size_t i = 1; i < num_chunks; ++i) {
+    pool.Submit([&run, i, chunk] { run(i * chunk); });
+  }
+
+  run(0);
+  pool.WaitUntil(
+      [&remaining] { return remaining.load(std::memory_order_acquire) == 0; });
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
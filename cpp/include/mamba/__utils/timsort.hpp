@@ -0,0 +1,561 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mamba::builtins::__utils {
+namespace details {
+
+/// @brief State of a single TimSort, following CPython's listsort (see
+/// Objects/listsort.txt). Natural runs are detected and extended to a minimum
+/// length with binary insertion sort, then merged pairwise while the lengths
+/// of the pending runs are kept balanced. Merges switch to galloping, i.e.
+/// exponential search, while one run keeps winning, so that merging runs
+/// that barely overlap is close to a memmove.
+template <std::random_access_iterator It, typename Compare>
+class TimSorter {
+ public:
+  using value_type = std::iter_value_t<It>;
+  using index = std::iter_difference_t<It>;
+
+  TimSorter(It first, Compare& lt) : a_(first), lt_(lt) {}
+
+  void Sort(index n) {
+    if (n < 2) {
+      return;
+    }
+
+    if (n < kMinMerge) {
+      BinaryInsertionSort(0, n, CountRunAndMakeAscending(0, n));
+      return;
+    }
+
+    const auto min_run = MinRunLength(n);
+
+    for (index lo = 0; lo < n;) {
+      auto len = CountRunAndMakeAscending(lo, n);
+
+      if (len < min_run) {
+        const auto forced = std::min(n - lo, min_run);
+        BinaryInsertionSort(lo, lo + forced, lo + len);
+        len = forced;
+      }
+
+      runs_.push_back({lo, len});
+      MergeCollapse();
+      lo += len;
+    }
+
+    MergeForceCollapse();
+  }
+
+ private:
+  static constexpr index kMinMerge = 64;
+  static constexpr index kMinGallop = 7;
+
+  struct Run {
+    index base;
+    index len;
+  };
+
+  /// @brief Returns the minimum length of a run, between kMinMerge / 2 and
+  /// kMinMerge, such that @p n / length is a power of 2 or slightly less.
+  static index MinRunLength(index n) {
+    index r = 0;
+
+    while (n >= kMinMerge) {
+      r |= n & 1;
+      n >>= 1;
+    }
+
+    return n + r;
+  }
+
+  /// @brief Returns the length of the run starting at @p lo, reversing it
+  /// first if it is strictly descending. Only strictly descending runs are
+  /// reversed, which keeps the sort stable.
+  index CountRunAndMakeAscending(index lo, index hi) {
+    auto run_hi = lo + 1;
+
+    if (run_hi == hi) {
+      return 1;
+    }
+
+    if (lt_(a_[run_hi++], a_[lo])) {
+      while (run_hi < hi && lt_(a_[run_hi], a_[run_hi - 1])) {
+        ++run_hi;
+      }
+
+      std::reverse(a_ + lo, a_ + run_hi);
+    } else {
+      while (run_hi < hi && !lt_(a_[run_hi], a_[run_hi - 1])) {
+        ++run_hi;
+      }
+    }
+
+    return run_hi - lo;
+  }
+
+  /// @brief Sorts [@p lo, @p hi), of which [@p lo, @p start) is sorted
+  /// already, by inserting each element after its equals.
+  void BinaryInsertionSort(index lo, index hi, index start) {
+    for (auto i = start; i < hi; ++i) {
+      auto pivot = std::move(a_[i]);
+      auto left = lo;
+      auto right = i;
+
+      try {
+        while (left < right) {
+          const auto mid = left + (right - left) / 2;
+
+          if (lt_(pivot, a_[mid])) {
+            right = mid;
+          } else {
+            left = mid + 1;
+          }
+        }
+      } catch (...) {
+        a_[i] = std::move(pivot);
+        throw;
+      }
+
+      std::move_backward(a_ + left, a_ + i, a_ + i + 1);
+      a_[left] = std::move(pivot);
+    }
+  }
+
+  /// @brief Keeps the lengths of the pending runs such that each is greater
+  /// than the sum of the next two, which bounds the stack depth and keeps
+  /// merges balanced.
+  void MergeCollapse() {
+    while (runs_.size() > 1) {
+      auto n = static_cast<index>(runs_.size()) - 2;
+
+      if ((n > 0 && Len(n - 1) <= Len(n) + Len(n + 1)) ||
+          (n > 1 && Len(n - 2) <= Len(n) + Len(n - 1))) {
+        if (Len(n - 1) < Len(n + 1)) {
+          --n;
+        }
+      } else if (Len(n) > Len(n + 1)) {
+        break;
+      }
+
+      MergeAt(n);
+    }
+  }
+
+  void MergeForceCollapse() {
+    while (runs_.size() > 1) {
+      auto n = static_cast<index>(runs_.size()) - 2;
+
+      if (n > 0 && Len(n - 1) < Len(n + 1)) {
+        --n;
+      }
+
+      MergeAt(n);
+    }
+  }
+
+  index Len(index i) const { return runs_[i].len; }
+
+  /// @brief Merges the runs at @p i and @p i + 1 of the stack.
+  void MergeAt(index i) {
+    auto [base1, len1] = runs_[i];
+    auto [base2, len2] = runs_[i + 1];
+
+    runs_[i].len = len1 + len2;
+    runs_.erase(runs_.begin() + i + 1);
+
+    // Elements of the first run that are not greater than the first of the
+    // second run are in place already...
+    const auto k = GallopRight(a_[base2], a_ + base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+
+    if (len1 == 0) {
+      return;
+    }
+
+    // ...and so are elements of the second run that are not less than the
+    // last of the first run
+    len2 = GallopLeft(a_[base1 + len1 - 1], a_ + base2, len2, len2 - 1);
+
+    if (len2 == 0) {
+      return;
+    }
+
+    if (len1 <= len2) {
+      MergeLo(base1, len1, base2, len2);
+    } else {
+      MergeHi(base1, len1, base2, len2);
+    }
+  }
+
+  /// @brief Returns the position in the sorted range [@p base, @p base +
+  /// @p len) at which @p key would be inserted before its equals, searching
+  /// outwards from @p hint.
+  template <typename I>
+  index GallopLeft(const value_type& key, I base, index len, index hint) {
+    index last_ofs = 0;
+    index ofs = 1;
+
+    if (lt_(base[hint], key)) {
+      const auto max_ofs = len - hint;
+
+      while (ofs < max_ofs && lt_(base[hint + ofs], key)) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+
+      ofs = std::min(ofs, max_ofs);
+      last_ofs += hint;
+      ofs += hint;
+    } else {
+      const auto max_ofs = hint + 1;
+
+      while (ofs < max_ofs && !lt_(base[hint - ofs], key)) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+
+      ofs = std::min(ofs, max_ofs);
+      std::tie(last_ofs, ofs) = std::pair(hint - ofs, hint - last_ofs);
+    }
+
+    ++last_ofs;
+
+    while (last_ofs < ofs) {
+      const auto mid = last_ofs + (ofs - last_ofs) / 2;
+
+      if (lt_(base[mid], key)) {
+        last_ofs = mid + 1;
+      } else {
+        ofs = mid;
+      }
+    }
+
+    return ofs;
+  }
+
+  /// @brief Like GallopLeft(), but returns the position after the equals of
+  /// @p key.
+  template <typename I>
+  index GallopRight(const value_type& key, I base, index len, index hint) {
+    index last_ofs = 0;
+    index ofs = 1;
+
+    if (lt_(key, base[hint])) {
+      const auto max_ofs = hint + 1;
+
+      while (ofs < max_ofs && lt_(key, base[hint - ofs])) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+
+      ofs = std::min(ofs, max_ofs);
+      std::tie(last_ofs, ofs) = std::pair(hint - ofs, hint - last_ofs);
+    } else {
+      const auto max_ofs = len - hint;
+
+      while (ofs < max_ofs && !lt_(key, base[hint + ofs])) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+
+      ofs = std::min(ofs, max_ofs);
+      last_ofs += hint;
+      ofs += hint;
+    }
+
+    ++last_ofs;
+
+    while (last_ofs < ofs) {
+      const auto mid = last_ofs + (ofs - last_ofs) / 2;
+
+      if (lt_(key, base[mid])) {
+        ofs = mid;
+      } else {
+        last_ofs = mid + 1;
+      }
+    }
+
+    return ofs;
+  }
+
+  // Cursors of a merge, which must be consistent whenever a comparison may
+  // throw, so that the elements moved to tmp_ can be put back
+  struct Merge {
+    index cursor1;
+    index cursor2;
+    index dest;
+    index len1;
+    index len2;
+  };
+
+  /// @brief Merges the adjacent runs at @p base1 and @p base2 where the first
+  /// run is the shorter one, by moving it to tmp_ and merging from the left.
+  /// The first element of the second run goes first and the last element of
+  /// the first run goes last, which MergeAt() guarantees.
+  void MergeLo(index base1, index len1, index base2, index len2) {
+    tmp_.assign(std::make_move_iterator(a_ + base1),
+                std::make_move_iterator(a_ + base1 + len1));
+
+    Merge m{0, base2, base1, len1, len2};
+
+    try {
+      MergeLoLoop(m);
+    } catch (...) {
+      // The remaining elements of the first run go back to the gap before
+      // the remaining elements of the second run
+      std::move(tmp_.begin() + m.cursor1, tmp_.begin() + m.cursor1 + m.len1,
+                a_ + m.dest);
+      throw;
+    }
+
+    if (m.len1 == 1) {
+      std::move(a_ + m.cursor2, a_ + m.cursor2 + m.len2, a_ + m.dest);
+      a_[m.dest + m.len2] = std::move(tmp_[m.cursor1]);
+    } else {
+      // Only the first run remains, since its last element goes last
+      std::move(tmp_.begin() + m.cursor1, tmp_.begin() + m.cursor1 + m.len1,
+                a_ + m.dest);
+    }
+  }
+
+  void MergeLoLoop(Merge& m) {
+    auto& [cursor1, cursor2, dest, len1, len2] = m;
+
+    a_[dest++] = std::move(a_[cursor2++]);
+
+    if (--len2 == 0 || len1 == 1) {
+      return;
+    }
+
+    auto min_gallop = min_gallop_;
+
+    for (;;) {
+      index count1 = 0;
+      index count2 = 0;
+
+      // Merge one element at a time until one run wins min_gallop times in
+      // a row
+      do {
+        if (lt_(a_[cursor2], tmp_[cursor1])) {
+          a_[dest++] = std::move(a_[cursor2++]);
+          ++count2;
+          count1 = 0;
+
+          if (--len2 == 0) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        } else {
+          a_[dest++] = std::move(tmp_[cursor1++]);
+          ++count1;
+          count2 = 0;
+
+          if (--len1 == 1) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        }
+      } while ((count1 | count2) < min_gallop);
+
+      // Then gallop until neither run wins kMinGallop times in a row
+      do {
+        count1 = GallopRight(a_[cursor2], tmp_.begin() + cursor1, len1, 0);
+
+        if (count1 != 0) {
+          std::move(tmp_.begin() + cursor1, tmp_.begin() + cursor1 + count1,
+                    a_ + dest);
+          dest += count1;
+          cursor1 += count1;
+          len1 -= count1;
+
+          if (len1 <= 1) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        }
+
+        a_[dest++] = std::move(a_[cursor2++]);
+
+        if (--len2 == 0) {
+          min_gallop_ = std::max<index>(min_gallop, 1);
+          return;
+        }
+
+        count2 = GallopLeft(tmp_[cursor1], a_ + cursor2, len2, 0);
+
+        if (count2 != 0) {
+          std::move(a_ + cursor2, a_ + cursor2 + count2, a_ + dest);
+          dest += count2;
+          cursor2 += count2;
+          len2 -= count2;
+
+          if (len2 == 0) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        }
+
+        a_[dest++] = std::move(tmp_[cursor1++]);
+
+        if (--len1 == 1) {
+          min_gallop_ = std::max<index>(min_gallop, 1);
+          return;
+        }
+
+        --min_gallop;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+
+      // Galloping paid off less than merging, so make it harder to start
+      min_gallop = std::max<index>(min_gallop, 0) + 2;
+    }
+  }
+
+  /// @brief Like MergeLo(), but the second run is the shorter one and the
+  /// merge goes from the right.
+  void MergeHi(index base1, index len1, index base2, index len2) {
+    tmp_.assign(std::make_move_iterator(a_ + base2),
+                std::make_move_iterator(a_ + base2 + len2));
+
+    Merge m{base1 + len1 - 1, len2 - 1, base2 + len2 - 1, len1, len2};
+
+    try {
+      MergeHiLoop(m);
+    } catch (...) {
+      // The remaining elements of the second run go back to the gap after
+      // the remaining elements of the first run
+      std::move(tmp_.begin(), tmp_.begin() + m.len2,
+                a_ + (m.dest - (m.len2 - 1)));
+      throw;
+    }
+
+    if (m.len2 == 1) {
+      m.dest -= m.len1;
+      m.cursor1 -= m.len1;
+      std::move_backward(a_ + m.cursor1 + 1, a_ + m.cursor1 + 1 + m.len1,
+                         a_ + m.dest + 1 + m.len1);
+      a_[m.dest] = std::move(tmp_[m.cursor2]);
+    } else {
+      std::move(tmp_.begin(), tmp_.begin() + m.len2,
+                a_ + (m.dest - (m.len2 - 1)));
+    }
+  }
+
+  void MergeHiLoop(Merge& m) {
+    auto& [cursor1, cursor2, dest, len1, len2] = m;
+
+    a_[dest--] = std::move(a_[cursor1--]);
+
+    if (--len1 == 0 || len2 == 1) {
+      return;
+    }
+
+    auto min_gallop = min_gallop_;
+
+    for (;;) {
+      index count1 = 0;
+      index count2 = 0;
+
+      do {
+        if (lt_(tmp_[cursor2], a_[cursor1])) {
+          a_[dest--] = std::move(a_[cursor1--]);
+          ++count1;
+          count2 = 0;
+
+          if (--len1 == 0) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        } else {
+          a_[dest--] = std::move(tmp_[cursor2--]);
+          ++count2;
+          count1 = 0;
+
+          if (--len2 == 1) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        }
+      } while ((count1 | count2) < min_gallop);
+
+      do {
+        const auto base1 = cursor1 - len1 + 1;
+        count1 = len1 - GallopRight(tmp_[cursor2], a_ + base1, len1, len1 - 1);
+
+        if (count1 != 0) {
+          dest -= count1;
+          cursor1 -= count1;
+          len1 -= count1;
+          std::move_backward(a_ + cursor1 + 1, a_ + cursor1 + 1 + count1,
+                             a_ + dest + 1 + count1);
+
+          if (len1 == 0) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        }
+
+        a_[dest--] = std::move(tmp_[cursor2--]);
+
+        if (--len2 == 1) {
+          min_gallop_ = std::max<index>(min_gallop, 1);
+          return;
+        }
+
+        count2 = len2 - GallopLeft(a_[cursor1], tmp_.begin(), len2, len2 - 1);
+
+        if (count2 != 0) {
+          dest -= count2;
+          cursor2 -= count2;
+          len2 -= count2;
+          std::move(tmp_.begin() + cursor2 + 1,
+                    tmp_.begin() + cursor2 + 1 + count2, a_ + dest + 1);
+
+          if (len2 <= 1) {
+            min_gallop_ = std::max<index>(min_gallop, 1);
+            return;
+          }
+        }
+
+        a_[dest--] = std::move(a_[cursor1--]);
+
+        if (--len1 == 0) {
+          min_gallop_ = std::max<index>(min_gallop, 1);
+          return;
+        }
+
+        --min_gallop;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+
+      min_gallop = std::max<index>(min_gallop, 0) + 2;
+    }
+  }
+
+  It a_;
+  Compare& lt_;
+  index min_gallop_ = kMinGallop;
+  std::vector<Run> runs_;
+  std::vector<value_type> tmp_;
+};
+
+}  // namespace details
+
+/// @brief Sorts [@p first, @p last) in place with TimSort, which is stable
+/// and runs in O(n) on data that is already (reverse-)sorted or made of a
+/// few sorted runs, and in O(n log n) otherwise. @p lt is the less-than
+/// comparison. If @p lt throws, the range is left as some permutation of its
+/// elements.
+template <std::random_access_iterator It, typename Compare>
+void TimSort(It first, It last, Compare lt) {
+  details::TimSorter<It, Compare>(first, lt).Sort(last - first);
+}
+
+}  // namespace mamba::builtins::__utils
+
+// IWYU pragma: private
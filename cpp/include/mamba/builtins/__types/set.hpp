@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <unordered_set>
 #include <utility>
@@ -12,6 +14,7 @@
 #include "mamba/__concepts/entity.hpp"
 #include "mamba/__memory/handle.hpp"
 #include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
 #include "mamba/__memory/read_only.hpp"
 #include "mamba/builtins/__types/int.hpp"
 #include "mamba/builtins/__types/str.hpp"
@@ -31,7 +34,7 @@ class SetIteratorBase;
 
 /// Curiously recurring template
 template <__concepts::Entity T, typename Derived>
-class SetBase : public std::enable_shared_from_this<Derived<T>> {
+class SetBase : public __memory::EnableHandleFromThis<Derived<T>> {
  public:
   /// @note Mamba-specific
   using element = T;
@@ -61,16 +64,10 @@ class SetBase : public std::enable_shared_from_this<Derived<T>> {
   template <typename It>
     requires __concepts::TypedIterable<It, element>
   explicit SetBase(It& iterable) {
-    bool no_stop_iteration = true;
     auto it = iterable.Iter();
 
-    while (no_stop_iteration) {
-      try {
-        Add(Next(*it));
-      } catch (StopIteration) {
-        no_stop_iteration = false;
-        break;
-      }
+    while (auto elem = TryNext(*it)) {
+      Add(*std::move(elem));
     }
   }
 
@@ -169,7 +166,8 @@ class SetBase : public std::enable_shared_from_this<Derived<T>> {
   /// @brief Returns an iterator to this set.
   /// @code set.__iter__()
   __memory::handle_t<Iterator<element>> Iter() {
-    return details::SetIteratorBase<element>::Init(s_.begin(), s_.end());
+    return details::SetIteratorBase<element>::Init(s_.begin(), s_.end(),
+                                                    s_.size());
   }
 
   /// @brief Native support for C++ for..in loops.
@@ -315,7 +313,7 @@ namespace details {
 template <__concepts::Entity T>
 class SetIteratorBase
     : public Iterator<T>,
-      public std::enable_shared_from_this<SetIteratorBase<T>> {
+      public __memory::EnableHandleFromThis<SetIteratorBase<T>> {
  public:
   /// @brief Mamba-specific
   using element = T;
@@ -327,31 +325,47 @@ class SetIteratorBase
   using self = SetIteratorBase<element>;
   using handle = __memory::handle_t<self>;
 
-  SetIteratorBase(iterator it, iterator end)
-      : it_(std::move(it)), end_(std::move(end)) {}
+  // @p len is the number of elements in [@p it, @p end), which LengthHint()
+  // counts down
+  SetIteratorBase(iterator it, iterator end, std::size_t len)
+      : it_(std::move(it)), end_(std::move(end)), len_(len) {}
 
   ~SetIteratorBase() override = default;
 
   /// @brief Generic constructor forwarding arguments to actual constructor
-  /// methods.
+  /// methods. Iterators come from the pool of the calling thread.
   /// @code SetIteratorBase.__init__()
+  /// @see pool.hpp
   template <typename... Args>
   static handle Init(Args&&... args) {
-    return __memory::Init<self>(std::forward<Args>(args)...);
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
   }
 
   __memory::handle_t<Iterator<element>> Iter() override {
-    return std::enable_shared_from_this<self>::shared_from_this();
+    return this->HandleFromThis();
   }
 
-  value_type Next() override {
+  std::optional<value_type> TryNext() override {
     if (it_ == end_) {
-      throw StopIteration("end of iterator");
+      return std::nullopt;
     }
 
+    --len_;
+
     return *it_++;
   }
 
+  std::size_t NextBatch(std::span<value_type> out) override {
+    const auto n = details::CopyBatch(it_, end_, out);
+    len_ -= n;
+
+    return n;
+  }
+
+  __types::Int LengthHint() const override {
+    return static_cast<__types::Int>(len_);
+  }
+
   __types::Str Repr() const override { return "SetIteratorBase"; }
 
   bool operator==(const self& other) const {
@@ -366,6 +380,7 @@ class SetIteratorBase
  private:
   iterator it_;
   iterator end_;
+  std::size_t len_;
 };
 
 }  // namespace details
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "mamba/__memory/handle.hpp"
+#include "mamba/builtins/__as_bool/bool.hpp"
+#include "mamba/builtins/__as_bool/float.hpp"
+#include "mamba/builtins/__as_bool/int.hpp"
+#include "mamba/builtins/__as_bool/str.hpp"
+#include "mamba/builtins/__types/int.hpp"
+#include "mamba/builtins/__types/tuple.hpp"
+#include "mamba/builtins/iteration.hpp"
+
+namespace mamba::builtins {
+namespace __concepts {
+
+template <typename T>
+concept DirectlyAdaptable =
+    StaticIterator<T> || StaticIterable<T> || Iterable<T>;
+
+/// @brief Anything that the adaptors below can iterate over, including
+/// handles to it.
+template <typename T>
+concept Adaptable =
+    DirectlyAdaptable<std::remove_cvref_t<T>> ||
+    (__memory::Handle<std::remove_cvref_t<T>> &&
+     DirectlyAdaptable<typename std::remove_cvref_t<T>::element_type>);
+
+}  // namespace __concepts
+
+namespace details {
+
+/// @brief Adapts a type-erased Iterator<T> to the static iterator protocol,
+/// for iterables that have no concrete iterator.
+template <__concepts::Entity T>
+class ErasedIterator final {
+ public:
+  using element = T;
+  using value_type = __memory::managed_t<element>;
+
+  explicit ErasedIterator(__memory::handle_t<Iterator<element>> it)
+      : it_(std::move(it)) {}
+
+  std::optional<value_type> TryNext() { return it_->TryNext(); }
+
+  __types::Int LengthHint() const { return it_->LengthHint(); }
+
+ private:
+  __memory::handle_t<Iterator<element>> it_;
+};
+
+/// @brief Adapts a handle to a static iterator to the static iterator
+/// protocol. The iterator is shared rather than copied, so that, like in
+/// Python, map(f, it) advances it, and so that iterators that cannot be
+/// copied, e.g. generators, can be adapted too.
+template <__concepts::StaticIterator It>
+class SharedIterator final {
+ public:
+  using value_type = It::value_type;
+
+  explicit SharedIterator(__memory::handle_t<It> it) : it_(std::move(it)) {}
+
+  std::optional<value_type> TryNext() { return it_->TryNext(); }
+
+  __types::Int LengthHint() const { return builtins::LengthHint(*it_); }
+
+ private:
+  __memory::handle_t<It> it_;
+};
+
+/// @brief Static iterator over the object that @p owner manages, which keeps
+/// the object alive for as long as it iterates over it, e.g. when a pipeline
+/// over a container outlives the other handles to the container.
+template <__memory::Handle H, __concepts::StaticIterator It>
+class OwningIterator final {
+ public:
+  using value_type = It::value_type;
+
+  OwningIterator(H owner, It it)
+      : owner_(std::move(owner)), it_(std::move(it)) {}
+
+  std::optional<value_type> TryNext() { return it_.TryNext(); }
+
+  __types::Int LengthHint() const { return builtins::LengthHint(it_); }
+
+  // Native C++ iteration support
+  StaticIteratorWrapper<OwningIterator> begin() {
+    return StaticIteratorWrapper(*this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  H owner_;
+  It it_;
+};
+
+/// @brief Returns a static iterator over @p iterable, i.e. @p iterable
+/// itself if it is already one, its concrete iterator if it has one, and its
+/// type-erased iterator otherwise. Static iterators over handles keep the
+/// handles.
+template <__concepts::Adaptable T>
+auto ToStaticIterator(T&& iterable) {
+  using type = std::remove_cvref_t<T>;
+
+  if constexpr (__memory::Handle<type>) {
+    using element_type = type::element_type;
+
+    if constexpr (__concepts::StaticIterator<element_type>) {
+      return SharedIterator<element_type>(std::forward<T>(iterable));
+    } else {
+      auto it = ToStaticIterator(*iterable);
+
+      return OwningIterator<type, decltype(it)>(std::forward<T>(iterable),
+                                                std::move(it));
+    }
+  } else if constexpr (__concepts::StaticIterator<type>) {
+    return type(std::forward<T>(iterable));
+  } else if constexpr (__concepts::StaticIterable<type>) {
+    return iterable.StaticIter();
+  } else {
+    return ErasedIterator<typename type::element>(iterable.Iter());
+  }
+}
+
+template <typename T>
+using static_iterator_t = decltype(ToStaticIterator(std::declval<T>()));
+
+template <__concepts::StaticIterator It, typename F>
+class MapIterator final {
+ public:
+  using value_type =
+      std::remove_cvref_t<std::invoke_result_t<F&, typename It::value_type>>;
+
+  MapIterator(It it, F f) : it_(std::move(it)), f_(std::move(f)) {}
+
+  std::optional<value_type> TryNext() {
+    auto elem = it_.TryNext();
+
+    if (!elem) {
+      return std::nullopt;
+    }
+
+    return std::invoke(f_, *std::move(elem));
+  }
+
+  __types::Int LengthHint() const { return builtins::LengthHint(it_); }
+
+  // Native C++ iteration support
+  StaticIteratorWrapper<MapIterator> begin() {
+    return StaticIteratorWrapper(*this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  It it_;
+  F f_;
+};
+
+template <__concepts::StaticIterator It, typename F>
+class FilterIterator final {
+ public:
+  using value_type = It::value_type;
+
+  FilterIterator(It it, F pred) : it_(std::move(it)), pred_(std::move(pred)) {}
+
+  std::optional<value_type> TryNext() {
+    while (auto elem = it_.TryNext()) {
+      if (AsBool(std::invoke(pred_, *elem))) {
+        return elem;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  // Native C++ iteration support
+  StaticIteratorWrapper<FilterIterator> begin() {
+    return StaticIteratorWrapper(*this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  It it_;
+  F pred_;
+};
+
+template <__concepts::StaticIterator... Its>
+class ZipIterator final {
+ public:
+  using value_type = __types::Tuple<typename Its::value_type...>;
+
+  explicit ZipIterator(Its... its) : its_(std::move(its)...) {}
+
+  std::optional<value_type> TryNext() {
+    return TryNext(std::index_sequence_for<Its...>{});
+  }
+
+  /// @brief Returns the smallest hint of the iterators, since zipping stops
+  /// at the shortest one.
+  __types::Int LengthHint() const {
+    return std::apply(
+        [](const auto&... its) {
+          return std::min({builtins::LengthHint(its)...});
+        },
+        its_);
+  }
+
+  // Native C++ iteration support
+  StaticIteratorWrapper<ZipIterator> begin() {
+    return StaticIteratorWrapper(*this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  template <std::size_t... Is>
+  std::optional<value_type> TryNext(std::index_sequence<Is...>) {
+    std::tuple<std::optional<typename Its::value_type>...> elems;
+
+    // Like zip(), stops at the first exhausted iterator without advancing
+    // the ones after it
+    const bool exhausted =
+        (... || !(std::get<Is>(elems) = std::get<Is>(its_).TryNext()));
+
+    if (exhausted) {
+      return std::nullopt;
+    }
+
+    return value_type(*std::move(std::get<Is>(elems))...);
+  }
+
+  std::tuple<Its...> its_;
+};
+
+template <__concepts::StaticIterator It>
+class EnumerateIterator final {
+ public:
+  using value_type = __types::Tuple<__types::Int, typename It::value_type>;
+
+  EnumerateIterator(It it, __types::Int start)
+      : it_(std::move(it)), idx_(start) {}
+
+  std::optional<value_type> TryNext() {
+    auto elem = it_.TryNext();
+
+    if (!elem) {
+      return std::nullopt;
+    }
+
+    return value_type(idx_++, *std::move(elem));
+  }
+
+  __types::Int LengthHint() const { return builtins::LengthHint(it_); }
+
+  // Native C++ iteration support
+  StaticIteratorWrapper<EnumerateIterator> begin() {
+    return StaticIteratorWrapper(*this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  It it_;
+  __types::Int idx_;
+};
+
+template <std::bidirectional_iterator It>
+class ReversedIterator final {
+ public:
+  using value_type = std::iter_value_t<It>;
+
+  ReversedIterator(It begin, It end)
+      : begin_(std::move(begin)), it_(std::move(end)) {}
+
+  std::optional<value_type> TryNext() {
+    if (it_ == begin_) {
+      return std::nullopt;
+    }
+
+    return *--it_;
+  }
+
+  __types::Int LengthHint() const { return RemainingLength(begin_, it_); }
+
+  // Native C++ iteration support
+  StaticIteratorWrapper<ReversedIterator> begin() {
+    return StaticIteratorWrapper(*this);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  It begin_;
+  It it_;
+};
+
+}  // namespace details
+
+// The adaptors below are lazy and evaluate nothing until they are iterated,
+// e.g. with ForEach() or by constructing a container from them. They are
+// plain values that hold the iterators of their sources, so chaining them
+// fuses the whole pipeline into a single loop. Like iterators, they must not
+// outlive the containers they iterate over, unless they are given handles to
+// the containers, which they keep.
+
+/// @brief Returns an iterator applying @p f to each element of @p iterable.
+/// @code map(f, iterable)
+template <typename F, __concepts::Adaptable T>
+auto Map(F f, T&& iterable) {
+  return details::MapIterator<details::static_iterator_t<T>, F>(
+      details::ToStaticIterator(std::forward<T>(iterable)), std::move(f));
+}
+
+/// @brief Returns an iterator over the elements of @p iterable for which
+/// @p pred is truthy.
+/// @code filter(pred, iterable)
+template <typename F, __concepts::Adaptable T>
+auto Filter(F pred, T&& iterable) {
+  return details::FilterIterator<details::static_iterator_t<T>, F>(
+      details::ToStaticIterator(std::forward<T>(iterable)), std::move(pred));
+}
+
+/// @brief Returns an iterator over tuples of the elements of @p iterables at
+/// the same position, which stops at the end of the shortest one.
+/// @code zip(*iterables)
+template <__concepts::Adaptable... Ts>
+auto Zip(Ts&&... iterables) {
+  return details::ZipIterator<details::static_iterator_t<Ts>...>(
+      details::ToStaticIterator(std::forward<Ts>(iterables))...);
+}
+
+/// @brief Returns an iterator over (index, element) tuples of @p iterable,
+/// with indices counting from @p start.
+/// @code enumerate(iterable, start)
+template <__concepts::Adaptable T>
+auto Enumerate(T&& iterable, __types::Int start = 0) {
+  return details::EnumerateIterator<details::static_iterator_t<T>>(
+      details::ToStaticIterator(std::forward<T>(iterable)), start);
+}
+
+/// @brief Returns an iterator over the elements of @p sequence from last to
+/// first.
+/// @code reversed(sequence)
+template <typename T>
+  requires std::bidirectional_iterator<typename T::const_iterator>
+auto Reversed(const T& sequence) {
+  return details::ReversedIterator<typename T::const_iterator>(
+      sequence.cbegin(), sequence.cend());
+}
+
+template <typename T>
+auto Reversed(const __memory::handle_t<T>& sequence) {
+  auto it = Reversed(*sequence);
+
+  return details::OwningIterator<__memory::handle_t<T>, decltype(it)>(
+      sequence, std::move(it));
+}
+
+}  // namespace mamba::builtins
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/read_only.hpp"
+#include "mamba/builtins/__types/int.hpp"
+#include "mamba/builtins/comparators.hpp"
+#include "mamba/builtins/error.hpp"
+#include "mamba/builtins/list.hpp"
+#include "mamba/builtins/slice_view.hpp"
+
+namespace mamba::builtins {
+namespace details {
+
+/// @brief Returns the index of the first of the @p n elements from @p first
+/// for which @p pred is false, where @p pred is true for all elements before
+/// it and false for all elements after it. Each step halves the range by
+/// selecting its new start rather than branching on @p pred, so that the
+/// loop runs the same number of steps for all searches and the CPU never
+/// mispredicts which half to keep.
+template <std::random_access_iterator It, typename Pred>
+std::size_t BranchlessPartitionPoint(It first,
+                                     std::size_t n,
+                                     const Pred& pred) {
+  if (n == 0) {
+    return 0;
+  }
+
+  std::size_t base = 0;
+
+  while (n > 1) {
+    const auto half = n / 2;
+
+    // A conditional move rather than a branch
+    base = pred(first[base + half]) ? base + half : base;
+    n -= half;
+  }
+
+  return base + static_cast<std::size_t>(pred(first[base]));
+}
+
+/// @brief Returns [@p lo, @p hi) as indices into a list of @p len elements.
+/// Like Python, throws ValueError if @p lo is negative. @p hi defaults to
+/// @p len, and both are clamped to it so that the result is a valid place to
+/// insert at.
+inline std::pair<std::size_t, std::size_t> NormalizeBisectBounds(
+    __types::Int lo,
+    __types::Int hi,
+    std::size_t len) {
+  if (lo < 0) {
+    throw ValueError("lo must be non-negative");
+  }
+
+  const auto size_t_lo = std::min(static_cast<std::size_t>(lo), len);
+  auto size_t_hi = len;
+
+  if (hi != kEndIndex && hi < static_cast<__types::Int>(len)) {
+    size_t_hi = static_cast<std::size_t>(std::max<__types::Int>(hi, 0));
+  }
+
+  // Like Python, a range with @p hi before @p lo is empty
+  return {size_t_lo, std::max(size_t_lo, size_t_hi)};
+}
+
+template <typename T, typename Storage, typename Pred>
+__types::Int BisectIndex(const List<T, Storage>& a,
+                         __types::Int lo,
+                         __types::Int hi,
+                         const Pred& pred) {
+  const auto [first, last] = NormalizeBisectBounds(lo, hi, a.Len());
+
+  return static_cast<__types::Int>(
+      first +
+      BranchlessPartitionPoint(a.cbegin() + first, last - first, pred));
+}
+
+}  // namespace details
+
+/// @brief Returns the index at which to insert @p x in @p a, which must be
+/// sorted, so that it stays sorted, before any element equal to @p x. Only
+/// [@p lo, @p hi) is searched, @p hi defaulting to the length of @p a. If
+/// @p lo is negative, throws ValueError. O(log n), with a branchless binary
+/// search.
+/// @code bisect.bisect_left(a, x, lo, hi)
+template <typename T, typename Storage>
+__types::Int BisectLeft(const List<T, Storage>& a,
+                        __memory::ReadOnly<T> x,
+                        __types::Int lo = 0,
+                        __types::Int hi = kEndIndex) {
+  return details::BisectIndex(a, lo, hi, [&x](const auto& elem) {
+    return operators::Lt(elem, x);
+  });
+}
+
+/// @brief Like BisectLeft(), but compares @p x to the results of calling
+/// @p key on the elements of @p a rather than to the elements themselves.
+/// @code bisect.bisect_left(a, x, lo, hi, key=key)
+template <typename T, typename Storage, typename X, typename K>
+  requires details::ListSortKey<K, T>
+__types::Int BisectLeft(const List<T, Storage>& a,
+                        const X& x,
+                        const K& key,
+                        __types::Int lo = 0,
+                        __types::Int hi = kEndIndex) {
+  return details::BisectIndex(a, lo, hi, [&x, &key](const auto& elem) {
+    return operators::Lt(key(elem), x);
+  });
+}
+
+/// @brief Returns the index at which to insert @p x in @p a, which must be
+/// sorted, so that it stays sorted, after any element equal to @p x. See
+/// BisectLeft() for @p lo and @p hi.
+/// @code bisect.bisect_right(a, x, lo, hi)
+template <typename T, typename Storage>
+__types::Int BisectRight(const List<T, Storage>& a,
+                         __memory::ReadOnly<T> x,
+                         __types::Int lo = 0,
+                         __types::Int hi = kEndIndex) {
+  return details::BisectIndex(a, lo, hi, [&x](const auto& elem) {
+    return !operators::Lt(x, elem);
+  });
+}
+
+/// @brief Like BisectRight(), but compares @p x to the results of calling
+/// @p key on the elements of @p a rather than to the elements themselves.
+/// @code bisect.bisect_right(a, x, lo, hi, key=key)
+template <typename T, typename Storage, typename X, typename K>
+  requires details::ListSortKey<K, T>
+__types::Int BisectRight(const List<T, Storage>& a,
+                         const X& x,
+                         const K& key,
+                         __types::Int lo = 0,
+                         __types::Int hi = kEndIndex) {
+  return details::BisectIndex(a, lo, hi, [&x, &key](const auto& elem) {
+    return !operators::Lt(x, key(elem));
+  });
+}
+
+/// @brief Inserts @p x in @p a, which must be sorted, so that it stays
+/// sorted, before any element equal to @p x. The elements after it are
+/// shifted once, as one move of the underlying storage. See BisectLeft() for
+/// @p lo and @p hi.
+/// @code bisect.insort_left(a, x, lo, hi)
+template <typename T, typename Storage>
+void InsortLeft(List<T, Storage>& a,
+                __memory::ReadOnly<T> x,
+                __types::Int lo = 0,
+                __types::Int hi = kEndIndex) {
+  a.InsertAt(BisectLeft(a, x, lo, hi), x);
+}
+
+/// @brief Like InsortLeft(), but compares the result of calling @p key on
+/// @p x to the results of calling it on the elements of @p a.
+/// @code bisect.insort_left(a, x, lo, hi, key=key)
+template <typename T, typename Storage, typename K>
+  requires details::ListSortKey<K, T>
+void InsortLeft(List<T, Storage>& a,
+                __memory::ReadOnly<T> x,
+                const K& key,
+                __types::Int lo = 0,
+                __types::Int hi = kEndIndex) {
+  a.InsertAt(BisectLeft(a, key(x), key, lo, hi), x);
+}
+
+/// @brief Inserts @p x in @p a, which must be sorted, so that it stays
+/// sorted, after any element equal to @p x. The elements after it are
+/// shifted once, as one move of the underlying storage. See BisectLeft() for
+/// @p lo and @p hi.
+/// @code bisect.insort_right(a, x, lo, hi)
+template <typename T, typename Storage>
+void InsortRight(List<T, Storage>& a,
+                 __memory::ReadOnly<T> x,
+                 __types::Int lo = 0,
+                 __types::Int hi = kEndIndex) {
+  a.InsertAt(BisectRight(a, x, lo, hi), x);
+}
+
+/// @brief Like InsortRight(), but compares the result of calling @p key on
+/// @p x to the results of calling it on the elements of @p a.
+/// @code bisect.insort_right(a, x, lo, hi, key=key)
+template <typename T, typename Storage, typename K>
+  requires details::ListSortKey<K, T>
+void InsortRight(List<T, Storage>& a,
+                 __memory::ReadOnly<T> x,
+                 const K& key,
+                 __types::Int lo = 0,
+                 __types::Int hi = kEndIndex) {
+  a.InsertAt(BisectRight(a, key(x), key, lo, hi), x);
+}
+
+/// @brief Same as BisectRight().
+/// @code bisect.bisect(a, x, ...)
+template <typename T, typename Storage, typename... Args>
+__types::Int Bisect(const List<T, Storage>& a, Args&&... args) {
+  return BisectRight(a, std::forward<Args>(args)...);
+}
+
+/// @brief Same as InsortRight().
+/// @code bisect.insort(a, x, ...)
+template <typename T, typename Storage, typename... Args>
+void Insort(List<T, Storage>& a, Args&&... args) {
+  InsortRight(a, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Storage, typename... Args>
+__types::Int BisectLeft(const __memory::handle_t<List<T, Storage>>& a,
+                        Args&&... args) {
+  return BisectLeft(*a, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Storage, typename... Args>
+__types::Int BisectRight(const __memory::handle_t<List<T, Storage>>& a,
+                         Args&&... args) {
+  return BisectRight(*a, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Storage, typename... Args>
+__types::Int Bisect(const __memory::handle_t<List<T, Storage>>& a,
+                    Args&&... args) {
+  return BisectRight(*a, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Storage, typename... Args>
+void InsortLeft(const __memory::handle_t<List<T, Storage>>& a,
+                Args&&... args) {
+  InsortLeft(*a, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Storage, typename... Args>
+void InsortRight(const __memory::handle_t<List<T, Storage>>& a,
+                 Args&&... args) {
+  InsortRight(*a, std::forward<Args>(args)...);
+}
+
+template <typename T, typename Storage, typename... Args>
+void Insort(const __memory::handle_t<List<T, Storage>>& a, Args&&... args) {
+  InsortRight(*a, std::forward<Args>(args)...);
+}
+
+}  // namespace mamba::builtins
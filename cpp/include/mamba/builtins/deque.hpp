@@ -0,0 +1,697 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "mamba/__concepts/comparable.hpp"
+#include "mamba/__concepts/entity.hpp"
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
+#include "mamba/__memory/read_only.hpp"
+#include "mamba/__utils/segmented_ring.hpp"
+#include "mamba/__utils/simd.hpp"
+#include "mamba/builtins/__types/bool.hpp"
+#include "mamba/builtins/__types/int.hpp"
+#include "mamba/builtins/__types/str.hpp"
+#include "mamba/builtins/as_str.hpp"
+#include "mamba/builtins/comparators.hpp"
+#include "mamba/builtins/error.hpp"
+#include "mamba/builtins/iteration.hpp"
+#include "mamba/builtins/repr.hpp"
+
+namespace mamba::builtins {
+namespace details {
+
+// Forward declaration
+template <__concepts::Entity T>
+class DequeIterator;
+
+}  // namespace details
+
+/// @brief Double-ended queue of elements of type @tparam T, with O(1) appends
+/// and pops at both ends and O(1) indexing. Unlike List, popping the first
+/// element does not shift the others, which makes it the container for FIFO
+/// queues, e.g. in breadth-first searches. If a maximum length is given,
+/// appending to a full deque discards an element from the other end.
+/// @code collections.deque
+/// @see segmented_ring.hpp
+template <typename T>
+  requires __concepts::Entity<T> && __concepts::LessThanComparable<T>
+class Deque : public __memory::EnableHandleFromThis<Deque<T>> {
+ public:
+  /// @note Mamba-specific
+  using element = T;
+
+  using value_type = __memory::managed_t<element>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  /// @note Mamba-specific
+  using storage = __utils::SegmentedRing<value_type>;
+
+  using iterator = storage::iterator;
+  using const_iterator = storage::const_iterator;
+
+  /// @note Mamba-specific
+  using self = Deque<element>;
+  using handle = __memory::handle_t<self>;
+
+  /// @brief Creates an empty deque of unbounded length.
+  /// @code deque()
+  Deque() {}
+
+  /// @brief Creates a deque with the same elements as @p iterable, and a
+  /// maximum length of @p maxlen if given. Only the last @p maxlen elements
+  /// are kept. If @p maxlen is negative, throws ValueError.
+  /// @code deque(iterable, maxlen)
+  template <typename It>
+    requires __concepts::TypedIterable<It, element>
+  explicit Deque(It& iterable,
+                 std::optional<__types::Int> maxlen = std::nullopt)
+      : maxlen_(CheckMaxLen(maxlen)) {
+    Extend(iterable);
+  }
+
+  /// @brief Creates a deque with the remaining elements of @p it, e.g. of a
+  /// pipeline of adaptors, and a maximum length of @p maxlen if given.
+  /// @code deque(map(f, iterable), maxlen)
+  /// @see adaptors.hpp
+  template <__concepts::StaticIterator It>
+    requires std::convertible_to<typename It::value_type, value_type> &&
+             (!__concepts::TypedIterable<It, element>)
+  explicit Deque(It it, std::optional<__types::Int> maxlen = std::nullopt)
+      : maxlen_(CheckMaxLen(maxlen)) {
+    ForEach(it, [this](value_type elem) { Append(std::move(elem)); });
+  }
+
+  /// @brief Creates a deque from an initializer list, and a maximum length
+  /// of @p maxlen if given.
+  /// @code deque([...], maxlen)
+  Deque(std::initializer_list<value_type> elements,
+        std::optional<__types::Int> maxlen = std::nullopt)
+      : maxlen_(CheckMaxLen(maxlen)) {
+    for (const auto& elem : elements) {
+      Append(elem);
+    }
+  }
+
+  /// @brief Generic constructor forwarding arguments to actual constructor
+  /// methods.
+  /// @code Deque.__init__()
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::Init<self>(std::forward<Args>(args)...);
+  }
+
+  /// @brief Appends @p elem to the end of the deque. If the deque is full,
+  /// the first element is discarded. Amortized O(1).
+  /// @code deque.append(elem)
+  void Append(__memory::ReadOnly<element> elem) {
+    // Appending first copies @p elem before it may be discarded
+    v_.emplace_back(elem);
+
+    if (v_.size() > maxlen_) {
+      v_.pop_front();
+    }
+  }
+
+  /// @brief Prepends @p elem to the start of the deque. If the deque is full,
+  /// the last element is discarded. Amortized O(1).
+  /// @code deque.appendleft(elem)
+  void AppendLeft(__memory::ReadOnly<element> elem) {
+    v_.emplace_front(elem);
+
+    if (v_.size() > maxlen_) {
+      v_.pop_back();
+    }
+  }
+
+  /// @brief Returns whether @p elem is in the deque. O(n), vectorized for
+  /// Int and Float elements.
+  /// @code elem in deque
+  __types::Bool Contains(__memory::ReadOnly<element> elem) const {
+    return Find(elem, 0, v_.size()) != v_.size();
+  }
+
+  /// @brief Clears the elements of the deque.
+  /// @code deque.clear()
+  void Clear() { v_.clear(); }
+
+  /// @brief Creates a shallow copy of the deque, with the same maximum
+  /// length.
+  /// @code deque.copy()
+  handle Copy() const {
+    // Invoke copy constructor
+    return Init(*this);
+  }
+
+  /// @brief Appends the elements of @p iterable to the end of the deque, in
+  /// order. If the deque becomes full, elements are discarded from its start.
+  /// @code deque.extend(iterable)
+  template <typename It>
+    requires __concepts::TypedIterable<It, element>
+  void Extend(It& iterable) {
+    if constexpr (std::same_as<std::remove_cv_t<It>, self>) {
+      if (&iterable == this) {
+        // Appending would both shift and grow the elements being iterated
+        const auto copy = v_;
+
+        for (const auto& elem : copy) {
+          Append(elem);
+        }
+
+        return;
+      }
+    }
+
+    ForEach(iterable, [this](value_type elem) { Append(std::move(elem)); });
+  }
+
+  template <typename It>
+    requires __concepts::TypedIterable<It, element>
+  void Extend(const __memory::handle_t<It>& iterable) {
+    Extend(*iterable);
+  }
+
+  /// @brief Prepends the elements of @p iterable to the start of the deque,
+  /// one at a time, so that they end up in reverse order. If the deque
+  /// becomes full, elements are discarded from its end.
+  /// @code deque.extendleft(iterable)
+  template <typename It>
+    requires __concepts::TypedIterable<It, element>
+  void ExtendLeft(It& iterable) {
+    if constexpr (std::same_as<std::remove_cv_t<It>, self>) {
+      if (&iterable == this) {
+        const auto copy = v_;
+
+        for (const auto& elem : copy) {
+          AppendLeft(elem);
+        }
+
+        return;
+      }
+    }
+
+    ForEach(iterable,
+            [this](value_type elem) { AppendLeft(std::move(elem)); });
+  }
+
+  template <typename It>
+    requires __concepts::TypedIterable<It, element>
+  void ExtendLeft(const __memory::handle_t<It>& iterable) {
+    ExtendLeft(*iterable);
+  }
+
+  /// @brief Returns the element at index @p idx. If the index is out of range,
+  /// throws IndexError. @p idx supports negative indices counting from the
+  /// last elements. O(1).
+  /// @code deque[idx] (= elem)
+  reference operator[](__types::Int idx) {
+    const auto idx_opt = TryGetNormalizedIndex(idx);
+
+    if (!idx_opt) {
+      throw IndexError("deque index out of range");
+    }
+
+    return v_[*idx_opt];
+  }
+
+  const_reference operator[](__types::Int idx) const {
+    const auto idx_opt = TryGetNormalizedIndex(idx);
+
+    if (!idx_opt) {
+      throw IndexError("deque index out of range");
+    }
+
+    return v_[*idx_opt];
+  }
+
+  /// @brief Returns the number of elements in the deque.
+  /// @code len(deque)
+  __types::Int Len() const { return v_.size(); }
+
+  /// @brief Returns the maximum length of the deque, or std::nullopt if it
+  /// is unbounded.
+  /// @code deque.maxlen
+  std::optional<__types::Int> MaxLen() const {
+    if (maxlen_ == kUnbounded) {
+      return std::nullopt;
+    }
+
+    return static_cast<__types::Int>(maxlen_);
+  }
+
+  /// @brief Returns the smallest element in the deque. If the deque is empty,
+  /// throws ValueError.
+  /// @code min(deque)
+  value_type Min() const {
+    if (v_.empty()) {
+      throw ValueError("Min() arg is an empty sequence");
+    }
+
+    if constexpr (__concepts::Object<element>) {
+      return *std::min_element(
+          v_.cbegin(), v_.cend(),
+          [](const auto& a, const auto& b) { return operators::Lt(*a, *b); });
+    } else {
+      return *std::min_element(v_.cbegin(), v_.cend());
+    }
+  }
+
+  /// @brief Returns the biggest element in the deque. If the deque is empty,
+  /// throws ValueError.
+  /// @code max(deque)
+  value_type Max() const {
+    if (v_.empty()) {
+      throw ValueError("Max() arg is an empty sequence");
+    }
+
+    if constexpr (__concepts::Object<element>) {
+      return *std::max_element(
+          v_.cbegin(), v_.cend(),
+          [](const auto& a, const auto& b) { return operators::Lt(*a, *b); });
+    } else {
+      return *std::max_element(v_.cbegin(), v_.cend());
+    }
+  }
+
+  /// @brief Returns the number of times @p elem is present in the deque.
+  /// Vectorized for Int and Float elements.
+  /// @code deque.count(x)
+  __types::Int Count(__memory::ReadOnly<element> elem) const {
+    if constexpr (kVectorizedSearch) {
+      std::size_t res = 0;
+
+      for (std::size_t i = 0; i < v_.size();) {
+        const auto segment = v_.Segment(i, v_.size());
+
+        res += __utils::CountEqual(segment, elem);
+        i += segment.size();
+      }
+
+      return static_cast<__types::Int>(res);
+    } else {
+      return std::count_if(v_.cbegin(), v_.cend(),
+                           [elem](__memory::ReadOnly<element> val) {
+                             return operators::Eq(val, elem);
+                           });
+    }
+  }
+
+  /// @brief Returns the index of @p elem in the deque, starting the search
+  /// from @p start. If @p elem does not exist in the deque, then throws
+  /// ValueError. If @p start is negative, it is clamped to 0.
+  /// @code deque.index(x, (i))
+  __types::Int Index(__memory::ReadOnly<element> elem,
+                     __types::Int start = 0) const {
+    return Index(elem, start, v_.size());
+  }
+
+  /// @brief Returns the index of @p elem in the deque, starting the search
+  /// from @p start and ending at @p end. If @p elem does not exist in the
+  /// deque, then throws ValueError. If @p start or @p end are negative, they
+  /// are clamped to 0. If @p end is greater than the length of the deque, it
+  /// is clamped to it.
+  /// @code deque.index(x, i, j)
+  __types::Int Index(__memory::ReadOnly<element> elem,
+                     __types::Int start,
+                     __types::Int end) const {
+    const auto size_t_start = ClampIndex(start);
+    const auto size_t_end = ClampIndex(end);
+
+    if (size_t_start < size_t_end) {
+      const auto idx = Find(elem, size_t_start, size_t_end);
+
+      if (idx != size_t_end) {
+        return static_cast<__types::Int>(idx);
+      }
+    }
+
+    throw ValueError("{elem} is not in deque");
+  }
+
+  /// @brief Inserts @p elem so that it becomes the element at @p idx, shifting
+  /// the elements on the shorter side of @p idx. @p idx is clamped to the
+  /// length of the deque. If the deque is full, throws IndexError.
+  /// @code deque.insert(idx, x)
+  void Insert(__types::Int idx, value_type elem) {
+    if (v_.size() >= maxlen_) {
+      throw IndexError("deque already at its maximum size");
+    }
+
+    v_.insert(NormalizeOrClampIndex(idx), std::move(elem));
+  }
+
+  /// @brief Removes the last element of the deque and returns it. If the
+  /// deque is empty, throws IndexError. O(1).
+  /// @code deque.pop()
+  value_type Pop() {
+    if (v_.empty()) {
+      throw IndexError("pop from an empty deque");
+    }
+
+    auto elem = std::move(v_.back());
+    v_.pop_back();
+
+    return elem;
+  }
+
+  /// @brief Removes the first element of the deque and returns it. If the
+  /// deque is empty, throws IndexError. O(1).
+  /// @code deque.popleft()
+  value_type PopLeft() {
+    if (v_.empty()) {
+      throw IndexError("pop from an empty deque");
+    }
+
+    auto elem = std::move(v_.front());
+    v_.pop_front();
+
+    return elem;
+  }
+
+  /// @brief Removes the first occurrence of @p elem from the deque, shifting
+  /// the elements on the shorter side of it. If @p elem does not occur in the
+  /// deque, throws ValueError.
+  /// @code deque.remove(elem)
+  void Remove(__memory::ReadOnly<element> elem) {
+    const auto idx = Find(elem, 0, v_.size());
+
+    if (idx == v_.size()) {
+      throw ValueError("Deque.Remove(x): x not in deque");
+    }
+
+    v_.erase(idx);
+  }
+
+  /// @brief Reverses the deque in place.
+  /// @code deque.reverse()
+  void Reverse() { std::reverse(v_.begin(), v_.end()); }
+
+  /// @brief Rotates the deque @p n steps to the right, i.e. moves its last
+  /// @p n elements to its start, or its first -@p n elements to its end if
+  /// @p n is negative. O(min(|n|, len - |n|)) after taking @p n modulo the
+  /// length.
+  /// @code deque.rotate(n)
+  void Rotate(__types::Int n = 1) {
+    const auto size = static_cast<__types::Int>(v_.size());
+
+    if (size <= 1) {
+      return;
+    }
+
+    // Python modulo, so that steps to the left become steps to the right
+    n = ((n % size) + size) % size;
+
+    if (n <= size / 2) {
+      for (; n > 0; --n) {
+        v_.emplace_front(std::move(v_.back()));
+        v_.pop_back();
+      }
+    } else {
+      for (n = size - n; n > 0; --n) {
+        v_.emplace_back(std::move(v_.front()));
+        v_.pop_front();
+      }
+    }
+  }
+
+  /// @brief Returns an iterator to this deque.
+  /// @code deque.__iter__()
+  __memory::handle_t<Iterator<element>> Iter() {
+    return details::DequeIterator<element>::Init(v_.cbegin(), v_.cend());
+  }
+
+  /// @brief Returns the concrete iterator to this deque by value, which
+  /// ForEach() uses instead of Iter() so that loops can be inlined.
+  /// @note Mamba-specific
+  details::DequeIterator<element> StaticIter() const {
+    return {v_.cbegin(), v_.cend()};
+  }
+
+  /// @brief Native support for C++ for..in loops.
+  iterator begin() { return v_.begin(); }
+  iterator end() { return v_.end(); }
+  const_iterator begin() const { return v_.cbegin(); }
+  const_iterator end() const { return v_.cend(); }
+  const_iterator cbegin() const { return v_.cbegin(); }
+  const_iterator cend() const { return v_.cend(); }
+
+  /// @code bool(deque)
+  __types::Bool AsBool() const { return !v_.empty(); }
+
+  /// @brief Implicit conversion to Bool (C++ bool) for conditionals.
+  /// @code if deque:
+  operator __types::Bool() const { return AsBool(); }
+
+  /// @brief Returns false all the time for all arguments so long as they are
+  /// not a deque of the same type of elements.
+  /// @code deque == other
+  template <typename U>
+  __types::Bool Eq(const U&) const {
+    return false;
+  }
+
+  /// @brief Returns true if this and @p other contain the same elements, and
+  /// false otherwise. The maximum lengths are not compared.
+  /// @code deque == other
+  template <>
+  __types::Bool Eq(const self& other) const {
+    if constexpr (__concepts::Object<element>) {
+      return std::equal(
+          v_.cbegin(), v_.cend(), other.v_.cbegin(), other.v_.cend(),
+          [](const auto& a, const auto& b) { return operators::Eq(*a, *b); });
+    } else {
+      return std::equal(v_.cbegin(), v_.cend(), other.v_.cbegin(),
+                        other.v_.cend());
+    }
+  }
+
+  template <>
+  __types::Bool Eq(const handle& other) const {
+    return Eq(*other);
+  }
+
+  /// @brief Native support for C++ == and != operators.
+  template <typename U>
+  bool operator==(const U& other) const {
+    return Eq(other);
+  }
+
+  template <>
+  bool operator==(const handle& other) const {
+    return operator==(*other);
+  }
+
+  template <typename U>
+  bool operator!=(const U& other) const {
+    return !Eq(other);
+  }
+
+  template <>
+  bool operator!=(const handle& other) const {
+    return operator!=(*other);
+  }
+
+  /// @brief Returns the string representation of the deque.
+  /// @code str(deque)
+  __types::Str AsStr() const {
+    std::ostringstream oss;
+
+    oss << "deque([";
+
+    for (std::size_t i = 0; i < v_.size(); ++i) {
+      oss << (i == 0 ? "" : ", ") << builtins::AsStr(v_[i]);
+    }
+
+    oss << "]";
+
+    if (maxlen_ != kUnbounded) {
+      oss << ", maxlen=" << maxlen_;
+    }
+
+    oss << ")";
+
+    return oss.str();
+  }
+
+  /// @brief Returns the representation of the deque.
+  /// @code repr(deque)
+  __types::Str Repr() const {
+    std::ostringstream oss;
+
+    oss << "deque([";
+
+    for (std::size_t i = 0; i < v_.size(); ++i) {
+      oss << (i == 0 ? "" : ", ") << builtins::Repr(v_[i]);
+    }
+
+    oss << "]";
+
+    if (maxlen_ != kUnbounded) {
+      oss << ", maxlen=" << maxlen_;
+    }
+
+    oss << ")";
+
+    return oss.str();
+  }
+
+ private:
+  // Whether Contains(), Count(), Index() and Remove() go through the
+  // vectorized kernels of simd.hpp, a block at a time, rather than one
+  // element at a time
+  static constexpr bool kVectorizedSearch = __utils::SimdElement<value_type>;
+
+  static constexpr auto kUnbounded = std::numeric_limits<std::size_t>::max();
+
+  static std::size_t CheckMaxLen(std::optional<__types::Int> maxlen) {
+    if (!maxlen) {
+      return kUnbounded;
+    }
+
+    if (*maxlen < 0) {
+      throw ValueError("maxlen must be non-negative");
+    }
+
+    return static_cast<std::size_t>(*maxlen);
+  }
+
+  // Returns the index of the first element equal to @p elem in
+  // [@p first, @p last), or @p last if there is none
+  std::size_t Find(__memory::ReadOnly<element> elem,
+                   std::size_t first,
+                   std::size_t last) const {
+    if constexpr (kVectorizedSearch) {
+      while (first < last) {
+        const auto segment = v_.Segment(first, last);
+        const auto idx = __utils::FindEqual(segment, elem);
+
+        if (idx != segment.size()) {
+          return first + idx;
+        }
+
+        first += segment.size();
+      }
+
+      return last;
+    } else {
+      const auto it = std::find_if(
+          v_.cbegin() + first, v_.cbegin() + last,
+          [&elem](__memory::ReadOnly<element> val) {
+            return operators::Eq(val, elem);
+          });
+
+      return it - v_.cbegin();
+    }
+  }
+
+  std::size_t ClampIndex(__types::Int idx) const {
+    if (idx < 0) {
+      return 0;
+    } else if (idx > static_cast<__types::Int>(v_.size())) {
+      return v_.size();
+    }
+
+    return static_cast<std::size_t>(idx);
+  }
+
+  std::optional<std::size_t> TryGetNormalizedIndex(__types::Int idx) const {
+    const auto size = static_cast<__types::Int>(v_.size());
+
+    if (idx < 0) {
+      idx += size;
+    }
+
+    if (idx < 0 || idx >= size) {
+      return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(idx);
+  }
+
+  std::size_t NormalizeOrClampIndex(__types::Int idx) const {
+    return TryGetNormalizedIndex(idx).value_or(ClampIndex(idx));
+  }
+
+  storage v_;
+  // Maximum length, so that appends check it with a single comparison
+  std::size_t maxlen_ = kUnbounded;
+};
+
+namespace details {
+
+template <__concepts::Entity T>
+class DequeIterator final
+    : public Iterator<T>,
+      public __memory::EnableHandleFromThis<DequeIterator<T>> {
+ public:
+  /// @brief Mamba-specific
+  using element = T;
+
+  using value_type = __memory::managed_t<element>;
+  using iterator = Deque<element>::const_iterator;
+
+  /// @brief Mamba-specific
+  using self = DequeIterator<element>;
+  using handle = __memory::handle_t<self>;
+
+  DequeIterator(iterator it, iterator end)
+      : it_(std::move(it)), end_(std::move(end)) {}
+
+  ~DequeIterator() override = default;
+
+  /// @brief Generic constructor forwarding arguments to actual constructor
+  /// methods. Iterators come from the pool of the calling thread.
+  /// @code DequeIterator.__init__()
+  /// @see pool.hpp
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
+  }
+
+  __memory::handle_t<Iterator<element>> Iter() override {
+    return this->HandleFromThis();
+  }
+
+  std::optional<value_type> TryNext() override {
+    if (it_ == end_) {
+      return std::nullopt;
+    }
+
+    return *it_++;
+  }
+
+  std::size_t NextBatch(std::span<value_type> out) override {
+    return details::CopyBatch(it_, end_, out);
+  }
+
+  __types::Int LengthHint() const override {
+    return details::RemainingLength(it_, end_);
+  }
+
+  __types::Str Repr() const override { return "DequeIterator"; }
+
+  bool operator==(const self& other) const {
+    return it_ == other.it_ && end_ == other.end_;
+  }
+
+  bool operator!=(const self& other) const { return !(*this == other); }
+
+ private:
+  iterator it_;
+  iterator end_;
+};
+
+}  // namespace details
+
+}  // namespace mamba::builtins
@@ -16,7 +16,7 @@
 namespace mamba::builtins {
 
 template <__concepts::Entity K, __concepts::Entity V>
-class Dict : public std::enable_shared_from_this<Dict<K, V>> {
+class Dict : public __memory::EnableHandleFromThis<Dict<K, V>> {
  public:
   /// @note Mamba-specific
   using key_element = K;
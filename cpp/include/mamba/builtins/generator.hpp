@@ -0,0 +1,160 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "mamba/__concepts/entity.hpp"
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
+#include "mamba/builtins/__types/str.hpp"
+#include "mamba/builtins/iteration.hpp"
+
+namespace mamba::builtins {
+
+/// @brief Iterator over the values yielded by a coroutine, i.e. a Python
+/// generator function. A generator function is written as a coroutine
+/// returning Generator<T>::handle that co_yields its values:
+///
+///   Generator<Int>::handle Count(Int n) {
+///     for (Int i = 0; i < n; ++i) {
+///       co_yield i;
+///     }
+///   }
+///
+/// Like in Python, calling it runs nothing until the first value is
+/// requested, and each value is computed when it is requested, so that
+/// generators can stream inputs that do not fit in memory.
+/// @note Coroutine frames come from the pool of the calling thread, like
+/// iterators, and may be freed on any thread.
+/// @see pool.hpp
+template <__concepts::Entity T>
+class Generator final : public Iterator<T>,
+                        public __memory::EnableHandleFromThis<Generator<T>> {
+ public:
+  /// @brief Mamba-specific
+  using element = T;
+
+  using value_type = __memory::managed_t<element>;
+
+  /// @brief Mamba-specific
+  using self = Generator<element>;
+  using handle = __memory::handle_t<self>;
+
+  class promise_type;
+  using coroutine = std::coroutine_handle<promise_type>;
+
+  explicit Generator(coroutine frame) : coroutine_(frame) {}
+
+  Generator(const self&) = delete;
+  self& operator=(const self&) = delete;
+
+  ~Generator() override {
+    if (coroutine_) {
+      coroutine_.destroy();
+    }
+  }
+
+  /// @brief Generic constructor forwarding arguments to actual constructor
+  /// methods. Generators come from the pool of the calling thread.
+  /// @code Generator.__init__()
+  /// @see pool.hpp
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
+  }
+
+  __memory::handle_t<Iterator<element>> Iter() override {
+    return this->HandleFromThis();
+  }
+
+  /// @brief Resumes the coroutine until it yields its next value, and returns
+  /// that value, or std::nullopt once the coroutine has returned. Exceptions
+  /// thrown by the coroutine are rethrown here.
+  std::optional<value_type> TryNext() override {
+    if (coroutine_.done()) {
+      return std::nullopt;
+    }
+
+    coroutine_.resume();
+
+    auto& promise = coroutine_.promise();
+
+    if (coroutine_.done()) {
+      if (promise.exception_) {
+        std::rethrow_exception(std::exchange(promise.exception_, nullptr));
+      }
+
+      return std::nullopt;
+    }
+
+    return std::move(promise.value_);
+  }
+
+  __types::Str Repr() const override { return "Generator"; }
+
+  class promise_type {
+   public:
+    // Coroutine frames are small and short-lived, like iterators, so they are
+    // recycled through the pool instead of the global heap
+    static void* operator new(std::size_t size) {
+      return __memory::AllocatePooled(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) {
+      __memory::DeallocatePooled(ptr, size);
+    }
+
+    handle get_return_object() {
+      return Init(coroutine::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+
+    std::suspend_always yield_value(value_type value) {
+      value_ = std::move(value);
+
+      return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() { exception_ = std::current_exception(); }
+
+   private:
+    friend class Generator;
+
+    std::optional<value_type> value_;
+    std::exception_ptr exception_;
+  };
+
+ private:
+  coroutine coroutine_;
+};
+
+/// @brief Native support for C++ range-based for loops over a handle, e.g.
+/// for (auto i : Count(3)), which keeps the generator alive for the loop.
+template <__concepts::Entity T>
+auto begin(const __memory::handle_t<Generator<T>>& generator) {
+  return generator->begin();
+}
+
+template <__concepts::Entity T>
+auto end(const __memory::handle_t<Generator<T>>& generator) {
+  return generator->end();
+}
+
+}  // namespace mamba::builtins
+
+/// @brief Lets coroutines return Generator<T>::handle, which is not a class
+/// with a promise_type of its own.
+template <typename T, typename... Args>
+struct std::coroutine_traits<
+    mamba::builtins::__memory::handle_t<mamba::builtins::Generator<T>>,
+    Args...> {
+  using promise_type = typename mamba::builtins::Generator<T>::promise_type;
+};
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/read_only.hpp"
+#include "mamba/__utils/heap.hpp"
+#include "mamba/builtins/__types/int.hpp"
+#include "mamba/builtins/comparators.hpp"
+#include "mamba/builtins/error.hpp"
+#include "mamba/builtins/iteration.hpp"
+#include "mamba/builtins/list.hpp"
+
+namespace mamba::builtins {
+namespace details {
+
+// NLargest() and NSmallest() keep the k first elements seen so far in a heap,
+// so that they take O(k) memory however long the iterable is, e.g. for
+// generators. Iterables whose length hint is below k * kSelectRatio are
+// buffered instead, and their k first elements selected in O(n) then sorted:
+// each element that enters the heap costs O(log k), which only pays off while
+// k is small next to n.
+inline constexpr std::size_t kSelectRatio = 64;
+
+template <typename T>
+struct HeapLess {
+  bool operator()(const T& a, const T& b) const { return operators::Lt(a, b); }
+};
+
+// Strict weak order on the keys of NLargest() and NSmallest(), which the
+// standard selection algorithms require. NaN is ordered after all other
+// floats, rather than being incomparable to them.
+template <typename K>
+bool KeyLess(const K& a, const K& b) {
+  if constexpr (std::floating_point<K>) {
+    return a < b || (std::isnan(b) && !std::isnan(a));
+  } else {
+    return operators::Lt(a, b);
+  }
+}
+
+/// @brief Returns whether key @p a comes before key @p b in the results of
+/// NLargest() if @tparam Largest, or of NSmallest() otherwise.
+template <bool Largest, typename K>
+bool KeyFirst(const K& a, const K& b) {
+  return Largest ? KeyLess(b, a) : KeyLess(a, b);
+}
+
+struct NoKey {};
+
+template <typename K, typename T>
+struct KeyType {
+  using type = std::decay_t<std::invoke_result_t<const K&, const T&>>;
+};
+
+// Without a key, the elements are their own keys
+template <typename T>
+struct KeyType<NoKey, T> {
+  using type = T;
+};
+
+/// @brief Element of NLargest() or NSmallest() with its key and its position
+/// in the iterable. Elements that are their own keys have no value.
+template <typename Key, typename Value>
+struct Decorated {
+  Key key;
+  std::size_t idx;
+  [[no_unique_address]] Value value;
+};
+
+/// @brief Orders decorated elements as NLargest() returns them if
+/// @tparam Largest, and as NSmallest() does otherwise. Equal keys stay in the
+/// order of their elements, as with a stable sort.
+template <bool Largest>
+struct DecoratedLess {
+  template <typename D>
+  bool operator()(const D& a, const D& b) const {
+    if (KeyFirst<Largest>(a.key, b.key)) {
+      return true;
+    }
+
+    if (KeyFirst<Largest>(b.key, a.key)) {
+      return false;
+    }
+
+    return a.idx < b.idx;
+  }
+};
+
+/// @brief Returns the @p n largest elements of @p iterable if
+/// @tparam Largest, or the @p n smallest otherwise, as compared by @p key
+/// unless it is NoKey.
+template <bool Largest, typename It, typename K>
+__memory::handle_t<List<typename It::element>> NFirst(__types::Int n,
+                                                      It& iterable,
+                                                      const K& key) {
+  using element = It::element;
+  using value_type = __memory::managed_t<element>;
+
+  using key_type = KeyType<K, value_type>::type;
+
+  constexpr bool kKeyed = !std::same_as<K, NoKey>;
+
+  using decorated_type =
+      Decorated<key_type, std::conditional_t<kKeyed, value_type, NoKey>>;
+
+  auto res = List<element>::Init();
+
+  if (n <= 0) {
+    return res;
+  }
+
+  const DecoratedLess<Largest> lt;
+
+  const auto k = static_cast<std::size_t>(n);
+  const auto len = static_cast<std::size_t>(LengthHint(iterable));
+
+  std::vector<decorated_type> first;
+  std::size_t idx = 0;
+
+  const auto decorate = [&](value_type elem) -> decorated_type {
+    if constexpr (kKeyed) {
+      auto elem_key = key(std::as_const(elem));
+      return {std::move(elem_key), idx++, std::move(elem)};
+    } else {
+      return {std::move(elem), idx++, {}};
+    }
+  };
+
+  if (len > 0 && k > len / kSelectRatio) {
+    first.reserve(len);
+
+    ForEach(iterable, [&](value_type elem) {
+      first.push_back(decorate(std::move(elem)));
+    });
+
+    const auto middle =
+        first.begin() + static_cast<std::ptrdiff_t>(std::min(k, first.size()));
+
+    std::nth_element(first.begin(), middle, first.end(), lt);
+    first.erase(middle, first.end());
+  } else {
+    // The root of the heap is the last of the k first elements seen so far,
+    // which the next element replaces if it comes before it
+    const auto last = [&lt](const decorated_type& a, const decorated_type& b) {
+      return lt(b, a);
+    };
+
+    first.reserve(std::min(k, len));
+
+    ForEach(iterable, [&](value_type elem) {
+      auto decorated = decorate(std::move(elem));
+
+      if (first.size() < k) {
+        first.push_back(std::move(decorated));
+
+        if (first.size() == k) {
+          __utils::MakeHeap<2>(first.begin(),
+                               static_cast<std::ptrdiff_t>(k), last);
+        }
+      } else if (lt(decorated, first.front())) {
+        first.front() = std::move(decorated);
+        __utils::SiftTowardsLeaf<2>(first.begin(),
+                                    static_cast<std::ptrdiff_t>(k), 0, last);
+      }
+    });
+  }
+
+  std::sort(first.begin(), first.end(), lt);
+
+  for (auto& elem : first) {
+    if constexpr (kKeyed) {
+      res->Append(std::move(elem.value));
+    } else {
+      res->Append(std::move(elem.key));
+    }
+  }
+
+  return res;
+}
+
+}  // namespace details
+
+/// @brief Pushes @p item onto @p heap, keeping it a heap. O(log n).
+/// @tparam Arity Number of children per node. Python's heaps are binary;
+/// 4-ary heaps are shallower, and the children that each step compares share
+/// a cache line, which makes large heaps faster. All operations on a heap
+/// must use the same arity.
+/// @code heapq.heappush(heap, item)
+template <std::size_t Arity = 2, typename T, typename Storage>
+void HeapPush(List<T, Storage>& heap, __memory::ReadOnly<T> item) {
+  using value_type = List<T, Storage>::value_type;
+
+  heap.Append(item);
+  __utils::SiftTowardsRoot<Arity>(heap.begin(), 0, heap.Len() - 1,
+                                  details::HeapLess<value_type>{});
+}
+
+/// @brief Pops and returns the smallest item of @p heap, keeping it a heap.
+/// If @p heap is empty, throws IndexError. O(log n).
+/// @code heapq.heappop(heap)
+template <std::size_t Arity = 2, typename T, typename Storage>
+List<T, Storage>::value_type HeapPop(List<T, Storage>& heap) {
+  using value_type = List<T, Storage>::value_type;
+
+  if (heap.Len() == 0) {
+    throw IndexError("index out of range");
+  }
+
+  auto last = heap.Pop();
+
+  if (heap.Len() == 0) {
+    return last;
+  }
+
+  const auto first = heap.begin();
+  value_type res = std::move(first[0]);
+
+  first[0] = std::move(last);
+  __utils::SiftTowardsLeaf<Arity>(first, heap.Len(), 0,
+                                  details::HeapLess<value_type>{});
+
+  return res;
+}
+
+/// @brief Pops and returns the smallest item of @p heap, then pushes
+/// @p item, in a single sift. If @p heap is empty, throws IndexError.
+/// @code heapq.heapreplace(heap, item)
+template <std::size_t Arity = 2, typename T, typename Storage>
+List<T, Storage>::value_type HeapReplace(List<T, Storage>& heap,
+                                         __memory::ReadOnly<T> item) {
+  using value_type = List<T, Storage>::value_type;
+
+  if (heap.Len() == 0) {
+    throw IndexError("index out of range");
+  }
+
+  const auto first = heap.begin();
+  value_type res = std::move(first[0]);
+
+  first[0] = item;
+  __utils::SiftTowardsLeaf<Arity>(first, heap.Len(), 0,
+                                  details::HeapLess<value_type>{});
+
+  return res;
+}
+
+/// @brief Pushes @p item onto @p heap, then pops and returns its smallest
+/// item, in at most a single sift. Faster than HeapPush() then HeapPop().
+/// @code heapq.heappushpop(heap, item)
+template <std::size_t Arity = 2, typename T, typename Storage>
+List<T, Storage>::value_type HeapPushPop(List<T, Storage>& heap,
+                                         __memory::ReadOnly<T> item) {
+  using value_type = List<T, Storage>::value_type;
+
+  const details::HeapLess<value_type> lt;
+
+  // @p item would be popped right away unless the heap has a smaller one
+  if (heap.Len() == 0 || !lt(std::as_const(heap)[0], item)) {
+    return item;
+  }
+
+  return HeapReplace<Arity>(heap, item);
+}
+
+/// @brief Rearranges @p list into a heap, in place, in O(n).
+/// @code heapq.heapify(list)
+template <std::size_t Arity = 2, typename T, typename Storage>
+void Heapify(List<T, Storage>& list) {
+  using value_type = List<T, Storage>::value_type;
+
+  __utils::MakeHeap<Arity>(list.begin(), list.Len(),
+                           details::HeapLess<value_type>{});
+}
+
+/// @brief Returns a list of the @p n largest elements of @p iterable, from
+/// largest to smallest, like sorted(iterable, reverse=True)[:n]. The
+/// elements go through a heap of the @p n largest ones seen so far, in
+/// O(len log n) time and O(n) memory, unless @p iterable is known to be short
+/// next to @p n: then all of them are buffered, and the @p n largest selected
+/// in O(len) before being sorted.
+/// @code heapq.nlargest(n, iterable)
+template <__concepts::Iterable It>
+__memory::handle_t<List<typename It::element>> NLargest(__types::Int n,
+                                                        It& iterable) {
+  return details::NFirst<true>(n, iterable, details::NoKey{});
+}
+
+/// @brief Like NLargest(), but compares the results of calling @p key on the
+/// elements rather than the elements themselves. @p key is called once per
+/// element.
+/// @code heapq.nlargest(n, iterable, key)
+template <__concepts::Iterable It, typename K>
+  requires details::ListSortKey<K, typename It::element>
+__memory::handle_t<List<typename It::element>> NLargest(__types::Int n,
+                                                        It& iterable,
+                                                        const K& key) {
+  return details::NFirst<true>(n, iterable, key);
+}
+
+/// @brief Returns a list of the @p n smallest elements of @p iterable, from
+/// smallest to largest, like sorted(iterable)[:n]. See NLargest().
+/// @code heapq.nsmallest(n, iterable)
+template <__concepts::Iterable It>
+__memory::handle_t<List<typename It::element>> NSmallest(__types::Int n,
+                                                         It& iterable) {
+  return details::NFirst<false>(n, iterable, details::NoKey{});
+}
+
+/// @brief Like NSmallest(), but compares the results of calling @p key on
+/// the elements rather than the elements themselves. @p key is called once
+/// per element.
+/// @code heapq.nsmallest(n, iterable, key)
+template <__concepts::Iterable It, typename K>
+  requires details::ListSortKey<K, typename It::element>
+__memory::handle_t<List<typename It::element>> NSmallest(__types::Int n,
+                                                         It& iterable,
+                                                         const K& key) {
+  return details::NFirst<false>(n, iterable, key);
+}
+
+template <std::size_t Arity = 2, typename T, typename Storage>
+void HeapPush(const __memory::handle_t<List<T, Storage>>& heap,
+              __memory::ReadOnly<T> item) {
+  HeapPush<Arity>(*heap, item);
+}
+
+template <std::size_t Arity = 2, typename T, typename Storage>
+List<T, Storage>::value_type HeapPop(
+    const __memory::handle_t<List<T, Storage>>& heap) {
+  return HeapPop<Arity>(*heap);
+}
+
+template <std::size_t Arity = 2, typename T, typename Storage>
+List<T, Storage>::value_type HeapReplace(
+    const __memory::handle_t<List<T, Storage>>& heap,
+    __memory::ReadOnly<T> item) {
+  return HeapReplace<Arity>(*heap, item);
+}
+
+template <std::size_t Arity = 2, typename T, typename Storage>
+List<T, Storage>::value_type HeapPushPop(
+    const __memory::handle_t<List<T, Storage>>& heap,
+    __memory::ReadOnly<T> item) {
+  return HeapPushPop<Arity>(*heap, item);
+}
+
+template <std::size_t Arity = 2, typename T, typename Storage>
+void Heapify(const __memory::handle_t<List<T, Storage>>& list) {
+  Heapify<Arity>(*list);
+}
+
+template <__concepts::Iterable It, typename... Args>
+__memory::handle_t<List<typename It::element>> NLargest(
+    __types::Int n,
+    const __memory::handle_t<It>& iterable,
+    Args&&... args) {
+  return NLargest(n, *iterable, std::forward<Args>(args)...);
+}
+
+template <__concepts::Iterable It, typename... Args>
+__memory::handle_t<List<typename It::element>> NSmallest(
+    __types::Int n,
+    const __memory::handle_t<It>& iterable,
+    Args&&... args) {
+  return NSmallest(n, *iterable, std::forward<Args>(args)...);
+}
+
+}  // namespace mamba::builtins
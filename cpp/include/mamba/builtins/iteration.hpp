@@ -1,11 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 #include "mamba/__concepts/entity.hpp"
 #include "mamba/__memory/managed.hpp"
+#include "mamba/builtins/__types/int.hpp"
 #include "mamba/builtins/__types/object.hpp"
 #include "mamba/builtins/error.hpp"
 
@@ -29,14 +37,63 @@ class Iterator : public builtins::__types::Object {
   using iterator = details::IteratorWrapper<element>;
   using value_type = __memory::managed_t<element>;
 
+  /// @brief Number of elements that consumers of type-erased iterators fetch
+  /// per NextBatch() call, which amortizes one virtual call over all of them.
+  /// @note Mamba-specific
+  static constexpr std::size_t kBatchSize = 128;
+
   virtual ~Iterator() = default;
 
   virtual __memory::handle_t<Iterator<element>> Iter() = 0;
 
   /// @brief Returns the next value from the iterator, starting from the first
-  /// value.
+  /// value, or std::nullopt once the iterator is exhausted. Prefer this to
+  /// Next() in loops, since ending a loop on StopIteration costs a throw.
+  /// @note Mamba-specific
+  virtual std::optional<value_type> TryNext() = 0;
+
+  /// @brief Writes the next values from the iterator to @p out, up to its
+  /// size, and returns how many were written. Returns less than the size of
+  /// @p out only once the iterator is exhausted. The default implementation
+  /// calls TryNext() per value; iterators over contiguous storage override it
+  /// with a bulk copy.
+  /// @note Mamba-specific
+  virtual std::size_t NextBatch(std::span<value_type> out) {
+    std::size_t n = 0;
+
+    for (; n < out.size(); ++n) {
+      auto elem = TryNext();
+
+      if (!elem) {
+        break;
+      }
+
+      out[n] = *std::move(elem);
+    }
+
+    return n;
+  }
+
+  /// @brief Returns an estimate of the number of values left in the iterator,
+  /// or 0 if it is unknown. Containers consuming the iterator use it to
+  /// allocate once up front, never for correctness, so it may be off. The
+  /// default implementation returns 0; iterators over containers override it
+  /// with the exact count.
+  /// @code iterator.__length_hint__()
+  virtual __types::Int LengthHint() const { return 0; }
+
+  /// @brief Returns the next value from the iterator, starting from the first
+  /// value. If the iterator is exhausted, throws StopIteration.
   /// @code next(iterator)
-  virtual value_type Next() = 0;
+  value_type Next() {
+    auto res = TryNext();
+
+    if (!res) {
+      throw StopIteration("end of iterator");
+    }
+
+    return *std::move(res);
+  }
 
   /// @brief Returns false all the time for all arguments by default.
   /// @code iterator == other
@@ -79,9 +136,10 @@ class Iterator : public builtins::__types::Object {
     return operator!=(*other);
   }
 
-  // Native C++ iteration support
-  iterator begin() const { return iterator(*this); }
-  iterator end() const { return iterator(*this, true); }
+  /// @brief Native support for C++ range-based for loops and std::ranges,
+  /// e.g. std::ranges::copy(iterator, out), which consume this iterator.
+  iterator begin() { return iterator(*this); }
+  std::default_sentinel_t end() const { return {}; }
 };
 
 namespace __concepts {
@@ -94,8 +152,80 @@ concept TypedIterable = requires(T* iterable) {
 template <typename T>
 concept Iterable = TypedIterable<T, typename T::element>;
 
+/// @brief Concrete iterator whose TryNext() can be called without going
+/// through the vtable of Iterator<T>, so that loops over it can be inlined.
+template <typename T>
+concept StaticIterator = std::is_final_v<T> && requires(T& it) {
+  typename T::value_type;
+  { it.TryNext() } -> std::same_as<std::optional<typename T::value_type>>;
+};
+
+/// @brief Iterable that can return its concrete iterator by value from
+/// StaticIter(), in addition to a type-erased one from Iter().
+template <typename T>
+concept StaticIterable = requires(T& iterable) {
+  { iterable.StaticIter() } -> StaticIterator;
+};
+
+template <typename T>
+concept Sized = requires(const T& obj) {
+  { obj.Len() } -> std::convertible_to<__types::Int>;
+};
+
+/// @brief Iterator that can estimate how many values it has left.
+template <typename T>
+concept LengthHinted = requires(const T& it) {
+  { it.LengthHint() } -> std::convertible_to<__types::Int>;
+};
+
 }  // namespace __concepts
 
+/// @brief Returns the length of @p obj if it has one, an estimate of the
+/// number of values left in it if it is an iterator that provides one, and
+/// @p default_hint otherwise.
+/// @code operator.length_hint(obj, default_hint)
+template <typename T>
+__types::Int LengthHint(const T& obj, __types::Int default_hint = 0) {
+  if constexpr (__concepts::Sized<T>) {
+    return obj.Len();
+  } else if constexpr (__concepts::LengthHinted<T>) {
+    return obj.LengthHint();
+  } else {
+    return default_hint;
+  }
+}
+
+template <typename T>
+__types::Int LengthHint(const __memory::handle_t<T>& obj,
+                        __types::Int default_hint = 0) {
+  return LengthHint(*obj, default_hint);
+}
+
+/// @note Mamba-specific
+template <__concepts::Entity T>
+std::optional<__memory::managed_t<T>> TryNext(Iterator<T>& it) {
+  return it.TryNext();
+}
+
+template <__concepts::Entity T>
+std::optional<__memory::managed_t<T>> TryNext(
+    const __memory::handle_t<Iterator<T>>& it) {
+  return TryNext(*it);
+}
+
+/// @note Mamba-specific
+template <__concepts::Entity T>
+std::size_t NextBatch(Iterator<T>& it,
+                      std::span<__memory::managed_t<T>> out) {
+  return it.NextBatch(out);
+}
+
+template <__concepts::Entity T>
+std::size_t NextBatch(const __memory::handle_t<Iterator<T>>& it,
+                      std::span<__memory::managed_t<T>> out) {
+  return NextBatch(*it, out);
+}
+
 template <__concepts::Entity T>
 __memory::managed_t<T> Next(Iterator<T>& it) {
   return it.Next();
@@ -117,59 +247,171 @@ __memory::handle_t<Iterator<typename T::element>> Iter(
   return Iter(*it);
 }
 
+/// @brief Calls @p f with each element of @p iterable. Static iterators are
+/// advanced in place, iterables with a concrete iterator are iterated through
+/// it directly, and anything else through the virtual Iterator<T> returned by
+/// Iter(), in batches of Iterator<T>::kBatchSize elements.
+/// @note Mamba-specific
+template <typename T, typename F>
+  requires __concepts::StaticIterator<std::remove_cvref_t<T>> ||
+           __concepts::StaticIterable<std::remove_cvref_t<T>> ||
+           __concepts::Iterable<std::remove_cvref_t<T>>
+void ForEach(T&& iterable, F&& f) {
+  using type = std::remove_cvref_t<T>;
+
+  if constexpr (__concepts::StaticIterator<type>) {
+    while (auto elem = iterable.TryNext()) {
+      f(*std::move(elem));
+    }
+  } else if constexpr (__concepts::StaticIterable<type>) {
+    auto it = iterable.StaticIter();
+
+    while (auto elem = it.TryNext()) {
+      f(*std::move(elem));
+    }
+  } else {
+    using iterator = Iterator<typename type::element>;
+
+    auto it = iterable.Iter();
+    std::array<typename iterator::value_type, iterator::kBatchSize> batch;
+
+    for (;;) {
+      const auto n = it->NextBatch(batch);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        f(std::move(batch[i]));
+      }
+
+      if (n < batch.size()) {
+        break;
+      }
+    }
+  }
+}
+
+template <typename T, typename F>
+void ForEach(const __memory::handle_t<T>& iterable, F&& f) {
+  ForEach(*iterable, std::forward<F>(f));
+}
+
+/// @brief Native support for C++ range-based for loops over a handle, e.g.
+/// for (auto elem : Iter(list)), which keeps the iterator alive for the loop.
+template <__concepts::Entity T>
+auto begin(const __memory::handle_t<Iterator<T>>& it) {
+  return it->begin();
+}
+
+template <__concepts::Entity T>
+auto end(const __memory::handle_t<Iterator<T>>& it) {
+  return it->end();
+}
+
 namespace details {
 
+/// @brief Copies elements from [@p it, @p end) to @p out, up to its size, and
+/// advances @p it past them. Returns how many were copied. Used by concrete
+/// iterators to implement Iterator<T>::NextBatch().
+template <std::input_iterator It, typename V>
+std::size_t CopyBatch(It& it, const It& end, std::span<V> out) {
+  if constexpr (std::random_access_iterator<It>) {
+    const auto n = std::min(out.size(), static_cast<std::size_t>(end - it));
+
+    std::copy_n(it, n, out.begin());
+    it += static_cast<std::iter_difference_t<It>>(n);
+
+    return n;
+  } else {
+    std::size_t n = 0;
+
+    for (; n < out.size() && it != end; ++n, ++it) {
+      out[n] = *it;
+    }
+
+    return n;
+  }
+}
+
+/// @brief Returns the number of elements in [@p it, @p end) if it can be
+/// computed in O(1), and 0 otherwise. Used by concrete iterators to implement
+/// Iterator<T>::LengthHint().
+template <std::input_iterator It>
+__types::Int RemainingLength(const It& it, const It& end) {
+  if constexpr (std::sized_sentinel_for<It, It>) {
+    return static_cast<__types::Int>(end - it);
+  } else {
+    return 0;
+  }
+}
+
+/// @brief C++ input iterator over a Mamba Iterator<T>. It caches the current
+/// element, so that dereferencing it neither calls TryNext() nor copies, and
+/// compares equal to std::default_sentinel once the iterator is exhausted.
 template <__concepts::Entity T>
 class IteratorWrapper {
  public:
   /// @note Mamba-specific
   using element = T;
   using self = IteratorWrapper<element>;
-  using iterator = __memory::handle_t<Iterator<element>>;
 
+  using iterator_concept = std::input_iterator_tag;
   using value_type = __memory::managed_t<element>;
+  using difference_type = std::ptrdiff_t;
 
-  explicit IteratorWrapper(iterator it, bool at_end = false)
-      : at_end_(at_end), it_(it) {}
+  IteratorWrapper() = default;
 
-  self& operator++() {
-    if (at_end_) {
-      return *this;
-    }
+  explicit IteratorWrapper(Iterator<element>& it)
+      : it_(&it), current_(it.TryNext()) {}
 
-    try {
-      Next(it_);
-    } catch (StopIteration) {
-      at_end_ = true;
-    }
+  const value_type& operator*() const { return *current_; }
+  const value_type* operator->() const { return &*current_; }
+
+  self& operator++() {
+    current_ = it_->TryNext();
 
     return *this;
   }
 
-  self operator++(int) {
-    auto res = *it_;
-    this->operator++();
+  void operator++(int) { this->operator++(); }
 
-    return res;
-  }
+  bool operator==(std::default_sentinel_t) const { return !current_; }
 
-  value_type operator*() { return *it_; }
+ private:
+  Iterator<element>* it_ = nullptr;
+  std::optional<value_type> current_;
+};
 
-  bool operator==(const self& other) const {
-    return at_end_ == other.at_end_ && it_ == other.it_;
-  }
+/// @brief C++ input iterator over a static iterator, like IteratorWrapper
+/// over Iterator<T>, so that static iterators such as the adaptors can be
+/// iterated with range-based for loops.
+template <typename It>
+class StaticIteratorWrapper {
+ public:
+  using self = StaticIteratorWrapper<It>;
+
+  using iterator_concept = std::input_iterator_tag;
+  using value_type = It::value_type;
+  using difference_type = std::ptrdiff_t;
+
+  StaticIteratorWrapper() = default;
 
-  bool operator!=(const self& other) const { return !(*this == other); }
+  explicit StaticIteratorWrapper(It& it) : it_(&it), current_(it.TryNext()) {}
 
-  self begin() const { return *this; }
-  self end() const {
-    auto res = *this;
-    res.at_end_ = true;
+  const value_type& operator*() const { return *current_; }
+  const value_type* operator->() const { return &*current_; }
+
+  self& operator++() {
+    current_ = it_->TryNext();
+
+    return *this;
   }
 
+  void operator++(int) { this->operator++(); }
+
+  bool operator==(std::default_sentinel_t) const { return !current_; }
+
  private:
-  bool at_end_;
-  iterator it_;
+  It* it_ = nullptr;
+  std::optional<value_type> current_;
 };
 
 }  // namespace details
@@ -2,20 +2,32 @@
 
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
-#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "mamba/__concepts/comparable.hpp"
 #include "mamba/__concepts/entity.hpp"
+#include "mamba/__concepts/value.hpp"
 #include "mamba/__memory/handle.hpp"
 #include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
 #include "mamba/__memory/read_only.hpp"
+#include "mamba/__memory/storage.hpp"
+#include "mamba/__utils/parallel_sort.hpp"
+#include "mamba/__utils/radix_sort.hpp"
+#include "mamba/__utils/reduce.hpp"
+#include "mamba/__utils/simd.hpp"
+#include "mamba/__utils/timsort.hpp"
+#include "mamba/builtins/__types/bool.hpp"
+#include "mamba/builtins/__types/float.hpp"
 #include "mamba/builtins/__types/int.hpp"
 #include "mamba/builtins/__types/str.hpp"
 #include "mamba/builtins/as_str.hpp"
@@ -23,14 +35,23 @@
 #include "mamba/builtins/error.hpp"
 #include "mamba/builtins/iteration.hpp"
 #include "mamba/builtins/repr.hpp"
+#include "mamba/builtins/slice_view.hpp"
 
 namespace mamba::builtins {
 namespace details {
 
 // Forward declaration
-template <__concepts::Entity T>
+template <__concepts::Entity T, __memory::StoragePolicy Storage>
 class ListIterator;
 
+/// @brief Iterable whose elements can be counted and copied from a pair of
+/// random access iterators, without going through Iter().
+template <typename It>
+concept RandomAccessIterable = requires(const It& iterable) {
+  { iterable.cbegin() } -> std::random_access_iterator;
+  { iterable.cend() } -> std::same_as<decltype(iterable.cbegin())>;
+};
+
 template <typename F, typename K>
 concept ListSortKey = requires(const F& key_func, __memory::ReadOnly<K> k) {
   { key_func(k) } -> __concepts::LessThanComparable;
@@ -38,9 +59,16 @@ concept ListSortKey = requires(const F& key_func, __memory::ReadOnly<K> k) {
 
 }  // namespace details
 
-template <typename T>
-  requires __concepts::Entity<T> && __concepts::LessThanComparable<T>
-class List : public std::enable_shared_from_this<List<T>> {
+/// @brief Mutable sequence of elements of type @tparam T.
+/// @tparam Storage Storage policy for the elements. With
+/// __memory::CopyOnWriteStorage, copies of the list share their elements until
+/// either is mutated. Note that the non-const begin(), end() and operator[]
+/// count as mutations.
+/// @see storage.hpp
+template <typename T, typename Storage = __memory::VectorStorage>
+  requires __concepts::Entity<T> && __concepts::LessThanComparable<T> &&
+           __memory::StoragePolicy<Storage>
+class List : public __memory::EnableHandleFromThis<List<T, Storage>> {
  public:
   /// @note Mamba-specific
   using element = T;
@@ -50,40 +78,57 @@ class List : public std::enable_shared_from_this<List<T>> {
   using const_reference = const value_type&;
 
   /// @note Mamba-specific
-  using storage = std::vector<value_type>;
+  using storage = Storage::template type<value_type>;
 
   using iterator = storage::iterator;
   using const_iterator = storage::const_iterator;
 
   /// @note Mamba-specific
-  using self = List<element>;
+  using self = List<element, Storage>;
   using handle = __memory::handle_t<self>;
 
-  static constexpr auto kEndIndex = std::numeric_limits<__types::Int>::min();
+  static constexpr auto kEndIndex = builtins::kEndIndex;
 
   /// @brief Creates an empty list.
   /// @code list()
   List() {}
 
   /// @brief Creates a list with the same elements as @p it. Value types
-  /// are copied.
+  /// are copied, with a single allocation when the number of elements is
+  /// known up front. See Extend().
   /// @code list(Iterable)
   template <typename It>
-    requires __concepts::TypedIterable<It, element>
+    requires __concepts::TypedIterable<It, element> &&
+             (!std::same_as<It, SliceView<element>>)
   explicit List(It& iterable) {
-    bool no_stop_iteration = true;
-    auto it = iterable.Iter();
-
-    while (no_stop_iteration) {
-      try {
-        Append(Next(*it));
-      } catch (StopIteration) {
-        no_stop_iteration = false;
-        break;
-      }
+    if constexpr (std::same_as<It, self>) {
+      // Copy the storage directly, which is O(1) for copy-on-write storage
+      v_ = iterable.v_;
+    } else {
+      Extend(iterable);
     }
   }
 
+  /// @brief Creates a list with the remaining elements of @p it, e.g. of a
+  /// pipeline of adaptors.
+  /// @code list(map(f, iterable))
+  /// @see adaptors.hpp
+  template <__concepts::StaticIterator It>
+    requires std::convertible_to<typename It::value_type, value_type> &&
+             (!__concepts::TypedIterable<It, element>)
+  explicit List(It it) {
+    ReserveMore(LengthHint(it));
+    ForEach(it, [this](value_type elem) { Append(std::move(elem)); });
+  }
+
+  /// @brief Creates a list with the elements of @p view.
+  /// @code list(list[i:j:k])
+  explicit List(const SliceView<element>& view) {
+    v_.reserve(view.Len());
+
+    std::copy(view.begin(), view.end(), std::back_inserter(v_));
+  }
+
   /// @brief Creates a list with the provided variadic arguments.
   /// @code list(...)
   template <typename... Args>
@@ -124,10 +169,15 @@ class List : public std::enable_shared_from_this<List<T>> {
     (Append(std::forward<Args>(rest)), ...);
   }
 
-  /// @brief Returns whether @p elem is in the list. O(n).
+  /// @brief Returns whether @p elem is in the list. O(n), vectorized for
+  /// Int and Float elements.
   /// @code elem in list
   __types::Bool Contains(__memory::ReadOnly<element> elem) const {
-    return std::find(v_.cbegin(), v_.cend(), elem) != v_.cend();
+    if constexpr (kVectorizedSearch) {
+      return __utils::FindEqual(Elements(), elem) != v_.size();
+    } else {
+      return std::find(v_.cbegin(), v_.cend(), elem) != v_.cend();
+    }
   }
 
   /// @brief Clears the elements of the list.
@@ -141,16 +191,55 @@ class List : public std::enable_shared_from_this<List<T>> {
     return Init(*this);
   }
 
-  /// @brief Extends this list with the elements of @p other.
+  /// @brief Extends this list with the elements of @p other, with at most one
+  /// allocation. Elements that are trivially copyable are copied in bulk.
   /// @code list.extend(list)
   void Extend(const self& other) {
-    v_.reserve(v_.size() + other.v_.size());
+    if (&other == this) {
+      // The storage cannot insert a copy of its own elements, so append them
+      // one at a time, without reallocating
+      const auto size = v_.size();
+      ReserveMore(static_cast<__types::Int>(size));
+
+      for (std::size_t i = 0; i < size; ++i) {
+        v_.emplace_back(std::as_const(v_)[i]);
+      }
+
+      return;
+    }
 
-    std::copy(other.v_.cbegin(), other.v_.cend(), std::back_inserter(v_));
+    v_.insert(v_.cend(), other.v_.cbegin(), other.v_.cend());
   }
 
   void Extend(const handle& other) { Extend(*other); }
 
+  /// @brief Extends this list with the elements of @p iterable. Containers
+  /// with random access iterators, e.g. lists with other storage policies,
+  /// tuples, deques and ranges, are copied with at most one allocation, in
+  /// bulk if contiguous with trivially copyable elements. Anything else is
+  /// iterated after reserving room for LengthHint() elements, type-erased
+  /// iterators in batches.
+  /// @code list.extend(iterable)
+  template <typename It>
+    requires __concepts::TypedIterable<It, element> &&
+             (!std::same_as<std::remove_cv_t<It>, self>)
+  void Extend(It& iterable) {
+    if constexpr (details::RandomAccessIterable<It>) {
+      v_.insert(v_.cend(), iterable.cbegin(), iterable.cend());
+    } else {
+      ReserveMore(LengthHint(iterable));
+      ForEach(iterable,
+              [this](value_type elem) { Append(std::move(elem)); });
+    }
+  }
+
+  template <typename It>
+    requires __concepts::TypedIterable<It, element> &&
+             (!std::same_as<It, self>)
+  void Extend(const __memory::handle_t<It>& iterable) {
+    Extend(*iterable);
+  }
+
   /// @brief Extends this list with the elements of @p other.
   /// @code list += other
   void operator+=(const self& other) { this->Extend(other); }
@@ -159,8 +248,10 @@ class List : public std::enable_shared_from_this<List<T>> {
   /// @brief Concatenates this list with @p other.
   /// @code list + other
   handle operator+(const self& other) const {
-    auto res = Init(*this);
+    auto res = Init();
 
+    res->v_.reserve(v_.size() + other.v_.size());
+    res->Extend(*this);
     res->Extend(other);
 
     return res;
@@ -235,7 +326,7 @@ class List : public std::enable_shared_from_this<List<T>> {
   __types::Int Len() const { return v_.size(); }
 
   /// @brief Returns the smallest element in the list. If the list is empty,
-  /// throws ValueError.
+  /// throws ValueError. Vectorized for Int and Float elements.
   /// @code min(list)
   value_type Min() const {
     if (v_.empty()) {
@@ -246,13 +337,15 @@ class List : public std::enable_shared_from_this<List<T>> {
       return *std::min_element(
           v_.cbegin(), v_.cend(),
           [](const auto a, const auto b) { return operators::Lt(*a, *b); });
+    } else if constexpr (kVectorizedSearch) {
+      return __utils::Min(Elements());
     } else {
       return *std::min_element(v_.cbegin(), v_.cend());
     }
   }
 
   /// @brief Returns the biggest element in the list. If the list is empty,
-  /// throws ValueError.
+  /// throws ValueError. Vectorized for Int and Float elements.
   /// @code max(list)
   value_type Max() const {
     if (v_.empty()) {
@@ -263,18 +356,25 @@ class List : public std::enable_shared_from_this<List<T>> {
       return *std::max_element(
           v_.cbegin(), v_.cend(),
           [](const auto a, const auto b) { return operators::Lt(*a, *b); });
+    } else if constexpr (kVectorizedSearch) {
+      return __utils::Max(Elements());
     } else {
       return *std::max_element(v_.cbegin(), v_.cend());
     }
   }
 
   /// @brief Returns the number of times @p elem is present in the list.
+  /// Vectorized for Int and Float elements.
   /// @code list.count(x)
   __types::Int Count(__memory::ReadOnly<element> elem) const {
-    return std::count_if(v_.cbegin(), v_.cend(),
-                         [elem](__memory::ReadOnly<element> val) {
-                           return operators::Eq(val, elem);
-                         });
+    if constexpr (kVectorizedSearch) {
+      return static_cast<__types::Int>(__utils::CountEqual(Elements(), elem));
+    } else {
+      return std::count_if(v_.cbegin(), v_.cend(),
+                           [elem](__memory::ReadOnly<element> val) {
+                             return operators::Eq(val, elem);
+                           });
+    }
   }
 
   /// @brief Returns the elements in the list such that the elements' indices
@@ -286,49 +386,30 @@ class List : public std::enable_shared_from_this<List<T>> {
   handle Slice(__types::Int start = 0,
                __types::Int end = kEndIndex,
                __types::Int step = 1) const {
-    auto res = Init();
+    return Init(View(start, end, step));
+  }
 
-    auto slice_params_opt = TryGetNormalizedSliceParams(start, end, step);
+  /// @brief Returns a read-only view of the elements that Slice() would
+  /// return, without copying them. The view is invalidated by any mutation
+  /// or the destruction of this list.
+  /// @code list[i:j:k]
+  SliceView<element> View(__types::Int start = 0,
+                          __types::Int end = kEndIndex,
+                          __types::Int step = 1) const {
+    const auto slice_params_opt = TryGetNormalizedSliceParams(start, end, step);
 
     if (!slice_params_opt) {
-      return res;
+      return {};
     }
 
     const auto size_t_start = slice_params_opt->start;
     const auto size_t_end = slice_params_opt->end;
     const auto size_t_step = slice_params_opt->step;
 
-    // Simple range copy
-    if (size_t_step == 1) {
-      res->v_.reserve(size_t_end - size_t_start);
-
-      // Need to recalculate in case reserve() invalidated the pre-calculated
-      // iterators
-      const auto start_it = v_.begin() + size_t_start;
-      const auto end_it = v_.begin() + size_t_end;
-
-      std::copy(start_it, end_it, std::back_inserter(res->v_));
-
-      return res;
-    }
-
-    // Stepped range copy
-    res->v_.reserve(
-        GetNumberOfElementsInSlice(size_t_start, size_t_end, size_t_step));
-
-    // Need to recalculate in case reserve() invalidated the pre-calculated
-    // iterators
-    const auto start_it = v_.begin() + size_t_start;
-    const auto end_it = v_.begin() + size_t_end;
-
-    size_t i = 0;
-
-    std::copy_if(start_it, end_it, std::back_inserter(res->v_),
-                 [&i, size_t_step](const auto) -> bool {
-                   return i++ % size_t_step == 0;
-                 });
-
-    return res;
+    return SliceView<element>(
+        std::to_address(slice_params_opt->start_it),
+        GetNumberOfElementsInSlice(size_t_start, size_t_end, size_t_step),
+        size_t_step);
   }
 
 #if __cplusplus >= 202302L
@@ -418,10 +499,23 @@ class List : public std::enable_shared_from_this<List<T>> {
                      __types::Int start,
                      __types::Int end) const {
     end = ClampIndex(end);
+    start = ClampIndex(start);
+
+    if constexpr (kVectorizedSearch) {
+      if (start < end) {
+        const auto idx =
+            start + static_cast<__types::Int>(__utils::FindEqual(
+                        Elements().subspan(start, end - start), elem));
 
-    for (__types::Int idx = ClampIndex(start); idx < end; ++idx) {
-      if (v_[idx] == elem) {
-        return idx;
+        if (idx < end) {
+          return idx;
+        }
+      }
+    } else {
+      for (__types::Int idx = start; idx < end; ++idx) {
+        if (v_[idx] == elem) {
+          return idx;
+        }
       }
     }
 
@@ -443,6 +537,16 @@ class List : public std::enable_shared_from_this<List<T>> {
     }
   }
 
+  /// @brief Inserts @p elem so that it becomes the element at @p idx, which
+  /// must be at most the length of the list, with a single shift of the
+  /// elements after it. Unlike Insert(), @p idx is neither normalized nor
+  /// clamped, for callers that computed it from the list, e.g. Insort().
+  /// @note Mamba-specific
+  /// @see bisect.hpp
+  void InsertAt(size_t idx, value_type elem) {
+    v_.insert(GetIterator(idx), std::move(elem));
+  }
+
   /// @brief Removes the element at @p idx and returns it. If @p idx is out of
   /// bounds, then throws IndexError.
   /// @code list.pop(idx)
@@ -505,29 +609,44 @@ class List : public std::enable_shared_from_this<List<T>> {
 
   /// @brief Sorts the list in-place, with the order of equal-comparing
   /// elements guaranteed to be preserved. Each element is compared using
-  /// the less-than operator.
+  /// the less-than operator. Runs in O(n) on lists that are already sorted,
+  /// reverse-sorted or made of a few sorted runs. Lists of Bool are sorted by
+  /// counting, and long lists of Int or Float by radix sort. Lists of at
+  /// least __utils::ParallelSortThreshold() elements are sorted in parallel.
   /// @code sort(list, reverse)
+  /// @see timsort.hpp
+  /// @see radix_sort.hpp
+  /// @see parallel_sort.hpp
   void Sort(__types::Bool reverse = false) {
     if (v_.empty()) {
       return;
     }
 
-    if (reverse) {
-      // We sort with the inverse of the comparison to make sure the sort
+    if constexpr (std::same_as<element, __types::Bool>) {
+      __utils::CountingSort(v_.begin(), v_.end(), reverse);
+    } else if (reverse) {
+      // We sort with the reverse of the comparison to make sure the sort
       // is stable, rather than reverse the results afterwards
-      std::sort(v_.begin(), v_.end(), [](const auto a, const auto b) {
-        return !(operators::Lt(a, b) || !operators::Lt(b, a));
-      });
+      SortRange<element>(v_.begin(), v_.end(), reverse,
+                         [](const auto& a, const auto& b) {
+                           return operators::Lt(b, a);
+                         });
     } else {
-      std::sort(v_.begin(), v_.end(),
-                [](const auto a, const auto b) { return operators::Lt(a, b); });
+      SortRange<element>(v_.begin(), v_.end(), reverse,
+                         [](const auto& a, const auto& b) {
+                           return operators::Lt(a, b);
+                         });
     }
   }
 
   /// @brief Sorts the list in-place, with the order of equal-comparing
   /// elements guaranteed to be preserved. Every element is transformed via
-  /// @p key before it is compared using the less-than operator.
+  /// @p key before it is compared using the less-than operator. As in
+  /// Python, @p key is called exactly once per element, on the calling
+  /// thread, even when the keys are then sorted in parallel.
   /// @code sort(list, key, reverse)
+  /// @see timsort.hpp
+  /// @see parallel_sort.hpp
   template <typename K>
     requires details::ListSortKey<K, element>
   void Sort(const K& key, __types::Bool reverse = false) {
@@ -535,25 +654,64 @@ class List : public std::enable_shared_from_this<List<T>> {
       return;
     }
 
-    if (reverse) {
-      // We sort with the inverse of the comparison to make sure the sort
-      // is stable, rather than reverse the results afterwards
-      std::sort(v_.begin(), v_.end(), [&key](const auto a, const auto b) {
-        const auto ka = key(a);
-        const auto kb = key(b);
-        return !(operators::Lt(ka, kb) || !operators::Lt(kb, ka));
-      });
-    } else {
-      std::sort(v_.begin(), v_.end(), [&key](const auto a, const auto b) {
-        return operators::Lt(key(a), key(b));
-      });
+    using key_type =
+        std::decay_t<std::invoke_result_t<const K&, const value_type&>>;
+    using decorated_type = std::pair<key_type, value_type>;
+
+    // Decorate-sort-undecorate: the elements are moved next to their keys
+    // and sorted together, rather than calling key() twice per comparison
+    std::vector<decorated_type> decorated;
+    decorated.reserve(v_.size());
+
+    const auto undecorate = [this, &decorated]() {
+      auto it = v_.begin();
+
+      for (auto& [_, value] : decorated) {
+        *it++ = std::move(value);
+      }
+    };
+
+    try {
+      for (auto&& elem : v_) {
+        decorated.emplace_back(key(std::as_const(elem)), std::move(elem));
+      }
+
+      if (reverse) {
+        // We sort with the reverse of the comparison to make sure the sort
+        // is stable, rather than reverse the results afterwards
+        SortRange<key_type>(
+            decorated.begin(), decorated.end(), reverse,
+            [](const decorated_type& a, const decorated_type& b) {
+              return operators::Lt(b.first, a.first);
+            });
+      } else {
+        SortRange<key_type>(
+            decorated.begin(), decorated.end(), reverse,
+            [](const decorated_type& a, const decorated_type& b) {
+              return operators::Lt(a.first, b.first);
+            });
+      }
+    } catch (...) {
+      // Neither a throwing key() nor comparison loses any element
+      undecorate();
+      throw;
     }
+
+    undecorate();
   }
 
   /// @brief Returns an iterator to this list.
   /// @code list.__iter__()
   __memory::handle_t<Iterator<element>> Iter() {
-    return details::ListIterator<element>::Init(v_.begin(), v_.end());
+    return details::ListIterator<element, Storage>::Init(v_.cbegin(),
+                                                         v_.cend());
+  }
+
+  /// @brief Returns the concrete iterator to this list by value, which
+  /// ForEach() uses instead of Iter() so that loops can be inlined.
+  /// @note Mamba-specific
+  details::ListIterator<element, Storage> StaticIter() const {
+    return {v_.cbegin(), v_.cend()};
   }
 
   /// @brief Native support for C++ for..in loops.
@@ -664,6 +822,31 @@ class List : public std::enable_shared_from_this<List<T>> {
   }
 
  private:
+  // Whether Contains(), Count(), Index(), Min() and Max() go through the
+  // vectorized kernels of simd.hpp rather than one element at a time
+  static constexpr bool kVectorizedSearch =
+      __utils::SimdElement<value_type> &&
+      std::contiguous_iterator<const_iterator>;
+
+  // Reserves room for @p n more elements, at least doubling the capacity if
+  // it has to grow, so that many small extends stay amortized O(1) per
+  // element. Negative hints are ignored.
+  void ReserveMore(__types::Int n) {
+    if (n <= 0) {
+      return;
+    }
+
+    const auto size = v_.size() + static_cast<std::size_t>(n);
+
+    if (size > v_.capacity()) {
+      v_.reserve(std::max(size, 2 * v_.capacity()));
+    }
+  }
+
+  std::span<const value_type> Elements() const {
+    return {v_.cbegin(), v_.cend()};
+  }
+
   size_t ClampIndex(__types::Int idx) const {
     if (idx < 0) {
       return 0;
@@ -674,6 +857,40 @@ class List : public std::enable_shared_from_this<List<T>> {
     return static_cast<size_t>(idx);
   }
 
+  /// @brief Stably sorts [@p first, @p last) with @p lt, which compares
+  /// values of @tparam Compared in descending order if @p reverse is set. Long
+  /// ranges of Int or Float are radix sorted, and ranges of at least
+  /// __utils::ParallelSortThreshold() elements are sorted in parallel.
+  template <typename Compared, typename It, typename Compare>
+  static void SortRange(It first, It last, bool reverse, const Compare& lt) {
+    using sorted_type = std::iter_value_t<It>;
+
+    const auto sort = [reverse, &lt](It lo, It hi) {
+      if constexpr (std::same_as<sorted_type, __types::Int> ||
+                    std::same_as<sorted_type, __types::Float>) {
+        if (static_cast<size_t>(hi - lo) >=
+                __utils::kRadixSortThreshold<sorted_type> &&
+            __utils::RadixSort(std::span<sorted_type>(lo, hi), reverse)) {
+          return;
+        }
+      }
+
+      __utils::TimSort(lo, hi, lt);
+    };
+
+    // Comparing objects may copy their handles from several threads at once
+    if constexpr (__concepts::Value<Compared> ||
+                  __memory::kThreadSafeHandles) {
+      if (static_cast<size_t>(last - first) >=
+          __utils::ParallelSortThreshold()) {
+        __utils::ParallelMergeSort(first, last, lt, sort);
+        return;
+      }
+    }
+
+    sort(first, last);
+  }
+
   size_t GetNumberOfElementsInSlice(size_t start,
                                     size_t end,
                                     size_t step) const {
@@ -868,18 +1085,20 @@ class List : public std::enable_shared_from_this<List<T>> {
 
 namespace details {
 
-template <__concepts::Entity T>
-class ListIterator : public Iterator<T>,
-                     public std::enable_shared_from_this<ListIterator<T>> {
+template <__concepts::Entity T,
+          __memory::StoragePolicy Storage = __memory::VectorStorage>
+class ListIterator final
+    : public Iterator<T>,
+      public __memory::EnableHandleFromThis<ListIterator<T, Storage>> {
  public:
   /// @brief Mamba-specific
   using element = T;
 
   using value_type = __memory::managed_t<element>;
-  using iterator = List<element>::iterator;
+  using iterator = List<element, Storage>::const_iterator;
 
   /// @brief Mamba-specific
-  using self = ListIterator<element>;
+  using self = ListIterator<element, Storage>;
   using handle = __memory::handle_t<self>;
 
   ListIterator(iterator it, iterator end)
@@ -888,25 +1107,34 @@ class ListIterator : public Iterator<T>,
   ~ListIterator() override = default;
 
   /// @brief Generic constructor forwarding arguments to actual constructor
-  /// methods.
+  /// methods. Iterators come from the pool of the calling thread.
   /// @code ListIterator.__init__()
+  /// @see pool.hpp
   template <typename... Args>
   static handle Init(Args&&... args) {
-    return __memory::Init<self>(std::forward<Args>(args)...);
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
   }
 
   __memory::handle_t<Iterator<element>> Iter() override {
-    return std::enable_shared_from_this<self>::shared_from_this();
+    return this->HandleFromThis();
   }
 
-  value_type Next() override {
+  std::optional<value_type> TryNext() override {
     if (it_ == end_) {
-      throw StopIteration("end of iterator");
+      return std::nullopt;
     }
 
     return *it_++;
   }
 
+  std::size_t NextBatch(std::span<value_type> out) override {
+    return details::CopyBatch(it_, end_, out);
+  }
+
+  __types::Int LengthHint() const override {
+    return details::RemainingLength(it_, end_);
+  }
+
   __types::Str Repr() const override { return "ListIterator"; }
 
   bool operator==(const self& other) const {
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__utils/thread_pool.hpp"
+#include "mamba/builtins/list.hpp"
+
+namespace mamba::builtins {
+namespace __concepts {
+
+/// @brief Sequence whose elements can be split into chunks for workers,
+/// e.g. List, Tuple and Range.
+template <typename T>
+concept ParallelIterable = requires(const T& sequence) {
+  { sequence.cbegin() } -> std::random_access_iterator;
+  { sequence.cend() } -> std::random_access_iterator;
+};
+
+}  // namespace __concepts
+
+namespace details {
+
+// Chunks are a whole number of cache lines of elements, so that workers
+// writing the results of adjacent chunks never share a cache line
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// Chunks per worker, so that workers finishing early can steal the rest
+inline constexpr std::size_t kChunksPerWorker = 4;
+
+inline constexpr std::size_t kMinChunkSize = 256;
+
+template <typename T>
+std::size_t ChunkSize(std::size_t n, std::size_t num_workers) {
+  constexpr auto line = std::max<std::size_t>(kCacheLineSize / sizeof(T), 1);
+  const auto chunk =
+      std::max(n / (num_workers * kChunksPerWorker), kMinChunkSize);
+
+  return (chunk + line - 1) / line * line;
+}
+
+/// @brief Element type of a list of @tparam U, e.g. T for handle_t<T>.
+template <typename U>
+struct ListElement {
+  using type = U;
+};
+
+template <__memory::Handle U>
+struct ListElement<U> {
+  using type = U::element_type;
+};
+
+}  // namespace details
+
+/// @brief Calls @p f with each element of @p sequence, in parallel on the
+/// default thread pool. Elements are split into chunks of consecutive
+/// elements that idle workers steal from busy ones, so that uneven work is
+/// balanced. Returns once all calls returned, and rethrows the first
+/// exception thrown by @p f, if any.
+/// @note Mamba-specific. @p f is called concurrently and in no particular
+/// order, so it must not write to anything that other calls access. Handles
+/// shared between calls need thread-safe reference counts, which intrusive
+/// handles only have with MAMBA_ATOMIC_REFCOUNT.
+/// @code for elem in parallel(sequence): f(elem)
+template <__concepts::ParallelIterable T, typename F>
+void ParallelFor(const T& sequence, F f) {
+  const auto begin = sequence.cbegin();
+  const auto n = static_cast<std::size_t>(sequence.cend() - begin);
+  const auto chunk = details::ChunkSize<std::iter_value_t<decltype(begin)>>(
+      n, __utils::ThreadPool::Default().Size());
+
+  __utils::ParallelChunks(n, chunk, [&](std::size_t lo, std::size_t hi) {
+    const auto end = begin + static_cast<std::ptrdiff_t>(hi);
+
+    for (auto it = begin + static_cast<std::ptrdiff_t>(lo); it != end; ++it) {
+      std::invoke(f, *it);
+    }
+  });
+}
+
+template <__concepts::ParallelIterable T, typename F>
+void ParallelFor(const __memory::handle_t<T>& sequence, F f) {
+  ParallelFor(*sequence, std::move(f));
+}
+
+/// @brief Returns a new list with the results of applying @p f to each
+/// element of @p sequence, in order. The calls are made in parallel like in
+/// ParallelFor().
+/// @note Mamba-specific
+/// @code list(parallel_map(f, sequence))
+template <typename F, __concepts::ParallelIterable T>
+auto ParallelMap(F f, const T& sequence) {
+  const auto begin = sequence.cbegin();
+  using value_type = std::remove_cvref_t<
+      std::invoke_result_t<F&, std::iter_reference_t<decltype(begin)>>>;
+  using element = details::ListElement<value_type>::type;
+
+  const auto n = static_cast<std::size_t>(sequence.cend() - begin);
+  const auto chunk = details::ChunkSize<value_type>(
+      n, __utils::ThreadPool::Default().Size());
+
+  std::vector<value_type> results(n);
+
+  __utils::ParallelChunks(n, chunk, [&](std::size_t lo, std::size_t hi) {
+    for (auto i = lo; i < hi; ++i) {
+      results[i] = std::invoke(f, begin[static_cast<std::ptrdiff_t>(i)]);
+    }
+  });
+
+  auto res = List<element>::Init();
+
+  for (auto& result : results) {
+    res->Append(std::move(result));
+  }
+
+  return res;
+}
+
+template <typename F, __concepts::ParallelIterable T>
+auto ParallelMap(F f, const __memory::handle_t<T>& sequence) {
+  return ParallelMap(std::move(f), *sequence);
+}
+
+}  // namespace mamba::builtins
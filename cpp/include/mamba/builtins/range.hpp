@@ -0,0 +1,478 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <utility>
+
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/pool.hpp"
+#include "mamba/builtins/__types/bool.hpp"
+#include "mamba/builtins/__types/int.hpp"
+#include "mamba/builtins/__types/str.hpp"
+#include "mamba/builtins/error.hpp"
+#include "mamba/builtins/iteration.hpp"
+#include "mamba/builtins/slice_view.hpp"
+
+namespace mamba::builtins {
+namespace details {
+
+// Forward declaration
+class RangeIterator;
+
+/// @brief Random access iterator over the numbers of a range. Positions are
+/// kept as indices so that the end position never overflows.
+class RangeCounter {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = __types::Int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = value_type;
+
+  RangeCounter() = default;
+
+  RangeCounter(__types::Int start, difference_type idx, __types::Int step)
+      : start_(start), idx_(idx), step_(step) {}
+
+  reference operator*() const { return start_ + idx_ * step_; }
+  reference operator[](difference_type n) const {
+    return start_ + (idx_ + n) * step_;
+  }
+
+  RangeCounter& operator++() {
+    ++idx_;
+    return *this;
+  }
+
+  RangeCounter operator++(int) {
+    auto res = *this;
+    ++idx_;
+    return res;
+  }
+
+  RangeCounter& operator--() {
+    --idx_;
+    return *this;
+  }
+
+  RangeCounter operator--(int) {
+    auto res = *this;
+    --idx_;
+    return res;
+  }
+
+  RangeCounter& operator+=(difference_type n) {
+    idx_ += n;
+    return *this;
+  }
+
+  RangeCounter& operator-=(difference_type n) {
+    idx_ -= n;
+    return *this;
+  }
+
+  friend RangeCounter operator+(RangeCounter it, difference_type n) {
+    return it += n;
+  }
+
+  friend RangeCounter operator+(difference_type n, RangeCounter it) {
+    return it += n;
+  }
+
+  friend RangeCounter operator-(RangeCounter it, difference_type n) {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const RangeCounter& lhs,
+                                   const RangeCounter& rhs) {
+    return lhs.idx_ - rhs.idx_;
+  }
+
+  friend bool operator==(const RangeCounter& lhs, const RangeCounter& rhs) {
+    return lhs.idx_ == rhs.idx_;
+  }
+
+  friend std::strong_ordering operator<=>(const RangeCounter& lhs,
+                                          const RangeCounter& rhs) {
+    return lhs.idx_ <=> rhs.idx_;
+  }
+
+ private:
+  __types::Int start_ = 0;
+  difference_type idx_ = 0;
+  __types::Int step_ = 1;
+};
+
+}  // namespace details
+
+/// @brief Immutable sequence of the numbers from start up to but excluding
+/// stop, step apart. The numbers are computed on demand, so every operation
+/// besides iteration is O(1).
+class Range : public __memory::EnableHandleFromThis<Range> {
+ public:
+  /// @note Mamba-specific
+  using element = __types::Int;
+
+  using value_type = element;
+  using iterator = details::RangeCounter;
+  using const_iterator = details::RangeCounter;
+
+  /// @note Mamba-specific
+  using self = Range;
+  using handle = __memory::handle_t<self>;
+
+  static constexpr auto kEndIndex = builtins::kEndIndex;
+
+  /// @brief Creates the range of the numbers from 0 up to @p stop.
+  /// @code range(stop)
+  explicit Range(__types::Int stop) : Range(0, stop) {}
+
+  /// @brief Creates the range of the numbers from @p start up to @p stop,
+  /// @p step apart. If @p step is 0, throws ValueError.
+  /// @code range(start, stop, (step))
+  Range(__types::Int start, __types::Int stop, __types::Int step = 1)
+      : start_(start), stop_(stop), step_(step) {
+    if (step == 0) {
+      throw ValueError("range() arg 3 must not be zero");
+    }
+
+    if (step > 0 && start < stop) {
+      len_ = (stop - start - 1) / step + 1;
+    } else if (step < 0 && start > stop) {
+      len_ = (start - stop - 1) / -step + 1;
+    }
+  }
+
+  /// @brief Generic constructor forwarding arguments to actual constructor
+  /// methods.
+  /// @code Range.__init__()
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::Init<self>(std::forward<Args>(args)...);
+  }
+
+  /// @code range.start
+  __types::Int Start() const { return start_; }
+
+  /// @code range.stop
+  __types::Int Stop() const { return stop_; }
+
+  /// @code range.step
+  __types::Int Step() const { return step_; }
+
+  /// @brief Returns whether @p elem is in the range. O(1).
+  /// @code elem in range
+  __types::Bool Contains(__types::Int elem) const {
+    return TryGetIndex(elem).has_value();
+  }
+
+  /// @brief Returns the number of times @p elem is in the range, i.e. 0 or 1.
+  /// @code range.count(x)
+  __types::Int Count(__types::Int elem) const { return Contains(elem); }
+
+  /// @brief Returns the index of @p elem in the range. If @p elem is not in
+  /// the range, throws ValueError.
+  /// @code range.index(x)
+  __types::Int Index(__types::Int elem) const {
+    const auto idx_opt = TryGetIndex(elem);
+
+    if (!idx_opt) {
+      throw ValueError("{elem} is not in range");
+    }
+
+    return *idx_opt;
+  }
+
+  /// @brief Returns the number at index @p idx. If the index is out of range,
+  /// throws IndexError. @p idx supports negative indices counting from the
+  /// last number.
+  /// @code range[idx]
+  value_type operator[](__types::Int idx) const {
+    if (idx < 0) {
+      idx += len_;
+    }
+
+    if (idx < 0 || idx >= len_) {
+      throw IndexError("range object index out of range");
+    }
+
+    return At(idx);
+  }
+
+  /// @brief Returns the number of numbers in the range.
+  /// @code len(range)
+  __types::Int Len() const { return len_; }
+
+  /// @brief Returns the smallest number in the range. If the range is empty,
+  /// throws ValueError.
+  /// @code min(range)
+  value_type Min() const {
+    if (len_ == 0) {
+      throw ValueError("Min() arg is an empty sequence");
+    }
+
+    return step_ > 0 ? start_ : At(len_ - 1);
+  }
+
+  /// @brief Returns the biggest number in the range. If the range is empty,
+  /// throws ValueError.
+  /// @code max(range)
+  value_type Max() const {
+    if (len_ == 0) {
+      throw ValueError("Max() arg is an empty sequence");
+    }
+
+    return step_ > 0 ? At(len_ - 1) : start_;
+  }
+
+  /// @brief Returns the range of the numbers whose indices satisfy
+  /// @p start <= idx < @p end, with @p step indices between them, following
+  /// the same rules as List::Slice(). This is again a range, so nothing is
+  /// materialized.
+  /// @code range[i:j:k]
+  handle Slice(__types::Int start = 0,
+               __types::Int end = kEndIndex,
+               __types::Int step = 1) const {
+    const auto indices_opt = TryGetNormalizedSliceIndices(start, end, step);
+
+    if (!indices_opt) {
+      return Init(start_, start_, step_);
+    }
+
+    const auto [idx_start, idx_end] = *indices_opt;
+    const auto len = (idx_end - idx_start + step - 1) / step;
+    const auto new_start = At(idx_start);
+    const auto new_step = step_ * step;
+
+    return Init(new_start, new_start + len * new_step, new_step);
+  }
+
+#if __cplusplus >= 202302L
+  handle operator[](__types::Int start = 0,
+                    __types::Int end = kEndIndex,
+                    __types::Int step = 1) const {
+    return Slice(start, end, step);
+  }
+#endif  // __cplusplus >= 202302L
+
+  /// @brief Returns an iterator to this range.
+  /// @code range.__iter__()
+  __memory::handle_t<Iterator<element>> Iter() const;
+
+  /// @brief Returns the concrete iterator to this range by value, which
+  /// ForEach() uses instead of Iter() so that loops can be inlined.
+  /// @note Mamba-specific
+  details::RangeIterator StaticIter() const;
+
+  /// @brief Native support for C++ for..in loops.
+  const_iterator begin() const { return const_iterator(start_, 0, step_); }
+  const_iterator end() const { return const_iterator(start_, len_, step_); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  /// @code bool(range)
+  __types::Bool AsBool() const { return len_ != 0; }
+
+  /// @brief Implicit conversion to Bool (C++ bool) for conditionals.
+  /// @code if range:
+  operator __types::Bool() const { return AsBool(); }
+
+  /// @brief Returns false all the time for all arguments so long as they are
+  /// not a range.
+  /// @code range == other
+  template <typename U>
+  __types::Bool Eq(const U&) const {
+    return false;
+  }
+
+  /// @brief Returns true if this and @p other contain the same numbers, and
+  /// false otherwise, e.g. range(0) == range(2, 2).
+  /// @code range == other
+  template <>
+  __types::Bool Eq(const self& other) const {
+    if (len_ != other.len_) {
+      return false;
+    }
+
+    if (len_ == 0) {
+      return true;
+    }
+
+    return start_ == other.start_ && (len_ == 1 || step_ == other.step_);
+  }
+
+  template <>
+  __types::Bool Eq(const handle& other) const {
+    return Eq(*other);
+  }
+
+  /// @brief Native support for C++ == and != operators.
+  template <typename U>
+  bool operator==(const U& other) const {
+    return Eq(other);
+  }
+
+  template <typename U>
+  bool operator!=(const U& other) const {
+    return !Eq(other);
+  }
+
+  /// @brief Returns the string representation of the range.
+  /// @code str(range)
+  __types::Str AsStr() const { return Repr(); }
+
+  /// @brief Returns the representation of the range.
+  /// @code repr(range)
+  __types::Str Repr() const {
+    std::ostringstream oss;
+
+    oss << "range(" << start_ << ", " << stop_;
+
+    if (step_ != 1) {
+      oss << ", " << step_;
+    }
+
+    oss << ")";
+
+    return oss.str();
+  }
+
+ private:
+  value_type At(__types::Int idx) const { return start_ + idx * step_; }
+
+  std::optional<__types::Int> TryGetIndex(__types::Int elem) const {
+    const auto offset = elem - start_;
+
+    if (offset % step_ != 0) {
+      return std::nullopt;
+    }
+
+    const auto idx = offset / step_;
+
+    if (idx < 0 || idx >= len_) {
+      return std::nullopt;
+    }
+
+    return idx;
+  }
+
+  std::optional<__types::Int> TryGetNormalizedIndex(__types::Int idx) const {
+    if (idx < 0) {
+      idx += len_;
+    }
+
+    if (idx < 0 || idx >= len_) {
+      return std::nullopt;
+    }
+
+    return idx;
+  }
+
+  std::optional<std::pair<__types::Int, __types::Int>>
+  TryGetNormalizedSliceIndices(__types::Int start,
+                               __types::Int end,
+                               __types::Int step) const {
+    // Zero step is invalid
+    if (step == 0) {
+      throw ValueError("slice step cannot be zero");
+    }
+
+    // Negative step is no-op
+    if (step < 0) {
+      return std::nullopt;
+    }
+
+    start = TryGetNormalizedIndex(start).value_or(0);
+
+    if (end == kEndIndex) {
+      end = len_;
+    } else {
+      end = TryGetNormalizedIndex(end).value_or(len_);
+    }
+
+    // Start beyond end is no-op
+    if (start >= end) {
+      return std::nullopt;
+    }
+
+    return std::make_pair(start, end);
+  }
+
+  __types::Int start_;
+  __types::Int stop_;
+  __types::Int step_;
+  __types::Int len_ = 0;
+};
+
+namespace details {
+
+class RangeIterator final
+    : public Iterator<__types::Int>,
+      public __memory::EnableHandleFromThis<RangeIterator> {
+ public:
+  /// @brief Mamba-specific
+  using element = __types::Int;
+
+  using value_type = element;
+  using iterator = Range::const_iterator;
+
+  /// @brief Mamba-specific
+  using self = RangeIterator;
+  using handle = __memory::handle_t<self>;
+
+  RangeIterator(iterator it, iterator end)
+      : it_(std::move(it)), end_(std::move(end)) {}
+
+  ~RangeIterator() override = default;
+
+  /// @brief Generic constructor forwarding arguments to actual constructor
+  /// methods. Iterators come from the pool of the calling thread.
+  /// @code RangeIterator.__init__()
+  /// @see pool.hpp
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
+  }
+
+  __memory::handle_t<Iterator<element>> Iter() override {
+    return this->HandleFromThis();
+  }
+
+  std::optional<value_type> TryNext() override {
+    if (it_ == end_) {
+      return std::nullopt;
+    }
+
+    return *it_++;
+  }
+
+  std::size_t NextBatch(std::span<value_type> out) override {
+    return details::CopyBatch(it_, end_, out);
+  }
+
+  __types::Int LengthHint() const override {
+    return details::RemainingLength(it_, end_);
+  }
+
+  __types::Str Repr() const override { return "RangeIterator"; }
+
+ private:
+  iterator it_;
+  iterator end_;
+};
+
+}  // namespace details
+
+inline __memory::handle_t<Iterator<Range::element>> Range::Iter() const {
+  return details::RangeIterator::Init(begin(), end());
+}
+
+inline details::RangeIterator Range::StaticIter() const {
+  return {begin(), end()};
+}
+
+}  // namespace mamba::builtins
@@ -1,12 +1,25 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 #include "mamba/__concepts/entity.hpp"
+#include "mamba/__concepts/value.hpp"
 #include "mamba/__memory/handle.hpp"
 #include "mamba/__memory/managed.hpp"
 #include "mamba/__memory/read_only.hpp"
+#include "mamba/__utils/reduce.hpp"
+#include "mamba/__utils/simd.hpp"
+#include "mamba/builtins/__as_bool/bool.hpp"
+#include "mamba/builtins/__as_bool/float.hpp"
+#include "mamba/builtins/__as_bool/int.hpp"
+#include "mamba/builtins/__as_bool/str.hpp"
 #include "mamba/builtins/__types/bool.hpp"
+#include "mamba/builtins/__types/float.hpp"
 #include "mamba/builtins/__types/int.hpp"
 #include "mamba/builtins/iteration.hpp"
 
@@ -30,8 +43,57 @@ concept TypedSequence =
 template <typename T>
 concept Sequence = __concepts::TypedSequence<T, typename T::element>;
 
+template <typename T>
+concept NumberSequence =
+    __concepts::Sequence<T> && __concepts::Number<typename T::element>;
+
 }  // namespace __concepts
 
+/// @brief How Sum() adds up floats.
+/// @note Mamba-specific
+enum class Summation {
+  /// Tracks the rounding errors of the additions and adds them back at the
+  /// end, like Python's sum() does, so that e.g. sum([1e100, 1.0, -1e100])
+  /// is 1.0.
+  kCompensated,
+  /// Adds the halves of the sequence separately, recursively, which is
+  /// faster, and whose error only grows with the logarithm of the length.
+  kPairwise,
+};
+
+namespace details {
+
+/// @brief Sequence whose elements can be read through iterators, without the
+/// virtual calls of Iter(), e.g. List, Tuple and Range.
+template <typename T>
+concept ConstIterable = requires(const T& sequence) {
+  { sequence.cbegin() } -> std::input_iterator;
+  { sequence.cend() } -> std::sentinel_for<decltype(sequence.cbegin())>;
+};
+
+/// @brief Sequence whose elements are stored contiguously and can be
+/// reduced with the vectorized kernels of simd.hpp, e.g. List and Tuple of
+/// Int or Float.
+template <typename T>
+concept ContiguousNumbers =
+    ConstIterable<T> &&
+    std::contiguous_iterator<decltype(std::declval<const T&>().cbegin())> &&
+    __utils::SimdElement<__memory::managed_t<typename T::element>>;
+
+template <ContiguousNumbers T>
+std::span<const __memory::managed_t<typename T::element>> Elements(
+    const T& sequence) {
+  return {sequence.cbegin(), sequence.cend()};
+}
+
+/// @brief Type of the sum of elements of type @tparam T.
+template <__concepts::Number T>
+using SumType = std::conditional_t<std::same_as<T, __types::Float>,
+                                   __types::Float,
+                                   __types::Int>;
+
+}  // namespace details
+
 template <__concepts::Sequence T>
 __memory::managed_t<typename T::element> Min(const T& sequence) {
   return sequence.Min();
@@ -54,6 +116,114 @@ __memory::managed_t<typename T::element> Max(
   return Max(*sequence);
 }
 
+/// @brief Returns @p start plus the sum of the elements of @p sequence. Int
+/// and Bool elements add up to an Int, which wraps around on overflow, and
+/// Float elements to a Float, with rounding as per @p summation. Lists and
+/// tuples of Int and Float are summed with vectorized kernels, in parallel
+/// once they are very large. Other sequences are summed in order, with
+/// compensation for Float elements.
+/// @code sum(sequence, start)
+template <__concepts::NumberSequence T>
+  requires details::ConstIterable<T>
+details::SumType<typename T::element> Sum(
+    const T& sequence,
+    details::SumType<typename T::element> start = 0,
+    [[maybe_unused]] Summation summation = Summation::kCompensated) {
+  using element = T::element;
+  using sum_type = details::SumType<element>;
+
+  if constexpr (details::ContiguousNumbers<T>) {
+    const auto elements = details::Elements(sequence);
+
+    if constexpr (std::same_as<element, __types::Float>) {
+      return start + (summation == Summation::kCompensated
+                          ? __utils::CompensatedSum(elements)
+                          : __utils::Sum(elements));
+    } else {
+      using unsigned_type = std::make_unsigned_t<sum_type>;
+
+      return static_cast<sum_type>(static_cast<unsigned_type>(start) +
+                                   static_cast<unsigned_type>(
+                                       __utils::Sum(elements)));
+    }
+  } else if constexpr (std::same_as<element, __types::Float>) {
+    __types::Float sum = start;
+    __types::Float error = 0;
+
+    std::for_each(sequence.cbegin(), sequence.cend(),
+                  [&sum, &error](const __types::Float elem) {
+                    __utils::details::TwoSum(sum, error, elem);
+                  });
+
+    // Infinities make NaN errors, which would hide them
+    return std::isfinite(error) ? sum + error : sum;
+  } else {
+    using unsigned_type = std::make_unsigned_t<sum_type>;
+
+    auto sum = static_cast<unsigned_type>(start);
+
+    std::for_each(sequence.cbegin(), sequence.cend(),
+                  [&sum](const element elem) {
+                    sum += static_cast<unsigned_type>(elem);
+                  });
+
+    return static_cast<sum_type>(sum);
+  }
+}
+
+template <__concepts::NumberSequence T>
+  requires details::ConstIterable<T>
+details::SumType<typename T::element> Sum(
+    const __memory::handle_t<T>& sequence,
+    details::SumType<typename T::element> start = 0,
+    Summation summation = Summation::kCompensated) {
+  return Sum(*sequence, start, summation);
+}
+
+/// @brief Returns true if any element of @p sequence is true, and false
+/// otherwise, including if it is empty. Stops at the first true element.
+/// Lists and tuples of Int and Float are searched with vectorized kernels, in
+/// parallel once they are very large.
+/// @code any(sequence)
+template <__concepts::Sequence T>
+  requires details::ConstIterable<T>
+__types::Bool Any(const T& sequence) {
+  if constexpr (details::ContiguousNumbers<T>) {
+    return __utils::AnyNonZero(details::Elements(sequence));
+  } else {
+    return std::any_of(sequence.cbegin(), sequence.cend(),
+                       [](const auto& elem) { return AsBool(elem); });
+  }
+}
+
+template <__concepts::Sequence T>
+  requires details::ConstIterable<T>
+__types::Bool Any(const __memory::handle_t<T>& sequence) {
+  return Any(*sequence);
+}
+
+/// @brief Returns true if all elements of @p sequence are true, including if
+/// it is empty, and false otherwise. Stops at the first false element. Lists
+/// and tuples of Int and Float are searched with vectorized kernels, in
+/// parallel once they are very large.
+/// @code all(sequence)
+template <__concepts::Sequence T>
+  requires details::ConstIterable<T>
+__types::Bool All(const T& sequence) {
+  if constexpr (details::ContiguousNumbers<T>) {
+    return __utils::AllNonZero(details::Elements(sequence));
+  } else {
+    return std::all_of(sequence.cbegin(), sequence.cend(),
+                       [](const auto& elem) { return AsBool(elem); });
+  }
+}
+
+template <__concepts::Sequence T>
+  requires details::ConstIterable<T>
+__types::Bool All(const __memory::handle_t<T>& sequence) {
+  return All(*sequence);
+}
+
 template <__concepts::Sequence T>
 __types::Bool Contains(const T& sequence,
                        __memory::ReadOnly<typename T::element> value) {
@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <unordered_set>
 #include <utility>
@@ -12,6 +14,7 @@
 #include "mamba/__concepts/entity.hpp"
 #include "mamba/__memory/handle.hpp"
 #include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
 #include "mamba/__memory/read_only.hpp"
 #include "mamba/builtins/__types/int.hpp"
 #include "mamba/builtins/__types/str.hpp"
@@ -30,7 +33,7 @@ class SetIterator;
 }  // namespace details
 
 template <__concepts::Entity T>
-class Set : public std::enable_shared_from_this<Set<T>> {
+class Set : public __memory::EnableHandleFromThis<Set<T>> {
  public:
   /// @note Mamba-specific
   using element = T;
@@ -60,17 +63,8 @@ class Set : public std::enable_shared_from_this<Set<T>> {
   template <typename It>
     requires __concepts::TypedIterable<It, element>
   explicit Set(It& iterable) {
-    bool no_stop_iteration = true;
-    auto it = iterable.Iter();
-
-    while (no_stop_iteration) {
-      try {
-        Add(Next(*it));
-      } catch (StopIteration) {
-        no_stop_iteration = false;
-        break;
-      }
-    }
+    s_.reserve(std::max<__types::Int>(LengthHint(iterable), 0));
+    ForEach(iterable, [this](value_type elem) { Add(std::move(elem)); });
   }
 
   /// @brief Creates a set with the provided variadic arguments.
@@ -250,7 +244,15 @@ class Set : public std::enable_shared_from_this<Set<T>> {
   /// @brief Returns an iterator to this set.
   /// @code set.__iter__()
   __memory::handle_t<Iterator<element>> Iter() {
-    return details::SetIterator<element>::Init(s_.begin(), s_.end());
+    return details::SetIterator<element>::Init(s_.begin(), s_.end(),
+                                                s_.size());
+  }
+
+  /// @brief Returns the concrete iterator to this set by value, which
+  /// ForEach() uses instead of Iter() so that loops can be inlined.
+  /// @note Mamba-specific
+  details::SetIterator<element> StaticIter() const {
+    return {s_.cbegin(), s_.cend(), s_.size()};
   }
 
   /// @brief Native support for C++ for..in loops.
@@ -384,44 +386,61 @@ class Set : public std::enable_shared_from_this<Set<T>> {
 namespace details {
 
 template <__concepts::Entity T>
-class SetIterator : public Iterator<T>,
-                    public std::enable_shared_from_this<SetIterator<T>> {
+class SetIterator final
+    : public Iterator<T>,
+      public __memory::EnableHandleFromThis<SetIterator<T>> {
  public:
   /// @brief Mamba-specific
   using element = T;
 
   using value_type = __memory::managed_t<element>;
-  using iterator = Set<element>::iterator;
+  using iterator = Set<element>::const_iterator;
 
   /// @brief Mamba-specific
   using self = SetIterator<element>;
   using handle = __memory::handle_t<self>;
 
-  SetIterator(iterator it, iterator end)
-      : it_(std::move(it)), end_(std::move(end)) {}
+  // Hash set iterators cannot tell how far apart they are, so @p len is the
+  // number of elements in [@p it, @p end), for LengthHint()
+  SetIterator(iterator it, iterator end, std::size_t len)
+      : it_(std::move(it)), end_(std::move(end)), len_(len) {}
 
   ~SetIterator() override = default;
 
   /// @brief Generic constructor forwarding arguments to actual constructor
-  /// methods.
+  /// methods. Iterators come from the pool of the calling thread.
   /// @code SetIterator.__init__()
+  /// @see pool.hpp
   template <typename... Args>
   static handle Init(Args&&... args) {
-    return __memory::Init<self>(std::forward<Args>(args)...);
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
   }
 
   __memory::handle_t<Iterator<element>> Iter() override {
-    return std::enable_shared_from_this<self>::shared_from_this();
+    return this->HandleFromThis();
   }
 
-  value_type Next() override {
+  std::optional<value_type> TryNext() override {
     if (it_ == end_) {
-      throw StopIteration("end of iterator");
+      return std::nullopt;
     }
 
+    --len_;
+
     return *it_++;
   }
 
+  std::size_t NextBatch(std::span<value_type> out) override {
+    const auto n = details::CopyBatch(it_, end_, out);
+    len_ -= n;
+
+    return n;
+  }
+
+  __types::Int LengthHint() const override {
+    return static_cast<__types::Int>(len_);
+  }
+
   __types::Str Repr() const override { return "SetIterator"; }
 
   bool operator==(const self& other) const {
@@ -436,6 +455,7 @@ class SetIterator : public Iterator<T>,
  private:
   iterator it_;
   iterator end_;
+  std::size_t len_;
 };
 
 }  // namespace details
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <utility>
+
+#include "mamba/__concepts/comparable.hpp"
+#include "mamba/__concepts/entity.hpp"
+#include "mamba/__memory/handle.hpp"
+#include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
+#include "mamba/__memory/read_only.hpp"
+#include "mamba/builtins/__types/int.hpp"
+#include "mamba/builtins/__types/str.hpp"
+#include "mamba/builtins/as_str.hpp"
+#include "mamba/builtins/comparators.hpp"
+#include "mamba/builtins/error.hpp"
+#include "mamba/builtins/iteration.hpp"
+#include "mamba/builtins/repr.hpp"
+
+namespace mamba::builtins {
+
+/// @brief End index of a slice that extends to the end of the sequence.
+/// @note Mamba-specific
+inline constexpr auto kEndIndex = std::numeric_limits<__types::Int>::min();
+
+namespace details {
+
+// Forward declaration
+template <__concepts::Entity T>
+class SliceViewIterator;
+
+/// @brief Random access iterator over every step-th element of a contiguous
+/// buffer. Positions are kept as indices so that the end position never
+/// points beyond the buffer.
+template <typename T>
+class StridedIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const T*;
+  using reference = const T&;
+
+  StridedIterator() = default;
+
+  StridedIterator(const T* base, difference_type idx, difference_type step)
+      : base_(base), idx_(idx), step_(step) {}
+
+  reference operator*() const { return base_[idx_ * step_]; }
+  pointer operator->() const { return &**this; }
+  reference operator[](difference_type n) const {
+    return base_[(idx_ + n) * step_];
+  }
+
+  StridedIterator& operator++() {
+    ++idx_;
+    return *this;
+  }
+
+  StridedIterator operator++(int) {
+    auto res = *this;
+    ++idx_;
+    return res;
+  }
+
+  StridedIterator& operator--() {
+    --idx_;
+    return *this;
+  }
+
+  StridedIterator operator--(int) {
+    auto res = *this;
+    --idx_;
+    return res;
+  }
+
+  StridedIterator& operator+=(difference_type n) {
+    idx_ += n;
+    return *this;
+  }
+
+  StridedIterator& operator-=(difference_type n) {
+    idx_ -= n;
+    return *this;
+  }
+
+  friend StridedIterator operator+(StridedIterator it, difference_type n) {
+    return it += n;
+  }
+
+  friend StridedIterator operator+(difference_type n, StridedIterator it) {
+    return it += n;
+  }
+
+  friend StridedIterator operator-(StridedIterator it, difference_type n) {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const StridedIterator& lhs,
+                                   const StridedIterator& rhs) {
+    return lhs.idx_ - rhs.idx_;
+  }
+
+  friend bool operator==(const StridedIterator& lhs,
+                         const StridedIterator& rhs) {
+    return lhs.idx_ == rhs.idx_;
+  }
+
+  friend std::strong_ordering operator<=>(const StridedIterator& lhs,
+                                          const StridedIterator& rhs) {
+    return lhs.idx_ <=> rhs.idx_;
+  }
+
+ private:
+  const T* base_ = nullptr;
+  difference_type idx_ = 0;
+  difference_type step_ = 1;
+};
+
+}  // namespace details
+
+/// @brief Read-only view of a slice of a list or tuple, i.e. of every step-th
+/// element in [start, end) of its storage. Creating a view copies nothing.
+/// @note Mamba-specific. Like an iterator, a view is invalidated by any
+/// mutation or the destruction of the sequence that it was created from.
+/// Construct a list from the view to keep the elements.
+template <__concepts::Entity T>
+  requires __concepts::LessThanComparable<T>
+class SliceView {
+ public:
+  /// @note Mamba-specific
+  using element = T;
+
+  using value_type = __memory::managed_t<element>;
+  using const_reference = const value_type&;
+  using const_iterator = details::StridedIterator<value_type>;
+  using iterator = const_iterator;
+
+  /// @note Mamba-specific
+  using self = SliceView<element>;
+
+  /// @brief Creates an empty view.
+  SliceView() {}
+
+  /// @brief Creates a view of @p len elements, starting with @p first and
+  /// with @p step elements between each of them.
+  SliceView(const value_type* first, size_t len, size_t step)
+      : first_(first), len_(len), step_(step) {}
+
+  /// @brief Returns whether @p elem is in the slice. O(n).
+  /// @code elem in list[i:j:k]
+  __types::Bool Contains(__memory::ReadOnly<element> elem) const {
+    return std::find(begin(), end(), elem) != end();
+  }
+
+  /// @brief Returns the number of times @p elem is present in the slice.
+  /// @code list[i:j:k].count(x)
+  __types::Int Count(__memory::ReadOnly<element> elem) const {
+    return std::count_if(begin(), end(),
+                         [elem](__memory::ReadOnly<element> val) {
+                           return operators::Eq(val, elem);
+                         });
+  }
+
+  /// @brief Returns the element at index @p idx of the slice. If the index is
+  /// out of range, throws IndexError. @p idx supports negative indices
+  /// counting from the last elements.
+  /// @code list[i:j:k][idx]
+  const_reference operator[](__types::Int idx) const {
+    if (idx < 0) {
+      idx += len_;
+    }
+
+    if (idx < 0 || idx >= static_cast<__types::Int>(len_)) {
+      throw IndexError("slice index out of range");
+    }
+
+    return begin()[idx];
+  }
+
+  /// @brief Returns the number of elements in the slice.
+  /// @code len(list[i:j:k])
+  __types::Int Len() const { return len_; }
+
+  /// @brief Returns the smallest element in the slice. If the slice is empty,
+  /// throws ValueError.
+  /// @code min(list[i:j:k])
+  value_type Min() const {
+    if (len_ == 0) {
+      throw ValueError("Min() arg is an empty sequence");
+    }
+
+    if constexpr (__concepts::Object<element>) {
+      return *std::min_element(
+          begin(), end(),
+          [](const auto a, const auto b) { return operators::Lt(*a, *b); });
+    } else {
+      return *std::min_element(begin(), end());
+    }
+  }
+
+  /// @brief Returns the biggest element in the slice. If the slice is empty,
+  /// throws ValueError.
+  /// @code max(list[i:j:k])
+  value_type Max() const {
+    if (len_ == 0) {
+      throw ValueError("Max() arg is an empty sequence");
+    }
+
+    if constexpr (__concepts::Object<element>) {
+      return *std::max_element(
+          begin(), end(),
+          [](const auto a, const auto b) { return operators::Lt(*a, *b); });
+    } else {
+      return *std::max_element(begin(), end());
+    }
+  }
+
+  /// @brief Returns an iterator to this slice.
+  /// @code iter(list[i:j:k])
+  __memory::handle_t<Iterator<element>> Iter() const {
+    return details::SliceViewIterator<element>::Init(begin(), end());
+  }
+
+  /// @brief Returns the concrete iterator to this slice by value, which
+  /// ForEach() uses instead of Iter() so that loops can be inlined.
+  /// @note Mamba-specific
+  details::SliceViewIterator<element> StaticIter() const {
+    return {begin(), end()};
+  }
+
+  /// @brief Native support for C++ for..in loops.
+  const_iterator begin() const { return const_iterator(first_, 0, step_); }
+  const_iterator end() const { return const_iterator(first_, len_, step_); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  /// @code bool(list[i:j:k])
+  __types::Bool AsBool() const { return len_ != 0; }
+
+  /// @brief Implicit conversion to Bool (C++ bool) for conditionals.
+  /// @code if list[i:j:k]:
+  operator __types::Bool() const { return AsBool(); }
+
+  /// @brief Returns false all the time for all arguments so long as they are
+  /// not a slice of the same type of elements.
+  /// @code list[i:j:k] == other
+  template <typename U>
+  __types::Bool Eq(const U&) const {
+    return false;
+  }
+
+  /// @brief Returns true if this and @p other contain the same elements, and
+  /// false otherwise.
+  /// @code list[i:j:k] == other
+  template <>
+  __types::Bool Eq(const self& other) const {
+    if constexpr (__concepts::Object<element>) {
+      return std::equal(
+          begin(), end(), other.begin(), other.end(),
+          [](const auto a, const auto b) { return operators::Eq(*a, *b); });
+    } else {
+      return std::equal(begin(), end(), other.begin(), other.end());
+    }
+  }
+
+  /// @brief Native support for C++ == and != operators.
+  template <typename U>
+  bool operator==(const U& other) const {
+    return Eq(other);
+  }
+
+  template <typename U>
+  bool operator!=(const U& other) const {
+    return !Eq(other);
+  }
+
+  /// @brief Returns the string representation of the slice, which is that of
+  /// the list it would materialize into.
+  /// @code str(list[i:j:k])
+  __types::Str AsStr() const {
+    std::ostringstream oss;
+
+    oss << "[";
+
+    for (size_t i = 0; i < len_; ++i) {
+      oss << (i ? ", " : "") << builtins::AsStr(begin()[i]);
+    }
+
+    oss << "]";
+
+    return oss.str();
+  }
+
+  /// @brief Returns the representation of the slice, which is that of the
+  /// list it would materialize into.
+  /// @code repr(list[i:j:k])
+  __types::Str Repr() const {
+    std::ostringstream oss;
+
+    oss << "[";
+
+    for (size_t i = 0; i < len_; ++i) {
+      oss << (i ? ", " : "") << builtins::Repr(begin()[i]);
+    }
+
+    oss << "]";
+
+    return oss.str();
+  }
+
+ private:
+  const value_type* first_ = nullptr;
+  size_t len_ = 0;
+  size_t step_ = 1;
+};
+
+namespace details {
+
+template <__concepts::Entity T>
+class SliceViewIterator final
+    : public Iterator<T>,
+      public __memory::EnableHandleFromThis<SliceViewIterator<T>> {
+ public:
+  /// @brief Mamba-specific
+  using element = T;
+
+  using value_type = __memory::managed_t<element>;
+  using iterator = SliceView<element>::const_iterator;
+
+  /// @brief Mamba-specific
+  using self = SliceViewIterator<element>;
+  using handle = __memory::handle_t<self>;
+
+  SliceViewIterator(iterator it, iterator end)
+      : it_(std::move(it)), end_(std::move(end)) {}
+
+  ~SliceViewIterator() override = default;
+
+  /// @brief Generic constructor forwarding arguments to actual constructor
+  /// methods. Iterators come from the pool of the calling thread.
+  /// @code SliceViewIterator.__init__()
+  /// @see pool.hpp
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
+  }
+
+  __memory::handle_t<Iterator<element>> Iter() override {
+    return this->HandleFromThis();
+  }
+
+  std::optional<value_type> TryNext() override {
+    if (it_ == end_) {
+      return std::nullopt;
+    }
+
+    return *it_++;
+  }
+
+  std::size_t NextBatch(std::span<value_type> out) override {
+    return details::CopyBatch(it_, end_, out);
+  }
+
+  __types::Int LengthHint() const override {
+    return details::RemainingLength(it_, end_);
+  }
+
+  __types::Str Repr() const override { return "SliceViewIterator"; }
+
+ private:
+  iterator it_;
+  iterator end_;
+};
+
+}  // namespace details
+
+}  // namespace mamba::builtins
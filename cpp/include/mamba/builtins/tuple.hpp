@@ -2,11 +2,12 @@
 
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
-#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -15,7 +16,10 @@
 #include "mamba/__concepts/entity.hpp"
 #include "mamba/__memory/handle.hpp"
 #include "mamba/__memory/managed.hpp"
+#include "mamba/__memory/pool.hpp"
 #include "mamba/__memory/read_only.hpp"
+#include "mamba/__utils/reduce.hpp"
+#include "mamba/__utils/simd.hpp"
 #include "mamba/builtins/__types/int.hpp"
 #include "mamba/builtins/__types/str.hpp"
 #include "mamba/builtins/as_str.hpp"
@@ -23,6 +27,7 @@
 #include "mamba/builtins/error.hpp"
 #include "mamba/builtins/iteration.hpp"
 #include "mamba/builtins/repr.hpp"
+#include "mamba/builtins/slice_view.hpp"
 
 namespace mamba::builtins {
 
@@ -56,7 +61,7 @@ class TupleIterator;
 template <typename T, typename... Elems>
   requires details::Homogenous<T, Elems...> && __concepts::Entity<T> &&
            __concepts::LessThanComparable<T>
-class Tuple : public std::enable_shared_from_this<Tuple<T>> {
+class Tuple : public __memory::EnableHandleFromThis<Tuple<T>> {
  public:
   /// @note Mamba-specific
   using element = T;
@@ -68,14 +73,14 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
   /// @note Mamba-specific
   using storage = std::vector<value>;
 
-  using iterator = storage::iterator;
+  using iterator = storage::const_iterator;
   using const_iterator = storage::const_iterator;
 
   /// @note Mamba-specific
   using self = Tuple<element>;
   using handle = __memory::handle_t<self>;
 
-  static constexpr auto kEndIndex = std::numeric_limits<__types::Int>::min();
+  static constexpr auto kEndIndex = builtins::kEndIndex;
 
   /// @brief Creates an empty tuple.
   /// @code tuple()
@@ -85,19 +90,31 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
   /// are copied.
   /// @code tuple(Iterable)
   template <typename It>
-    requires __concepts::TypedIterable<It, element>
+    requires __concepts::TypedIterable<It, element> &&
+             (!std::same_as<It, SliceView<element>>)
   explicit Tuple(It& iterable) {
-    bool no_stop_iteration = true;
-    auto it = iterable.Iter();
-
-    while (no_stop_iteration) {
-      try {
-        Append(Next(*it));
-      } catch (StopIteration) {
-        no_stop_iteration = false;
-        break;
-      }
-    }
+    v_.reserve(std::max<__types::Int>(LengthHint(iterable), 0));
+    ForEach(iterable, [this](value elem) { Append(std::move(elem)); });
+  }
+
+  /// @brief Creates a tuple with the remaining elements of @p it, e.g. of a
+  /// pipeline of adaptors.
+  /// @code tuple(map(f, iterable))
+  /// @see adaptors.hpp
+  template <__concepts::StaticIterator It>
+    requires std::convertible_to<typename It::value_type, value> &&
+             (!__concepts::TypedIterable<It, element>)
+  explicit Tuple(It it) {
+    v_.reserve(std::max<__types::Int>(LengthHint(it), 0));
+    ForEach(it, [this](value elem) { Append(std::move(elem)); });
+  }
+
+  /// @brief Creates a tuple with the elements of @p view.
+  /// @code tuple(tuple[i:j:k])
+  explicit Tuple(const SliceView<element>& view) {
+    v_.reserve(view.Len());
+
+    std::copy(view.begin(), view.end(), std::back_inserter(v_));
   }
 
   /// @brief Creates a tuple with the provided variadic arguments.
@@ -129,15 +146,25 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
     return __memory::Init<self>(std::forward<Args>(args)...);
   }
 
-  /// @brief Returns whether @p elem is in the tuple. O(n).
+  /// @brief Returns whether @p elem is in the tuple. O(n), vectorized for
+  /// Int and Float elements.
   /// @code elem in tuple
   __types::Bool Contains(__memory::ReadOnly<element> elem) const {
-    return std::find(v_.cbegin(), v_.cend(), elem) != v_.cend();
+    if constexpr (kVectorizedSearch) {
+      return __utils::FindEqual(Elements(), elem) != v_.size();
+    } else {
+      return std::find(v_.cbegin(), v_.cend(), elem) != v_.cend();
+    }
   }
 
   /// @brief Creates a shallow copy of the tuple.
   /// @code tuple.copy()
   handle Copy() const {
+    // Tuples are immutable, so a copy can be the same tuple
+    if (auto res = this->TryHandleFromThis()) {
+      return res;
+    }
+
     // Invoke copy constructor
     return Init(*this);
   }
@@ -187,7 +214,7 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
   __types::Int Len() const { return v_.size(); }
 
   /// @brief Returns the smallest element in the tuple. If the tuple is empty,
-  /// throws ValueError.
+  /// throws ValueError. Vectorized for Int and Float elements.
   /// @code min(tuple)
   value Min() const {
     if (v_.empty()) {
@@ -198,13 +225,15 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
       return *std::min_element(
           v_.cbegin(), v_.cend(),
           [](const auto a, const auto b) { return operators::Lt(*a, *b); });
+    } else if constexpr (kVectorizedSearch) {
+      return __utils::Min(Elements());
     } else {
       return *std::min_element(v_.cbegin(), v_.cend());
     }
   }
 
   /// @brief Returns the biggest element in the tuple. If the tuple is empty,
-  /// throws ValueError.
+  /// throws ValueError. Vectorized for Int and Float elements.
   /// @code max(tuple)
   value Max() const {
     if (v_.empty()) {
@@ -215,18 +244,25 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
       return *std::max_element(
           v_.cbegin(), v_.cend(),
           [](const auto a, const auto b) { return operators::Lt(*a, *b); });
+    } else if constexpr (kVectorizedSearch) {
+      return __utils::Max(Elements());
     } else {
       return *std::max_element(v_.cbegin(), v_.cend());
     }
   }
 
   /// @brief Returns the number of times @p elem is present in the tuple.
+  /// Vectorized for Int and Float elements.
   /// @code tuple.count(x)
   __types::Int Count(__memory::ReadOnly<element> elem) const {
-    return std::count_if(v_.cbegin(), v_.cend(),
-                         [elem](__memory::ReadOnly<element> val) {
-                           return operators::Eq(val, elem);
-                         });
+    if constexpr (kVectorizedSearch) {
+      return static_cast<__types::Int>(__utils::CountEqual(Elements(), elem));
+    } else {
+      return std::count_if(v_.cbegin(), v_.cend(),
+                           [elem](__memory::ReadOnly<element> val) {
+                             return operators::Eq(val, elem);
+                           });
+    }
   }
 
   /// @brief Returns the elements in the tuple such that the elements' indices
@@ -238,49 +274,30 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
   handle Slice(__types::Int start = 0,
                __types::Int end = kEndIndex,
                __types::Int step = 1) const {
-    auto res = Init();
+    return Init(View(start, end, step));
+  }
 
-    auto slice_params_opt = TryGetNormalizedSliceParams(start, end, step);
+  /// @brief Returns a read-only view of the elements that Slice() would
+  /// return, without copying them. The view is invalidated by any mutation
+  /// or the destruction of this tuple.
+  /// @code tuple[i:j:k]
+  SliceView<element> View(__types::Int start = 0,
+                          __types::Int end = kEndIndex,
+                          __types::Int step = 1) const {
+    const auto slice_params_opt = TryGetNormalizedSliceParams(start, end, step);
 
     if (!slice_params_opt) {
-      return res;
+      return {};
     }
 
     const auto size_t_start = slice_params_opt->start;
     const auto size_t_end = slice_params_opt->end;
     const auto size_t_step = slice_params_opt->step;
 
-    // Simple range copy
-    if (size_t_step == 1) {
-      res->v_.reserve(size_t_end - size_t_start);
-
-      // Need to recalculate in case reserve() invalidated the pre-calculated
-      // iterators
-      const auto start_it = v_.begin() + size_t_start;
-      const auto end_it = v_.begin() + size_t_end;
-
-      std::copy(start_it, end_it, std::back_inserter(res->v_));
-
-      return res;
-    }
-
-    // Stepped range copy
-    res->v_.reserve(
-        GetNumberOfElementsInSlice(size_t_start, size_t_end, size_t_step));
-
-    // Need to recalculate in case reserve() invalidated the pre-calculated
-    // iterators
-    const auto start_it = v_.begin() + size_t_start;
-    const auto end_it = v_.begin() + size_t_end;
-
-    size_t i = 0;
-
-    std::copy_if(start_it, end_it, std::back_inserter(res->v_),
-                 [&i, size_t_step](const auto) -> bool {
-                   return i++ % size_t_step == 0;
-                 });
-
-    return res;
+    return SliceView<element>(
+        std::to_address(slice_params_opt->start_it),
+        GetNumberOfElementsInSlice(size_t_start, size_t_end, size_t_step),
+        size_t_step);
   }
 
 #if __cplusplus >= 202302L
@@ -312,10 +329,23 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
                      __types::Int start,
                      __types::Int end) const {
     end = ClampIndex(end);
+    start = ClampIndex(start);
+
+    if constexpr (kVectorizedSearch) {
+      if (start < end) {
+        const auto idx =
+            start + static_cast<__types::Int>(__utils::FindEqual(
+                        Elements().subspan(start, end - start), elem));
 
-    for (__types::Int idx = ClampIndex(start); idx < end; ++idx) {
-      if (v_[idx] == elem) {
-        return idx;
+        if (idx < end) {
+          return idx;
+        }
+      }
+    } else {
+      for (__types::Int idx = start; idx < end; ++idx) {
+        if (v_[idx] == elem) {
+          return idx;
+        }
       }
     }
 
@@ -325,12 +355,17 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
   /// @brief Returns an iterator to this tuple.
   /// @code tuple.__iter__()
   __memory::handle_t<Iterator<element>> Iter() {
-    return details::TupleIterator<element>::Init(v_.begin(), v_.end());
+    return details::TupleIterator<element>::Init(v_.cbegin(), v_.cend());
+  }
+
+  /// @brief Returns the concrete iterator to this tuple by value, which
+  /// ForEach() uses instead of Iter() so that loops can be inlined.
+  /// @note Mamba-specific
+  details::TupleIterator<element> StaticIter() const {
+    return {v_.cbegin(), v_.cend()};
   }
 
   /// @brief Native support for C++ for..in loops.
-  iterator begin() { return v_.begin(); }
-  iterator end() { return v_.end(); }
   const_iterator begin() const { return v_.cbegin(); }
   const_iterator end() const { return v_.cend(); }
   const_iterator cbegin() const { return v_.cbegin(); }
@@ -436,6 +471,16 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
   }
 
  private:
+  // Whether Contains(), Count(), Index(), Min() and Max() go through the
+  // vectorized kernels of simd.hpp rather than one element at a time
+  static constexpr bool kVectorizedSearch =
+      __utils::SimdElement<value> &&
+      std::contiguous_iterator<const_iterator>;
+
+  std::span<const value> Elements() const {
+    return {v_.cbegin(), v_.cend()};
+  }
+
   /// @brief Appends @p elem to the end of the tuple.
   /// @code tuple.append(elem)
   void Append(__memory::ReadOnly<element> elem) { v_.emplace_back(elem); }
@@ -447,6 +492,13 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
     (Append(std::forward<Args>(rest)), ...);
   }
 
+  /// @brief Appends the elements of @p other to the end of the tuple.
+  void Extend(const self& other) {
+    v_.reserve(v_.size() + other.v_.size());
+
+    std::copy(other.v_.cbegin(), other.v_.cend(), std::back_inserter(v_));
+  }
+
   size_t ClampIndex(__types::Int idx) const {
     if (idx < 0) {
       return 0;
@@ -481,8 +533,6 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
     return TryGetNormalizedIndex(idx).value_or(ClampIndex(idx));
   }
 
-  iterator GetIterator(size_t idx) { return v_.begin() + idx; }
-
   const_iterator GetIterator(size_t idx) const { return v_.cbegin() + idx; }
 
   std::optional<std::pair<size_t, size_t>> TryGetNormalizedSliceIndices(
@@ -542,32 +592,15 @@ class Tuple : public std::enable_shared_from_this<Tuple<T>> {
         GetIterator(size_t_start), GetIterator(size_t_end)};
   }
 
-  std::optional<SliceParams<iterator>> TryGetNormalizedSliceParams(
-      __types::Int start,
-      __types::Int end,
-      __types::Int step) {
-    const auto indices_opt = TryGetNormalizedSliceIndices(start, end, step);
-
-    if (!indices_opt) {
-      return std::nullopt;
-    }
-
-    const auto size_t_start = indices_opt->first;
-    const auto size_t_end = indices_opt->second;
-
-    return SliceParams<iterator>{
-        size_t_start, size_t_end, static_cast<size_t>(step),
-        GetIterator(size_t_start), GetIterator(size_t_end)};
-  }
-
   storage v_;
 };
 
 namespace details {
 
 template <__concepts::Entity T>
-class TupleIterator : public Iterator<T>,
-                      public std::enable_shared_from_this<TupleIterator<T>> {
+class TupleIterator final
+    : public Iterator<T>,
+      public __memory::EnableHandleFromThis<TupleIterator<T>> {
  public:
   /// @brief Mamba-specific
   using element = T;
@@ -585,25 +618,34 @@ class TupleIterator : public Iterator<T>,
   ~TupleIterator() override = default;
 
   /// @brief Generic constructor forwarding arguments to actual constructor
-  /// methods.
+  /// methods. Iterators come from the pool of the calling thread.
   /// @code TupleIterator.__init__()
+  /// @see pool.hpp
   template <typename... Args>
   static handle Init(Args&&... args) {
-    return __memory::Init<self>(std::forward<Args>(args)...);
+    return __memory::InitPooled<self>(std::forward<Args>(args)...);
   }
 
   __memory::handle_t<Iterator<element>> Iter() override {
-    return std::enable_shared_from_this<self>::shared_from_this();
+    return this->HandleFromThis();
   }
 
-  value_type Next() override {
+  std::optional<value_type> TryNext() override {
     if (it_ == end_) {
-      throw StopIteration("end of iterator");
+      return std::nullopt;
     }
 
     return *it_++;
   }
 
+  std::size_t NextBatch(std::span<value_type> out) override {
+    return details::CopyBatch(it_, end_, out);
+  }
+
+  __types::Int LengthHint() const override {
+    return details::RemainingLength(it_, end_);
+  }
+
   __types::Str Repr() const override { return "TupleIterator"; }
 
   bool operator==(const self& other) const {
@@ -0,0 +1,289 @@
+#include <ranges>   // for input_range
+#include <tuple>    // for tuple
+#include <utility>  // for declval, move
+#include <vector>   // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/__memory/handle.hpp"      // for handle_t
+#include "mamba/builtins/adaptors.hpp"    // for Map, Filter, Zip, Enumerate
+#include "mamba/builtins/generator.hpp"   // for Generator
+#include "mamba/builtins/int.hpp"         // for Int
+#include "mamba/builtins/iteration.hpp"   // for ForEach, Iter, LengthHint
+#include "mamba/builtins/list.hpp"        // for List
+#include "mamba/builtins/slice_view.hpp"  // for kEndIndex
+#include "mamba/builtins/tuple.hpp"       // for Tuple
+
+namespace mamba::builtins::test {
+namespace {
+
+template <typename It>
+std::vector<typename It::value_type> drain(It it) {
+  std::vector<typename It::value_type> res;
+  ForEach(it, [&res](auto elem) { res.emplace_back(elem); });
+
+  return res;
+}
+
+// def doubled(xs: list[int]) -> Iterator[int]:
+//     yield from map(lambda v: v * 2, xs)
+Generator<Int>::handle Doubled(List<Int>::handle xs) {
+  for (const auto elem : Map([&](auto v) { return v * 2; }, xs)) {
+    co_yield elem;
+  }
+}
+
+// def scaled(xs: list[int], k: int) -> Iterator[int]:
+//     return map(lambda v: v * k, (v + k for v in xs))
+Generator<Int>::handle Scaled(List<Int>::handle xs, Int k) {
+  for (const auto elem : Map([=](auto v) { return v * k; },
+                             Map([=](auto v) { return v + k; }, xs))) {
+    co_yield elem;
+  }
+  co_return;
+}
+
+}  // anonymous namespace
+
+TEST(Adaptors, Map) {
+  // If
+  const List<Int> l = {1, 3, 5};
+
+  // When
+  auto it = Map([](Int i) { return i * 2; }, l);
+
+  // Then
+  const std::vector<Int> expected = {2, 6, 10};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, MapHandle) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+
+  // When
+  auto it = Map([](Int i) { return i + 1; }, l);
+
+  // Then
+  const std::vector<Int> expected = {2, 4, 6};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, MapTypeErasedIterator) {
+  // If
+  List<Int> l = {1, 3, 5};
+  const auto erased = Iter(l);
+
+  // When
+  auto it = Map([](Int i) { return i + 1; }, erased);
+
+  // Then
+  const std::vector<Int> expected = {2, 4, 6};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, Filter) {
+  // If
+  const List<Int> l = {1, 2, 3, 4, 5};
+
+  // When
+  auto it = Filter([](Int i) { return i % 2; }, l);
+
+  // Then
+  const std::vector<Int> expected = {1, 3, 5};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, ZipStopsAtShortest) {
+  // If
+  const List<Int> l = {1, 3, 5};
+  const Tuple<Int> t = {2, 4};
+
+  // When
+  auto it = Zip(l, t);
+
+  // Then
+  const std::vector<std::tuple<Int, Int>> expected = {{1, 2}, {3, 4}};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, Enumerate) {
+  // If
+  const List<Int> l = {7, 9};
+
+  // When
+  auto it = Enumerate(l, 1);
+
+  // Then
+  const std::vector<std::tuple<Int, Int>> expected = {{1, 7}, {2, 9}};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, Reversed) {
+  // If
+  const List<Int> l = {1, 3, 5, 7, 9};
+
+  // When
+  auto it = Reversed(l.View(0, kEndIndex, 2));
+
+  // Then
+  const std::vector<Int> expected = {9, 5, 1};
+  EXPECT_EQ(drain(it), expected);
+}
+
+TEST(Adaptors, Pipeline) {
+  // If
+  const List<Int> l = {1, 2, 3, 4, 5, 6};
+
+  const auto is_even = [](Int i) { return i % 2 == 0; };
+  const auto product = [](const auto& pair) {
+    return std::get<0>(pair) * std::get<1>(pair);
+  };
+
+  // When
+  const auto actual = List<Int>::Init(
+      Map(product, Enumerate(Filter(is_even, Reversed(l)))));
+
+  // Then
+  EXPECT_EQ(actual->Len(), 3);
+  EXPECT_EQ((*actual)[0], 0);
+  EXPECT_EQ((*actual)[1], 4);
+  EXPECT_EQ((*actual)[2], 4);
+}
+
+TEST(Adaptors, ConsumedOnce) {
+  // If
+  const List<Int> l = {1, 3, 5};
+  auto it = Map([](Int i) { return i; }, l);
+
+  // When
+  Int count = 0;
+  ForEach(it, [&count](Int) { ++count; });
+  ForEach(it, [&count](Int) { ++count; });
+
+  // Then
+  EXPECT_EQ(count, 3);
+}
+
+TEST(Adaptors, LengthHint) {
+  // If
+  List<Int> l = {1, 3, 5};
+  List<Int> shorter = {2, 4};
+  const auto identity = [](Int elem) { return elem; };
+
+  // When
+  auto mapped = Map(identity, l);
+  mapped.TryNext();
+
+  // Then
+  EXPECT_EQ(LengthHint(Map(identity, l)), 3);
+  EXPECT_EQ(LengthHint(mapped), 2);
+  EXPECT_EQ(LengthHint(Map(identity, Iter(l))), 3);
+  EXPECT_EQ(LengthHint(Enumerate(l)), 3);
+  EXPECT_EQ(LengthHint(Zip(l, shorter)), 2);
+  EXPECT_EQ(LengthHint(Reversed(l)), 3);
+
+  // Filters cannot tell how many elements they will keep
+  EXPECT_EQ(LengthHint(Filter(identity, l)), 0);
+}
+
+TEST(Adaptors, IsInputRange) {
+  // If/when/then
+  const auto identity = [](Int elem) { return elem; };
+
+  using map_type = decltype(Map(identity, std::declval<List<Int>&>()));
+  using zip_type = decltype(Zip(std::declval<List<Int>&>()));
+
+  static_assert(std::ranges::input_range<map_type>);
+  static_assert(std::ranges::input_range<zip_type>);
+}
+
+// The loops below are those that the transpiler emits for loops over map(),
+// filter(), zip(), enumerate(), reversed() and generator expressions, see
+// python/test/test_transpiler.py
+TEST(Adaptors, RangeBasedForLoops) {
+  // If
+  const auto xs = List<Int>::Init(1, 2, 3);
+  const auto ys = List<Int>::Init(4, 5);
+
+  std::vector<Int> mapped;
+  std::vector<Int> filtered;
+  std::vector<Int> zipped;
+  std::vector<Int> enumerated;
+  std::vector<Int> reversed;
+  std::vector<Int> generated;
+
+  // When
+  for (const auto z : Map([&](auto v) { return v * 2; }, xs)) {
+    mapped.emplace_back(z);
+  }
+
+  for (const auto z : Filter([&](auto v) { return v > 1; }, xs)) {
+    filtered.emplace_back(z);
+  }
+
+  for (const auto [a, b] : Zip(xs, ys)) {
+    zipped.emplace_back(a * b);
+  }
+
+  for (const auto [i, y] : Enumerate(ys)) {
+    enumerated.emplace_back(i + y);
+  }
+
+  for (const auto z : Reversed(xs)) {
+    reversed.emplace_back(z);
+  }
+
+  for (const auto z : Map([&](auto v) { return v * 10; },
+                          Filter([&](auto v) { return v != 2; }, xs))) {
+    generated.emplace_back(z);
+  }
+
+  // Then
+  EXPECT_EQ(mapped, (std::vector<Int>{2, 4, 6}));
+  EXPECT_EQ(filtered, (std::vector<Int>{2, 3}));
+  EXPECT_EQ(zipped, (std::vector<Int>{4, 10}));
+  EXPECT_EQ(enumerated, (std::vector<Int>{4, 6}));
+  EXPECT_EQ(reversed, (std::vector<Int>{3, 2, 1}));
+  EXPECT_EQ(generated, (std::vector<Int>{10, 30}));
+}
+
+TEST(Adaptors, YieldFrom) {
+  // If
+  const auto xs = List<Int>::Init(1, 2, 3);
+
+  // When
+  std::vector<Int> actual;
+  ForEach(Doubled(xs), [&actual](Int elem) { actual.emplace_back(elem); });
+
+  // Then
+  EXPECT_EQ(actual, (std::vector<Int>{2, 4, 6}));
+}
+
+TEST(Adaptors, KeepHandlesToTheirSources) {
+  // If
+  auto xs = List<Int>::Init(1, 2, 3);
+
+  // When
+  auto doubled = Map([](Int v) { return v * 2; }, xs);
+  auto reversed = Reversed(xs);
+  xs = nullptr;
+
+  // Then
+  EXPECT_EQ(drain(std::move(doubled)), (std::vector<Int>{2, 4, 6}));
+  EXPECT_EQ(drain(std::move(reversed)), (std::vector<Int>{3, 2, 1}));
+}
+
+TEST(Adaptors, ReturnedPipeline) {
+  // If/when
+  // Nothing else refers to the list once Scaled() returns
+  const auto scaled = Scaled(List<Int>::Init(1, 2, 3), 10);
+
+  // Then
+  std::vector<Int> actual;
+  ForEach(scaled, [&actual](Int elem) { actual.emplace_back(elem); });
+
+  EXPECT_EQ(actual, (std::vector<Int>{110, 120, 130}));
+}
+
+}  // namespace mamba::builtins::test
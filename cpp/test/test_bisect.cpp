@@ -0,0 +1,158 @@
+#include <algorithm>  // for lower_bound, upper_bound, is_sorted
+#include <vector>     // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/__memory/storage.hpp"  // for CopyOnWriteStorage
+#include "mamba/builtins/bisect.hpp"   // for BisectLeft, InsortRight, Insort
+#include "mamba/builtins/bool.hpp"     // for Bool
+#include "mamba/builtins/error.hpp"    // for ValueError
+#include "mamba/builtins/float.hpp"    // for Float
+#include "mamba/builtins/int.hpp"      // for Int
+#include "mamba/builtins/list.hpp"     // for List
+
+namespace mamba::builtins::test {
+
+TEST(Bisect, BisectEmpty) {
+  // If
+  const List<Int> l;
+
+  // When/then
+  EXPECT_EQ(BisectLeft(l, 1), 0);
+  EXPECT_EQ(BisectRight(l, 1), 0);
+}
+
+TEST(Bisect, BisectWithDuplicates) {
+  // If
+  const List<Int> l = {1, 2, 2, 2, 3, 5};
+
+  // When/then
+  EXPECT_EQ(BisectLeft(l, 2), 1);
+  EXPECT_EQ(BisectRight(l, 2), 4);
+  EXPECT_EQ(Bisect(l, 2), 4);
+  EXPECT_EQ(BisectLeft(l, 0), 0);
+  EXPECT_EQ(BisectLeft(l, 4), 5);
+  EXPECT_EQ(BisectRight(l, 5), 6);
+  EXPECT_EQ(BisectRight(l, 6), 6);
+}
+
+TEST(Bisect, BisectMatchesStdBounds) {
+  // If
+  std::vector<Int> v;
+  List<Int> l;
+
+  for (Int i = 0; i < 1000; ++i) {
+    v.emplace_back(i / 3 * 2);
+    l.Append(i / 3 * 2);
+  }
+
+  // When/then
+  for (Int n = 0; n <= 1000; n += 37) {
+    for (Int x = -1; x < 700; ++x) {
+      const auto lower = std::lower_bound(v.begin(), v.begin() + n, x);
+      const auto upper = std::upper_bound(v.begin(), v.begin() + n, x);
+
+      ASSERT_EQ(BisectLeft(l, x, 0, n), lower - v.begin());
+      ASSERT_EQ(BisectRight(l, x, 0, n), upper - v.begin());
+    }
+  }
+}
+
+TEST(Bisect, BisectBounds) {
+  // If
+  const List<Int> l = {1, 2, 3, 4, 5};
+
+  // When/then
+  EXPECT_EQ(BisectLeft(l, 1, 2), 2);
+  EXPECT_EQ(BisectLeft(l, 5, 0, 3), 3);
+  EXPECT_EQ(BisectLeft(l, 5, 10), 5);
+  EXPECT_EQ(BisectLeft(l, 5, 3, 1), 3);
+  EXPECT_EQ(BisectLeft(l, 5, 0, 100), 4);
+  EXPECT_THROW(BisectLeft(l, 5, -1), ValueError);
+}
+
+TEST(Bisect, BisectWithKey) {
+  // If
+  const List<Int> l = {5, 4, 4, 1};
+  const auto negate = [](Int elem) { return -elem; };
+
+  // When/then
+  EXPECT_EQ(BisectLeft(l, -4, negate), 1);
+  EXPECT_EQ(BisectRight(l, -4, negate), 3);
+  EXPECT_EQ(Bisect(l, -4, negate), 3);
+}
+
+TEST(Bisect, BisectFloatAndBool) {
+  // If
+  const List<Float> f = {-1.5, 0.0, 0.5, 2.0};
+  const List<Bool> b = {false, false, true};
+
+  // When/then
+  EXPECT_EQ(BisectLeft(f, 0.5), 2);
+  EXPECT_EQ(BisectRight(f, 0.5), 3);
+  EXPECT_EQ(BisectLeft(b, true), 2);
+  EXPECT_EQ(BisectRight(b, false), 2);
+}
+
+TEST(Bisect, InsortKeepsListSorted) {
+  // If
+  List<Int> l;
+  unsigned int seed = 12345;
+
+  // When
+  for (Int i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245 + 12345;
+
+    if (i % 2 == 0) {
+      InsortLeft(l, static_cast<Int>((seed >> 16) % 100));
+    } else {
+      Insort(l, static_cast<Int>((seed >> 16) % 100));
+    }
+  }
+
+  // Then
+  EXPECT_EQ(l.Len(), 1000);
+  EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend()));
+}
+
+TEST(Bisect, InsortWithKeyIsStable) {
+  // If
+  List<Int> l = {30, 21, 12};
+  const auto last_digit = [](Int elem) { return elem % 10; };
+
+  // When
+  InsortRight(l, 11, last_digit);
+  InsortLeft(l, 1, last_digit);
+  InsortRight(l, 40, last_digit, 0, 1);
+
+  // Then
+  EXPECT_EQ(l, (List<Int>{30, 40, 1, 21, 11, 12}));
+}
+
+TEST(Bisect, InsortHandle) {
+  // If
+  const auto l = List<Int>::Init(1, 3);
+
+  // When
+  Insort(l, 2);
+  InsortLeft(l, 0);
+
+  // Then
+  EXPECT_EQ(*l, (List<Int>{0, 1, 2, 3}));
+  EXPECT_EQ(BisectRight(l, 3), 4);
+}
+
+TEST(Bisect, InsortCopyOnWriteDetaches) {
+  // If
+  List<Int, __memory::CopyOnWriteStorage> l = {1, 3};
+  const auto copy = l.Copy();
+
+  // When
+  Insort(l, 2);
+
+  // Then
+  EXPECT_EQ(l.Len(), 3);
+  EXPECT_EQ(copy->Len(), 2);
+}
+
+}  // namespace mamba::builtins::test
@@ -0,0 +1,360 @@
+#include <deque>     // for deque
+#include <optional>  // for nullopt
+#include <span>      // for span
+#include <string>    // for basic_string
+#include <utility>   // for forward
+#include <vector>    // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/__memory/handle.hpp"       // for handle_t, Init
+#include "mamba/builtins/__types/str.hpp"  // for Str
+#include "mamba/builtins/bool.hpp"         // for Bool
+#include "mamba/builtins/deque.hpp"        // for Deque
+#include "mamba/builtins/error.hpp"        // for IndexError, ValueError
+#include "mamba/builtins/float.hpp"        // for Float
+#include "mamba/builtins/int.hpp"          // for Int
+#include "mamba/builtins/iteration.hpp"    // for Iter, NextBatch, ForEach
+#include "mamba/builtins/list.hpp"         // for List
+#include "mamba/builtins/object.hpp"       // for Object
+#include "mamba/builtins/sequence.hpp"     // for Sum, Min, Max, Any, All
+
+namespace mamba::builtins::test {
+namespace {
+
+struct IntWrapper : public Object,
+                    public __memory::EnableHandleFromThis<IntWrapper> {
+ public:
+  using self = IntWrapper;
+  using handle = __memory::handle_t<self>;
+
+  IntWrapper(Int value) : v_(value) {}
+
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::Init<self>(std::forward<Args>(args)...);
+  }
+
+  Int Value() const { return v_; }
+
+  __types::Str Repr() const override { return "IntWrapper"; }
+
+  Bool Eq(const self& other) const { return v_ == other.v_; }
+  Bool Eq(const handle& other) const { return v_ == other->v_; }
+  Bool Lt(const self& other) const { return v_ < other.v_; }
+  Bool Lt(const handle& other) const { return v_ < other->v_; }
+
+ private:
+  Int v_;
+};
+
+template <typename T>
+std::vector<T> as_vector(const Deque<T>& d) {
+  std::vector<T> res;
+
+  for (Int i = 0; i < d.Len(); ++i) {
+    res.emplace_back(d[i]);
+  }
+
+  return res;
+}
+
+}  // anonymous namespace
+
+TEST(Deque, EmptyConstructor) {
+  // If/when
+  const Deque<Int> d;
+
+  // Then
+  EXPECT_EQ(d.Len(), 0);
+  EXPECT_FALSE(d);
+  EXPECT_EQ(d.MaxLen(), std::nullopt);
+}
+
+TEST(Deque, InitializerListConstructorWithMaxLen) {
+  // If/when
+  const Deque<Int> d({1, 3, 5, 7}, 3);
+
+  // Then
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{3, 5, 7}));
+  EXPECT_EQ(d.MaxLen(), 3);
+  EXPECT_THROW(Deque<Int>({1}, -1), ValueError);
+}
+
+TEST(Deque, IterableConstructor) {
+  // If
+  List<Int> l = {1, 3, 5};
+
+  // When
+  const Deque<Int> d(l);
+
+  // Then
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{1, 3, 5}));
+}
+
+TEST(Deque, AppendAndPopAtBothEnds) {
+  // If
+  Deque<Int> d;
+
+  // When
+  d.Append(2);
+  d.Append(3);
+  d.AppendLeft(1);
+  d.AppendLeft(0);
+
+  // Then
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{0, 1, 2, 3}));
+  EXPECT_EQ(d[-1], 3);
+  EXPECT_EQ(d.PopLeft(), 0);
+  EXPECT_EQ(d.Pop(), 3);
+  EXPECT_EQ(d.PopLeft(), 1);
+  EXPECT_EQ(d.Pop(), 2);
+  EXPECT_THROW(d.Pop(), IndexError);
+  EXPECT_THROW(d.PopLeft(), IndexError);
+}
+
+TEST(Deque, MatchesStdDequeAcrossBlocks) {
+  // If
+  Deque<Int> d;
+  std::deque<Int> expected;
+  unsigned int seed = 12345;
+
+  // When
+  for (Int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+
+    switch ((seed >> 16) % 5) {
+      case 0:
+      case 1:
+        d.Append(i);
+        expected.push_back(i);
+        break;
+      case 2:
+        d.AppendLeft(i);
+        expected.push_front(i);
+        break;
+      case 3:
+        if (!expected.empty()) {
+          EXPECT_EQ(d.Pop(), expected.back());
+          expected.pop_back();
+        }
+        break;
+      default:
+        if (!expected.empty()) {
+          EXPECT_EQ(d.PopLeft(), expected.front());
+          expected.pop_front();
+        }
+        break;
+    }
+  }
+
+  // Then
+  EXPECT_EQ(as_vector(d), std::vector<Int>(expected.begin(), expected.end()));
+}
+
+TEST(Deque, FifoReusesBlocks) {
+  // If
+  Deque<Int> d;
+
+  // When
+  for (Int i = 0; i < 100000; ++i) {
+    d.Append(i);
+
+    if (d.Len() > 100) {
+      EXPECT_EQ(d.PopLeft(), i - 100);
+    }
+  }
+
+  // Then
+  EXPECT_EQ(d.Len(), 100);
+  EXPECT_EQ(d[0], 99900);
+}
+
+TEST(Deque, MaxLenDiscardsFromTheOtherEnd) {
+  // If
+  Deque<Int> d({}, 3);
+
+  // When
+  d.Extend(List<Int>::Init(1, 2, 3, 4));
+  d.AppendLeft(0);
+
+  // Then
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{0, 2, 3}));
+  EXPECT_THROW(d.Insert(1, 5), IndexError);
+}
+
+TEST(Deque, MaxLenZero) {
+  // If
+  Deque<Int> d({1, 2}, 0);
+
+  // When
+  d.Append(3);
+  d.AppendLeft(4);
+
+  // Then
+  EXPECT_EQ(d.Len(), 0);
+}
+
+TEST(Deque, ExtendLeftReverses) {
+  // If
+  Deque<Int> d = {3};
+
+  // When
+  d.ExtendLeft(List<Int>::Init(2, 1));
+  d.Extend(d);
+
+  // Then
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{1, 2, 3, 1, 2, 3}));
+}
+
+TEST(Deque, InsertAndRemove) {
+  // If
+  Deque<Int> d;
+
+  for (Int i = 0; i < 1000; ++i) {
+    d.Append(i);
+  }
+
+  // When
+  d.Insert(0, -1);
+  d.Insert(10, -2);
+  d.Insert(-1, -3);
+  d.Insert(2000, -4);
+  d.Remove(500);
+  d.Remove(5);
+
+  // Then
+  EXPECT_EQ(d.Len(), 1002);
+  EXPECT_EQ(d[0], -1);
+  EXPECT_EQ(d[9], -2);
+  EXPECT_EQ(d[-1], -4);
+  EXPECT_EQ(d[-2], 999);
+  EXPECT_EQ(d[-3], -3);
+  EXPECT_FALSE(d.Contains(500));
+  EXPECT_FALSE(d.Contains(5));
+  EXPECT_EQ(d.Index(499), 500);
+  EXPECT_EQ(d.Index(501), 501);
+  EXPECT_THROW(d.Remove(500), ValueError);
+}
+
+TEST(Deque, Rotate) {
+  // If
+  Deque<Int> d = {1, 2, 3, 4, 5};
+
+  // When/then
+  d.Rotate();
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{5, 1, 2, 3, 4}));
+
+  d.Rotate(-2);
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{2, 3, 4, 5, 1}));
+
+  d.Rotate(9);
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{3, 4, 5, 1, 2}));
+
+  d.Reverse();
+  EXPECT_EQ(as_vector(d), (std::vector<Int>{2, 1, 5, 4, 3}));
+}
+
+TEST(Deque, Search) {
+  // If
+  Deque<Int> d;
+
+  // Elements straddle several blocks, starting in the middle of one
+  for (Int i = 0; i < 5000; ++i) {
+    d.AppendLeft(i % 100);
+  }
+
+  // When/then
+  EXPECT_TRUE(d.Contains(99));
+  EXPECT_FALSE(d.Contains(100));
+  EXPECT_EQ(d.Count(42), 50);
+  EXPECT_EQ(d.Index(99), 0);
+  EXPECT_EQ(d.Index(57), 42);
+  EXPECT_EQ(d.Index(42, 58), 157);
+  EXPECT_THROW(d.Index(42, 58, 157), ValueError);
+  EXPECT_EQ(d.Min(), 0);
+  EXPECT_EQ(d.Max(), 99);
+}
+
+TEST(Deque, Reduce) {
+  // If
+  const Deque<Float> d = {1.5, -2.0, 4.0};
+  const Deque<Bool> b = {false, true};
+
+  // When/then
+  EXPECT_EQ(Sum(d), 3.5);
+  EXPECT_EQ(Min(d), -2.0);
+  EXPECT_EQ(Max(d), 4.0);
+  EXPECT_TRUE(Any(b));
+  EXPECT_FALSE(All(b));
+  EXPECT_EQ(b.Count(true), 1);
+  EXPECT_THROW(Deque<Float>().Min(), ValueError);
+}
+
+TEST(Deque, Objects) {
+  // If
+  Deque<IntWrapper> d = {IntWrapper::Init(3), IntWrapper::Init(1)};
+
+  // When
+  d.AppendLeft(IntWrapper::Init(2));
+  d.Remove(IntWrapper::Init(3));
+
+  // Then
+  EXPECT_EQ(d.Len(), 2);
+  EXPECT_EQ(d.Min()->Value(), 1);
+  EXPECT_EQ(d.Max()->Value(), 2);
+  EXPECT_TRUE(d.Contains(IntWrapper::Init(1)));
+  EXPECT_EQ(d.Count(IntWrapper::Init(2)), 1);
+}
+
+TEST(Deque, Iteration) {
+  // If
+  Deque<Int> d;
+
+  for (Int i = 0; i < 1000; ++i) {
+    d.AppendLeft(i);
+  }
+
+  // When
+  Int static_sum = 0;
+  ForEach(d, [&static_sum](Int elem) { static_sum += elem; });
+
+  std::vector<Int> batch(1000);
+  const auto it = Iter(d);
+
+  // Then
+  EXPECT_EQ(static_sum, 499500);
+  EXPECT_EQ(NextBatch(it, std::span<Int>(batch)), 1000);
+  EXPECT_EQ(batch[0], 999);
+  EXPECT_EQ(batch[999], 0);
+  EXPECT_EQ(List<Int>(d).Len(), 1000);
+}
+
+TEST(Deque, Equality) {
+  // If
+  const Deque<Int> d = {1, 2, 3};
+  const Deque<Int> bounded({1, 2, 3}, 5);
+
+  // When
+  const auto copy = d.Copy();
+
+  // Then
+  EXPECT_TRUE(d.Eq(*copy));
+  EXPECT_TRUE(d.Eq(bounded));
+  EXPECT_FALSE(d.Eq(Deque<Int>{1, 2}));
+  EXPECT_FALSE(d.Eq(List<Int>{1, 2, 3}));
+}
+
+TEST(Deque, AsStrAndRepr) {
+  // If
+  const Deque<Int> d = {1, 2};
+  const Deque<Int> bounded({1, 2}, 3);
+
+  // When/then
+  EXPECT_EQ(d.AsStr(), "deque([1, 2])");
+  EXPECT_EQ(d.Repr(), "deque([1, 2])");
+  EXPECT_EQ(bounded.Repr(), "deque([1, 2], maxlen=3)");
+  EXPECT_EQ(Deque<Int>().Repr(), "deque([])");
+}
+
+}  // namespace mamba::builtins::test
@@ -0,0 +1,159 @@
+#include <iterator>  // for input_iterator
+#include <optional>  // for nullopt
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/builtins/adaptors.hpp"   // for Filter, Map
+#include "mamba/builtins/error.hpp"      // for ValueError
+#include "mamba/builtins/generator.hpp"  // for Generator
+#include "mamba/builtins/int.hpp"        // for Int
+#include "mamba/builtins/iteration.hpp"  // for ForEach, Iter, TryNext
+#include "mamba/builtins/list.hpp"       // for List
+
+namespace mamba::builtins::test {
+namespace {
+
+Generator<Int>::handle Count(Int n) {
+  for (Int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+}
+
+Generator<Int>::handle CountAndRecord(Int n, std::vector<Int>& started) {
+  for (Int i = 0; i < n; ++i) {
+    started.emplace_back(i);
+    co_yield i;
+  }
+}
+
+Generator<Int>::handle YieldThenThrow() {
+  co_yield 1;
+  throw ValueError("bad input");
+}
+
+}  // anonymous namespace
+
+TEST(Generator, IsInputRange) {
+  // If/when/then
+  static_assert(std::input_iterator<Generator<Int>::iterator>);
+  static_assert(__concepts::StaticIterator<Generator<Int>>);
+}
+
+TEST(Generator, TryNext) {
+  // If
+  const auto gen = Count(2);
+
+  // When/then
+  EXPECT_EQ(TryNext(*gen), 0);
+  EXPECT_EQ(TryNext(*gen), 1);
+  EXPECT_EQ(TryNext(*gen), std::nullopt);
+  EXPECT_EQ(TryNext(*gen), std::nullopt);
+}
+
+TEST(Generator, IsLazy) {
+  // If
+  std::vector<Int> started;
+
+  // When
+  const auto gen = CountAndRecord(3, started);
+
+  // Then
+  EXPECT_TRUE(started.empty());
+  EXPECT_EQ(TryNext(*gen), 0);
+  EXPECT_EQ(started, (std::vector<Int>{0}));
+}
+
+TEST(Generator, IterReturnsItself) {
+  // If
+  const auto gen = Count(3);
+  EXPECT_EQ(TryNext(*gen), 0);
+
+  // When
+  const auto it = Iter(*gen);
+
+  // Then
+  EXPECT_EQ(TryNext(it), 1);
+  EXPECT_EQ(TryNext(*gen), 2);
+}
+
+TEST(Generator, CppForLoop) {
+  // If/when
+  std::vector<Int> actual;
+
+  for (const auto i : Count(4)) {
+    actual.emplace_back(i);
+  }
+
+  // Then
+  const std::vector<Int> expected = {0, 1, 2, 3};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(Generator, ForEach) {
+  // If
+  const auto gen = Count(5);
+
+  // When
+  Int sum = 0;
+  ForEach(gen, [&sum](Int i) { sum += i; });
+
+  // Then
+  EXPECT_EQ(sum, 10);
+}
+
+TEST(Generator, Adaptors) {
+  // If/when
+  const List<Int> l(Map([](Int i) { return i * i; },
+                        Filter([](Int i) { return i % 2 == 0; }, Count(6))));
+
+  // Then
+  EXPECT_EQ(l.Len(), 3);
+  EXPECT_EQ(l[0], 0);
+  EXPECT_EQ(l[1], 4);
+  EXPECT_EQ(l[2], 16);
+}
+
+TEST(Generator, RethrowsExceptions) {
+  // If
+  const auto gen = YieldThenThrow();
+
+  // When/then
+  EXPECT_EQ(TryNext(*gen), 1);
+  EXPECT_THROW(TryNext(*gen), ValueError);
+  EXPECT_EQ(TryNext(*gen), std::nullopt);
+}
+
+TEST(Generator, DestroyedBeforeExhausted) {
+  // If
+  auto gen = Count(10);
+  EXPECT_EQ(TryNext(*gen), 0);
+
+  // When
+  gen = Count(1);
+
+  // Then
+  EXPECT_EQ(TryNext(*gen), 0);
+  EXPECT_EQ(TryNext(*gen), std::nullopt);
+}
+
+TEST(Generator, OutlivesTheThreadThatCreatedIt) {
+  // If
+  Generator<Int>::handle gen;
+
+  // When
+  std::thread([&gen] {
+    gen = Count(3);
+    TryNext(*gen);
+  }).join();
+
+  // Then
+  EXPECT_EQ(TryNext(*gen), 1);
+  EXPECT_EQ(TryNext(*gen), 2);
+
+  // Frees the frame and the generator on this thread
+  gen = nullptr;
+}
+
+}  // namespace mamba::builtins::test
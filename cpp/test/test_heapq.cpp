@@ -0,0 +1,298 @@
+#include <algorithm>  // for sort, min_element
+#include <cmath>      // for isnan, NAN
+#include <utility>    // for forward
+#include <vector>     // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/__memory/handle.hpp"       // for handle_t, Init
+#include "mamba/builtins/__types/str.hpp"  // for Str
+#include "mamba/builtins/bool.hpp"         // for Bool
+#include "mamba/builtins/error.hpp"        // for IndexError
+#include "mamba/builtins/float.hpp"        // for Float
+#include "mamba/builtins/generator.hpp"    // for Generator
+#include "mamba/builtins/heapq.hpp"        // for HeapPush, HeapPop, NLargest
+#include "mamba/builtins/int.hpp"          // for Int
+#include "mamba/builtins/list.hpp"         // for List
+#include "mamba/builtins/object.hpp"       // for Object
+
+namespace mamba::builtins::test {
+namespace {
+
+struct IntWrapper : public Object,
+                    public __memory::EnableHandleFromThis<IntWrapper> {
+ public:
+  using self = IntWrapper;
+  using handle = __memory::handle_t<self>;
+
+  IntWrapper(Int value) : v_(value) {}
+
+  template <typename... Args>
+  static handle Init(Args&&... args) {
+    return __memory::Init<self>(std::forward<Args>(args)...);
+  }
+
+  Int Value() const { return v_; }
+
+  __types::Str Repr() const override { return "IntWrapper"; }
+
+  Bool Lt(const self& other) const { return v_ < other.v_; }
+  Bool Lt(const handle& other) const { return v_ < other->v_; }
+
+ private:
+  Int v_;
+};
+
+std::vector<Int> PseudoRandomValues(Int size, Int max) {
+  std::vector<Int> res;
+  unsigned int seed = 12345;
+
+  for (Int i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    res.emplace_back(static_cast<Int>((seed >> 16) % max));
+  }
+
+  return res;
+}
+
+Generator<Int>::handle Yield(std::vector<Int> values) {
+  for (const auto value : values) {
+    co_yield value;
+  }
+}
+
+template <std::size_t Arity>
+bool IsHeap(const List<Int>& l) {
+  for (Int i = 1; i < l.Len(); ++i) {
+    if (l[i] < l[(i - 1) / static_cast<Int>(Arity)]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // anonymous namespace
+
+TEST(HeapQ, HeapPushThenHeapPopSorts) {
+  // If
+  const auto values = PseudoRandomValues(1000, 100);
+  auto expected = values;
+  std::sort(expected.begin(), expected.end());
+
+  List<Int> binary;
+  List<Int> quaternary;
+
+  // When
+  for (const auto value : values) {
+    HeapPush(binary, value);
+    HeapPush<4>(quaternary, value);
+  }
+
+  // Then
+  EXPECT_TRUE(IsHeap<2>(binary));
+  EXPECT_TRUE(IsHeap<4>(quaternary));
+
+  for (const auto value : expected) {
+    ASSERT_EQ(HeapPop(binary), value);
+    ASSERT_EQ(HeapPop<4>(quaternary), value);
+  }
+
+  EXPECT_EQ(binary.Len(), 0);
+  EXPECT_EQ(quaternary.Len(), 0);
+}
+
+TEST(HeapQ, HeapifyMatchesPythonLayout) {
+  // If
+  List<Int> l = {5, 3, 8, 1, 9, 2};
+
+  // When
+  Heapify(l);
+
+  // Then
+  EXPECT_EQ(l, (List<Int>{1, 3, 2, 5, 9, 8}));
+}
+
+TEST(HeapQ, HeapifyQuaternary) {
+  // If
+  List<Int> l;
+
+  for (const auto value : PseudoRandomValues(1000, 1000)) {
+    l.Append(value);
+  }
+
+  // When
+  Heapify<4>(l);
+
+  // Then
+  EXPECT_TRUE(IsHeap<4>(l));
+  EXPECT_EQ(l[0], *std::min_element(l.cbegin(), l.cend()));
+}
+
+TEST(HeapQ, HeapPopEmpty) {
+  // If
+  List<Int> l;
+
+  // When/then
+  EXPECT_THROW(HeapPop(l), IndexError);
+  EXPECT_THROW(HeapReplace(l, 1), IndexError);
+}
+
+TEST(HeapQ, HeapPushPopAndHeapReplace) {
+  // If
+  List<Int> l = {1, 3, 5};
+  List<Int> empty;
+
+  // When/then
+  EXPECT_EQ(HeapPushPop(l, 0), 0);
+  EXPECT_EQ(HeapPushPop(l, 4), 1);
+  EXPECT_EQ(l, (List<Int>{3, 4, 5}));
+  EXPECT_EQ(HeapReplace(l, 6), 3);
+  EXPECT_EQ(l, (List<Int>{4, 6, 5}));
+  EXPECT_EQ(HeapPushPop(empty, 2), 2);
+  EXPECT_EQ(empty.Len(), 0);
+}
+
+TEST(HeapQ, HeapOfFloatsBoolsAndObjects) {
+  // If
+  List<Float> f;
+  List<Bool> b;
+  List<IntWrapper> o;
+
+  // When
+  for (const auto value : {3, 1, 2}) {
+    HeapPush(f, static_cast<Float>(value) / 2);
+    HeapPush(b, value != 1);
+    HeapPush(o, IntWrapper::Init(value));
+  }
+
+  // Then
+  EXPECT_EQ(HeapPop(f), 0.5);
+  EXPECT_EQ(HeapPop(f), 1.0);
+  EXPECT_FALSE(HeapPop(b));
+  EXPECT_TRUE(HeapPop(b));
+  EXPECT_EQ(HeapPop(o)->Value(), 1);
+  EXPECT_EQ(HeapPop(o)->Value(), 2);
+  EXPECT_EQ(HeapPop(o)->Value(), 3);
+}
+
+TEST(HeapQ, NSmallestAndNLargest) {
+  // If
+  List<Int> l = {4, 1, 7, 3, 8, 5, 1};
+
+  // When/then
+  EXPECT_EQ(*NSmallest(3, l), (List<Int>{1, 1, 3}));
+  EXPECT_EQ(*NLargest(3, l), (List<Int>{8, 7, 5}));
+  EXPECT_EQ(*NSmallest(10, l), (List<Int>{1, 1, 3, 4, 5, 7, 8}));
+  EXPECT_EQ(NSmallest(0, l)->Len(), 0);
+  EXPECT_EQ(NLargest(-1, l)->Len(), 0);
+}
+
+TEST(HeapQ, NSmallestAndNLargestWithKeyAreStable) {
+  // If
+  List<Int> l = {21, 12, 30, 11, 22, 10};
+  const auto last_digit = [](Int elem) { return elem % 10; };
+
+  // When/then
+  EXPECT_EQ(*NSmallest(4, l, last_digit), (List<Int>{30, 10, 21, 11}));
+  EXPECT_EQ(*NLargest(3, l, last_digit), (List<Int>{12, 22, 21}));
+}
+
+TEST(HeapQ, NSmallestAndNLargestMatchSort) {
+  // If
+  const auto values = PseudoRandomValues(500, 50);
+  List<Int> l;
+
+  for (const auto value : values) {
+    l.Append(value);
+  }
+
+  auto sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+
+  // When/then
+  // Covers both selecting with a heap, for small n, and without
+  for (Int n = 1; n <= 500; n += 7) {
+    const auto smallest = NSmallest(n, l);
+    const auto largest = NLargest(n, l);
+
+    ASSERT_EQ(smallest->Len(), n);
+    ASSERT_EQ(largest->Len(), n);
+
+    for (Int i = 0; i < n; ++i) {
+      ASSERT_EQ((*smallest)[i], sorted[i]);
+      ASSERT_EQ((*largest)[i], sorted[sorted.size() - 1 - i]);
+    }
+  }
+}
+
+TEST(HeapQ, NSmallestAndNLargestOfGenerators) {
+  // If
+  const auto values = PseudoRandomValues(500, 50);
+
+  auto sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+
+  // When/then
+  // Generators have no length, so they always go through a heap of n
+  // elements, however large n is
+  for (Int n = 1; n <= 600; n += 37) {
+    const auto smallest = NSmallest(n, Yield(values));
+    const auto largest = NLargest(n, Yield(values));
+    const auto expected_len = std::min<Int>(n, sorted.size());
+
+    ASSERT_EQ(smallest->Len(), expected_len);
+    ASSERT_EQ(largest->Len(), expected_len);
+
+    for (Int i = 0; i < expected_len; ++i) {
+      ASSERT_EQ((*smallest)[i], sorted[i]);
+      ASSERT_EQ((*largest)[i], sorted[sorted.size() - 1 - i]);
+    }
+  }
+}
+
+TEST(HeapQ, NSmallestAndNLargestOfGeneratorsWithKeyAreStable) {
+  // If
+  const std::vector<Int> values = {21, 12, 30, 11, 22, 10, 31, 20};
+  const auto last_digit = [](Int elem) { return elem % 10; };
+
+  // When/then
+  EXPECT_EQ(*NSmallest(4, Yield(values), last_digit),
+            (List<Int>{30, 10, 20, 21}));
+  EXPECT_EQ(*NLargest(3, Yield(values), last_digit),
+            (List<Int>{12, 22, 21}));
+}
+
+TEST(HeapQ, NSmallestWithNaN) {
+  // If
+  List<Float> l = {2.0, NAN, -1.0, 3.0, NAN, 0.5};
+
+  // When
+  const auto smallest = NSmallest(6, l);
+  const auto largest = NLargest(2, l);
+
+  // Then
+  EXPECT_EQ((*smallest)[0], -1.0);
+  EXPECT_EQ((*smallest)[3], 3.0);
+  EXPECT_TRUE(std::isnan((*smallest)[4]));
+  EXPECT_TRUE(std::isnan((*smallest)[5]));
+  EXPECT_TRUE(std::isnan((*largest)[0]));
+}
+
+TEST(HeapQ, Handles) {
+  // If
+  const auto l = List<Int>::Init(5, 2, 9);
+
+  // When
+  Heapify(l);
+  HeapPush(l, 1);
+
+  // Then
+  EXPECT_EQ(HeapPop(l), 1);
+  EXPECT_EQ(HeapPushPop(l, 3), 2);
+  EXPECT_EQ(HeapReplace(l, 0), 3);
+  EXPECT_EQ(*NLargest(2, l), (List<Int>{9, 5}));
+  EXPECT_EQ(*NSmallest(1, l), (List<Int>{0}));
+}
+
+}  // namespace mamba::builtins::test
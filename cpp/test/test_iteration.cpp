@@ -1,9 +1,184 @@
-#include <string>  // for basic_string
+#include <algorithm>  // for copy
+#include <array>      // for array
+#include <cstddef>    // for size_t
+#include <iterator>   // for back_inserter, default_sentinel, input_iterator
+#include <ranges>     // for input_range, transform
+#include <span>       // for span
+#include <string>     // for basic_string
+#include <vector>     // for vector
 
 #include "gtest/gtest.h"
 
+#include "mamba/builtins/int.hpp"         // for Int
+#include "mamba/builtins/iteration.hpp"   // for ForEach, Iter, LengthHint
+#include "mamba/builtins/list.hpp"        // for List
+#include "mamba/builtins/slice_view.hpp"  // for SliceView
+#include "mamba/builtins/tuple.hpp"       // for Tuple
+
 namespace mamba::builtins::test {
 
-TEST(IteratorWrapper, CppForLoop) {}
+TEST(IteratorWrapper, IsInputIterator) {
+  // If/when/then
+  static_assert(std::input_iterator<Iterator<Int>::iterator>);
+  static_assert(std::sentinel_for<std::default_sentinel_t,
+                                  Iterator<Int>::iterator>);
+  static_assert(std::ranges::input_range<Iterator<Int>>);
+}
+
+TEST(IteratorWrapper, CppForLoop) {
+  // If
+  List<Int> l = {1, 3, 5, 7};
+
+  // When
+  std::vector<Int> actual;
+
+  for (const auto elem : Iter(l)) {
+    actual.emplace_back(elem);
+  }
+
+  // Then
+  const std::vector<Int> expected = {1, 3, 5, 7};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(IteratorWrapper, DereferenceDoesNotAdvance) {
+  // If
+  List<Int> l = {1, 3};
+  const auto it = Iter(l);
+
+  // When
+  auto wrapper = it->begin();
+
+  // Then
+  EXPECT_EQ(*wrapper, 1);
+  EXPECT_EQ(*wrapper, 1);
+  ++wrapper;
+  EXPECT_EQ(*wrapper, 3);
+  ++wrapper;
+  EXPECT_TRUE(wrapper == std::default_sentinel);
+}
+
+TEST(IteratorWrapper, RangesCopy) {
+  // If
+  List<Int> l = {1, 3, 5};
+  const auto it = Iter(l);
+
+  // When
+  std::vector<Int> actual;
+  std::ranges::copy(*it, std::back_inserter(actual));
+
+  // Then
+  const std::vector<Int> expected = {1, 3, 5};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(IteratorWrapper, ViewsTransform) {
+  // If
+  List<Int> l = {1, 3, 5};
+  const auto it = Iter(l);
+
+  // When
+  std::vector<Int> actual;
+
+  for (const auto elem :
+       *it | std::views::transform([](Int i) { return i * 10; })) {
+    actual.emplace_back(elem);
+  }
+
+  // Then
+  const std::vector<Int> expected = {10, 30, 50};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(ForEach, StaticIterables) {
+  // If/when/then
+  static_assert(__concepts::StaticIterable<List<Int>>);
+  static_assert(__concepts::StaticIterable<SliceView<Int>>);
+  static_assert(__concepts::StaticIterable<Tuple<Int>>);
+  static_assert(!__concepts::StaticIterable<Iterator<Int>>);
+}
+
+TEST(ForEach, StaticIterable) {
+  // If
+  List<Int> l = {1, 3, 5, 7};
+
+  // When
+  std::vector<Int> actual;
+  ForEach(l, [&actual](Int elem) { actual.emplace_back(elem); });
+
+  // Then
+  const std::vector<Int> expected = {1, 3, 5, 7};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(ForEach, TypeErasedIterator) {
+  // If
+  List<Int> l = {1, 3, 5, 7};
+  const auto it = Iter(l);
+
+  // When
+  std::vector<Int> actual;
+  ForEach(it, [&actual](Int elem) { actual.emplace_back(elem); });
+
+  // Then
+  const std::vector<Int> expected = {1, 3, 5, 7};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(ForEach, TypeErasedIteratorAcrossBatches) {
+  // If
+  constexpr std::size_t n = 3 * Iterator<Int>::kBatchSize + 5;
+  List<Int> l;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    l.Append(static_cast<Int>(i));
+  }
+
+  const auto it = Iter(l);
+
+  // When
+  std::vector<Int> actual;
+  ForEach(it, [&actual](Int elem) { actual.emplace_back(elem); });
+
+  // Then
+  ASSERT_EQ(actual.size(), n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(actual[i], static_cast<Int>(i));
+  }
+}
+
+TEST(LengthHint, SizedIsLen) {
+  // If
+  List<Int> l = {1, 3, 5, 7};
+  const auto t = Tuple<Int>::Init(1, 3);
+
+  // When/then
+  EXPECT_EQ(LengthHint(l), 4);
+  EXPECT_EQ(LengthHint(t), 2);
+  EXPECT_EQ(LengthHint(l.View(1)), 3);
+}
+
+TEST(LengthHint, IteratorCountsDown) {
+  // If
+  List<Int> l = {1, 3, 5, 7};
+  const auto it = Iter(l);
+  std::array<Int, 2> batch;
+
+  // When/then
+  EXPECT_EQ(LengthHint(it), 4);
+  TryNext(it);
+  EXPECT_EQ(LengthHint(it), 3);
+  NextBatch(it, std::span<Int>(batch));
+  EXPECT_EQ(LengthHint(it), 1);
+  TryNext(it);
+  EXPECT_EQ(LengthHint(it), 0);
+}
+
+TEST(LengthHint, Default) {
+  // If/when/then
+  EXPECT_EQ(LengthHint(Int{3}), 0);
+  EXPECT_EQ(LengthHint(Int{3}, 5), 5);
+}
 
 }  // namespace mamba::builtins::test
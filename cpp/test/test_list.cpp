@@ -1,10 +1,14 @@
 #include <stddef.h>  // for size_t
 
 #include <__fwd/sstream.h>  // for ostringstream
-#include <memory>           // for shared_ptr, enable_shared_from_this
+#include <algorithm>        // for sort, stable_sort, reverse, fill_n
+#include <cmath>            // for isnan, signbit
+#include <limits>           // for numeric_limits
+#include <memory>           // for shared_ptr
+#include <optional>         // for nullopt
 #include <sstream>          // for basic_ostream, basic_ostringstream
-#include <string>           // for basic_string
-#include <utility>          // for forward
+#include <string>           // for basic_string, to_string
+#include <utility>          // for forward, as_const
 #include <vector>           // for vector
 
 #include "gtest/gtest.h"  // for Test, Message, TestPartResult, TEST
@@ -13,26 +17,34 @@
 #include "mamba/__concepts/value.hpp"         // for Value
 #include "mamba/__memory/handle.hpp"          // for handle_t, Init
 #include "mamba/__memory/read_only.hpp"       // for ReadOnly
+#include "mamba/__memory/storage.hpp"         // for SmallStorage
+#include "mamba/__utils/parallel_sort.hpp"    // for SetParallelSortThreshold
+#include "mamba/__utils/reduce.hpp"           // for SetParallelReduceThreshold
+#include "mamba/__utils/small_vector.hpp"     // for SmallVector
+#include "mamba/__utils/timsort.hpp"          // for TimSort
 #include "mamba/builtins/__as_bool/bool.hpp"  // for AsBool
 #include "mamba/builtins/as_str.hpp"          // for AsStr
 #include "mamba/builtins/bool.hpp"            // for Bool
 #include "mamba/builtins/comparators.hpp"     // for Lt, Eq
-#include "mamba/builtins/error.hpp"           // for ValueError, IndexError
+#include "mamba/builtins/deque.hpp"           // for Deque
+#include "mamba/builtins/error.hpp"           // for ValueError, StopIteration
 #include "mamba/builtins/float.hpp"           // for Float
 #include "mamba/builtins/int.hpp"             // for Int
-#include "mamba/builtins/iteration.hpp"       // for Iter, Iterator
+#include "mamba/builtins/iteration.hpp"       // for Iter, NextBatch, TryNext
 #include "mamba/builtins/list.hpp"            // for List
 #include "mamba/builtins/object.hpp"          // for Str
+#include "mamba/builtins/range.hpp"           // for Range
 #include "mamba/builtins/repr.hpp"            // for Repr
-#include "mamba/builtins/sequence.hpp"        // for Len, Contains, Max, Min
+#include "mamba/builtins/sequence.hpp"        // for Len, Contains, Max, Sum
 #include "mamba/builtins/str.hpp"             // for Str
+#include "mamba/builtins/tuple.hpp"           // for Tuple
 
 namespace mamba::builtins::test {
 namespace {
 
 template <__concepts::Value T>
 struct Wrapper : public Object,
-                 public std::enable_shared_from_this<Wrapper<T>> {
+                 public __memory::EnableHandleFromThis<Wrapper<T>> {
  public:
   using self = Wrapper;
   using handle = __memory::handle_t<self>;
@@ -75,8 +87,64 @@ struct Wrapper : public Object,
 using IntWrapper = Wrapper<Int>;
 using FloatWrapper = Wrapper<Float>;
 
-template <typename T, typename U = T>
-std::vector<U> as_vector(const List<T>& l) {
+// Inputs of n elements in the shapes that TimSort treats specially, with
+// many duplicates so that stability matters
+std::vector<std::vector<Int>> make_sort_inputs(Int n) {
+  std::vector<std::vector<Int>> res(5);
+  unsigned int seed = 12345;
+
+  for (Int i = 0; i < n; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const auto random = static_cast<Int>((seed >> 16) % 1000);
+
+    res[0].emplace_back(random);                 // Random
+    res[1].emplace_back(i);                      // Sorted
+    res[2].emplace_back(n - i);                  // Reversed
+    res[3].emplace_back(i % 100);                // Sawtooth, i.e. runs
+    res[4].emplace_back(i < n / 2 ? i : n - i);  // Organ pipe
+  }
+
+  return res;
+}
+
+// Sorts lists of at least n elements in parallel for the lifetime of the guard
+class ParallelSortThresholdGuard {
+ public:
+  explicit ParallelSortThresholdGuard(size_t n)
+      : previous_(__utils::ParallelSortThreshold()) {
+    __utils::SetParallelSortThreshold(n);
+  }
+
+  ~ParallelSortThresholdGuard() {
+    __utils::SetParallelSortThreshold(previous_);
+  }
+
+ private:
+  size_t previous_;
+};
+
+// Reduces lists of at least n elements in parallel for the lifetime of the
+// guard
+class ParallelReduceThresholdGuard {
+ public:
+  explicit ParallelReduceThresholdGuard(size_t n)
+      : previous_(__utils::ParallelReduceThreshold()) {
+    __utils::SetParallelReduceThreshold(n);
+  }
+
+  ~ParallelReduceThresholdGuard() {
+    __utils::SetParallelReduceThreshold(previous_);
+  }
+
+ private:
+  size_t previous_;
+};
+
+// Small enough that the tests cover both inline and spilled lists
+using SmallIntList = List<Int, __memory::SmallStorage<4>>;
+
+template <typename T, typename U = T, typename S>
+std::vector<U> as_vector(const List<T, S>& l) {
   std::vector<U> res;
 
   for (size_t i = 0; i < Len(l); ++i) {
@@ -307,6 +375,40 @@ TEST(List, ContainsActuallyInObject) {
   EXPECT_FALSE(Contains(l, IntWrapper::Init(5)));
 }
 
+TEST(List, ContainsLong) {
+  // If
+  List<Int> l;
+
+  for (Int i = 0; i < 1000; ++i) {
+    l.Append(i * 2);
+  }
+
+  // When/then
+  // Around the boundaries of vectors and of the unrolled steps of the search
+  for (const Int i : {0, 1, 7, 8, 31, 32, 33, 500, 995, 999}) {
+    EXPECT_TRUE(l.Contains(i * 2)) << "at " << i;
+    EXPECT_FALSE(l.Contains(i * 2 + 1)) << "at " << i;
+  }
+}
+
+TEST(List, ContainsFloat) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 100; ++i) {
+    l.Append(i == 70 ? -0.0 : 1.5);
+  }
+
+  l.Append(std::numeric_limits<Float>::quiet_NaN());
+
+  // When/then
+  EXPECT_TRUE(l.Contains(0.0));
+  EXPECT_TRUE(l.Contains(1.5));
+  EXPECT_FALSE(l.Contains(2.5));
+  // NaN does not equal itself
+  EXPECT_FALSE(l.Contains(std::numeric_limits<Float>::quiet_NaN()));
+}
+
 TEST(List, ClearEmpty) {
   // If
   List<Int> l;
@@ -415,6 +517,259 @@ TEST(List, CopyNonEmptyObject) {
   EXPECT_EQ(actual_copy_items, expected_copy_items);
 }
 
+TEST(List, CopyOnWriteCopySharesStorage) {
+  // If
+  const List<Int, __memory::CopyOnWriteStorage> l = {1, 3, 5, 7};
+
+  // When
+  const auto copy = l.Copy();
+
+  // Then
+  EXPECT_EQ(&std::as_const(*copy)[0], &l[0]);
+}
+
+TEST(List, CopyOnWriteAppendDetaches) {
+  // If
+  const List<Int, __memory::CopyOnWriteStorage> l = {1, 3, 5, 7};
+
+  // When
+  auto copy = l.Copy();
+  copy->Append(9);
+
+  // Then
+  EXPECT_NE(&std::as_const(*copy)[0], &l[0]);
+
+  const auto actual_l_items = as_vector(l);
+  const std::vector<Int> expected_l_items = {1, 3, 5, 7};
+  EXPECT_EQ(actual_l_items, expected_l_items);
+
+  const auto actual_copy_items = as_vector(*copy);
+  const std::vector<Int> expected_copy_items = {1, 3, 5, 7, 9};
+  EXPECT_EQ(actual_copy_items, expected_copy_items);
+}
+
+TEST(List, CopyOnWriteSetByIndexDetaches) {
+  // If
+  List<Int, __memory::CopyOnWriteStorage> l = {1, 3, 5, 7};
+  const auto copy = l.Copy();
+
+  // When
+  l[0] = 2;
+
+  // Then
+  const auto actual_l_items = as_vector(l);
+  const std::vector<Int> expected_l_items = {2, 3, 5, 7};
+  EXPECT_EQ(actual_l_items, expected_l_items);
+
+  const auto actual_copy_items = as_vector(*copy);
+  const std::vector<Int> expected_copy_items = {1, 3, 5, 7};
+  EXPECT_EQ(actual_copy_items, expected_copy_items);
+}
+
+TEST(List, CopyOnWriteSortDetachesObject) {
+  // If
+  const List<IntWrapper, __memory::CopyOnWriteStorage> l = {
+      IntWrapper::Init(7), IntWrapper::Init(3), IntWrapper::Init(5)};
+
+  // When
+  auto copy = l.Copy();
+  copy->Sort();
+
+  // Then
+  const auto actual_l_items = as_vector<IntWrapper, Int>(l);
+  const std::vector<Int> expected_l_items = {7, 3, 5};
+  EXPECT_EQ(actual_l_items, expected_l_items);
+
+  const auto actual_copy_items = as_vector<IntWrapper, Int>(*copy);
+  const std::vector<Int> expected_copy_items = {3, 5, 7};
+  EXPECT_EQ(actual_copy_items, expected_copy_items);
+}
+
+TEST(List, CopyOnWriteIterableConstructorSharesStorage) {
+  // If
+  List<Int, __memory::CopyOnWriteStorage> l = {1, 3, 5, 7};
+
+  // When
+  const List<Int, __memory::CopyOnWriteStorage> copy(l);
+
+  // Then
+  EXPECT_EQ(&copy[0], &std::as_const(l)[0]);
+}
+
+TEST(List, SmallStorageAppendBeyondInlineCapacity) {
+  // If
+  SmallIntList l = {1, 3};
+
+  // When
+  l.Append(5, 7, 9, 11);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 3, 5, 7, 9, 11};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageAppendBeyondInlineCapacityObject) {
+  // If
+  List<IntWrapper, __memory::SmallStorage<4>> l = {IntWrapper::Init(1),
+                                                   IntWrapper::Init(3)};
+
+  // When
+  l.Append(IntWrapper::Init(5), IntWrapper::Init(7), IntWrapper::Init(9));
+
+  // Then
+  const auto actual = as_vector<IntWrapper, Int>(l);
+  const std::vector<Int> expected = {1, 3, 5, 7, 9};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageCopy) {
+  // If
+  const SmallIntList inline_l = {1, 3};
+  const SmallIntList spilled_l = {1, 3, 5, 7, 9};
+
+  // When
+  const auto inline_copy = inline_l.Copy();
+  const auto spilled_copy = spilled_l.Copy();
+
+  // Then
+  EXPECT_NE(&(*inline_copy)[0], &inline_l[0]);
+  EXPECT_EQ(as_vector(*inline_copy), as_vector(inline_l));
+  EXPECT_EQ(as_vector(*spilled_copy), as_vector(spilled_l));
+}
+
+TEST(List, SmallStorageSlice) {
+  // If
+  const SmallIntList l = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  // When
+  const auto sliced = l.Slice(1, kEndIndex, 3);
+
+  // Then
+  const auto actual = as_vector(*sliced);
+  const std::vector<Int> expected = {1, 4, 7};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageReplaceSliceSingleStepMoreNewElems) {
+  // If
+  SmallIntList l = {1, 3, 5};
+  const SmallIntList other = {7, 9, 11, 13};
+
+  // When
+  l.ReplaceSlice(other, 1, 2);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 7, 9, 11, 13, 5};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageReplaceSliceSingleStepLessNewElems) {
+  // If
+  SmallIntList l = {1, 3, 5, 7, 9, 11};
+  const SmallIntList other = {13};
+
+  // When
+  l.ReplaceSlice(other, 1, 5);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 13, 11};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageReplaceSliceNotSingleStepSameNumElems) {
+  // If
+  SmallIntList l = {1, 3, 5, 7, 9};
+  const SmallIntList other = {0, 0, 0};
+
+  // When
+  l.ReplaceSlice(other, 0, kEndIndex, 2);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {0, 3, 0, 7, 0};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageDeleteSliceNotSingleStep) {
+  // If
+  SmallIntList l = {1, 3, 5, 7, 9, 11};
+
+  // When
+  l.DeleteSlice(1, kEndIndex, 2);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 5, 9};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageDeleteSliceObject) {
+  // If
+  List<IntWrapper, __memory::SmallStorage<4>> l = {
+      IntWrapper::Init(1), IntWrapper::Init(3), IntWrapper::Init(5),
+      IntWrapper::Init(7), IntWrapper::Init(9)};
+
+  // When
+  l.DeleteSlice(1, 4);
+
+  // Then
+  const auto actual = as_vector<IntWrapper, Int>(l);
+  const std::vector<Int> expected = {1, 9};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageInsertAndPop) {
+  // If
+  SmallIntList l = {1, 3, 5, 7};
+
+  // When
+  l.Insert(1, 2);
+  const auto popped = l.Pop(0);
+
+  // Then
+  EXPECT_EQ(popped, 1);
+
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {2, 3, 5, 7};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageMultiplicationAssignmentOperator) {
+  // If
+  SmallIntList l = {1, 3, 5};
+
+  // When
+  l *= 3;
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 3, 5, 1, 3, 5, 1, 3, 5};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SmallStorageEraseEmptyRange) {
+  // If
+  __utils::SmallVector<Str, 4> v;
+
+  for (Int i = 0; i < 6; ++i) {
+    v.push_back("elem" + std::to_string(i));
+  }
+
+  // When
+  const auto it = v.erase(v.cbegin() + 2, v.cbegin() + 2);
+
+  // Then
+  EXPECT_EQ(it, v.begin() + 2);
+
+  const std::vector<Str> actual(v.begin(), v.end());
+  const std::vector<Str> expected = {"elem0", "elem1", "elem2",
+                                     "elem3", "elem4", "elem5"};
+  EXPECT_EQ(actual, expected);
+}
+
 TEST(List, ExtendEmptyAndEmptyOther) {
   // If
   List<Int> l;
@@ -502,6 +857,140 @@ TEST(List, ExtendNonEmptyAndNonEmptyOtherObject) {
   EXPECT_EQ(actual, expected);
 }
 
+TEST(List, ExtendIterator) {
+  // If
+  List<Int> l = {9, 11};
+  List<Int> other = {1, 3, 5};
+  const auto it = Iter(other);
+
+  // When
+  l.Extend(it);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {9, 11, 1, 3, 5};
+
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, ExtendIteratorObject) {
+  // If
+  List<IntWrapper> l = {IntWrapper::Init(9)};
+  List<IntWrapper> other = {IntWrapper::Init(1), IntWrapper::Init(3)};
+  const auto it = Iter(other);
+
+  // When
+  l.Extend(*it);
+
+  // Then
+  const auto actual = as_vector<IntWrapper, Int>(l);
+  const std::vector<Int> expected = {9, 1, 3};
+
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, ExtendRandomAccessIterables) {
+  // If
+  List<Int> l = {9};
+  SmallIntList small = {1, 3};
+  auto t = Tuple<Int>::Init(5, 7);
+  Deque<Int> d = {8, 10};
+  Range r(11, 14);
+
+  // When
+  l.Extend(small);
+  l.Extend(t);
+  l.Extend(d);
+  l.Extend(r);
+
+  // Then
+  static_assert(details::RandomAccessIterable<Deque<Int>>);
+
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {9, 1, 3, 5, 7, 8, 10, 11, 12, 13};
+
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, ExtendSelf) {
+  // If
+  List<Int> l = {1, 3, 5};
+  List<IntWrapper> objects = {IntWrapper::Init(1), IntWrapper::Init(3)};
+
+  // When
+  l.Extend(l);
+  objects.Extend(objects);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 3, 5, 1, 3, 5};
+
+  EXPECT_EQ(actual, expected);
+  EXPECT_EQ((as_vector<IntWrapper, Int>(objects)),
+            (std::vector<Int>{1, 3, 1, 3}));
+}
+
+TEST(List, ExtendManyTimes) {
+  // If
+  List<Int> l;
+  List<Int> other = {1, 3};
+
+  // When
+  for (Int i = 0; i < 1000; ++i) {
+    l.Extend(other);
+    l.Extend(Iter(other));
+  }
+
+  // Then
+  ASSERT_EQ(l.Len(), 4000);
+  EXPECT_EQ(l[0], 1);
+  EXPECT_EQ(l[-1], 3);
+}
+
+TEST(List, SmallStorageExtendBeyondInlineCapacity) {
+  // If
+  SmallIntList l = {1, 3};
+  List<Int> other = {5, 7, 9};
+
+  // When
+  l.Extend(other);
+  l.Extend(l);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {1, 3, 5, 7, 9, 1, 3, 5, 7, 9};
+
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, CopyOnWriteExtendDetaches) {
+  // If
+  List<Int, __memory::CopyOnWriteStorage> l = {1, 3};
+  const auto copy = l.Copy();
+  List<Int> other = {5, 7};
+
+  // When
+  l.Extend(other);
+
+  // Then
+  EXPECT_EQ(l.Len(), 4);
+  EXPECT_EQ(copy->Len(), 2);
+}
+
+TEST(List, IterableConstructorFromRange) {
+  // If
+  Range r(0, 10, 3);
+
+  // When
+  const List<Int> l(r);
+
+  // Then
+  const auto actual = as_vector(l);
+  const std::vector<Int> expected = {0, 3, 6, 9};
+
+  EXPECT_EQ(actual, expected);
+}
+
 TEST(List, AdditionAssignmentOperator) {
   // If
   List<Int> l = {9, 11, 13};
@@ -1015,6 +1504,233 @@ TEST(List, MaxNonEmptyObject) {
   EXPECT_EQ(Max(l)->Value(), 7);
 }
 
+TEST(List, MinMaxLong) {
+  // Around the boundaries of vectors and of the unrolled steps of the kernels
+  for (const Int n : {2, 7, 8, 33, 100, 1000}) {
+    for (Int at = 0; at < n; at += 1 + n / 10) {
+      // If
+      List<Int> l;
+
+      for (Int i = 0; i < n; ++i) {
+        l.Append(i == at ? -1 : i == (at + 1) % n ? n : i % 50);
+      }
+
+      // When/then
+      EXPECT_EQ(Min(l), -1) << "n=" << n << ", at=" << at;
+      EXPECT_EQ(Max(l), n) << "n=" << n << ", at=" << at;
+    }
+  }
+}
+
+TEST(List, MinMaxFloat) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 100; ++i) {
+    l.Append(i == 40 ? 0.0 : i == 60 ? -0.0 : 1.5);
+  }
+
+  // When/then
+  // The first of equal elements wins, like in Python
+  EXPECT_FALSE(std::signbit(Min(l)));
+  EXPECT_EQ(Max(l), 1.5);
+
+  l.Append(-2.5);
+  EXPECT_EQ(Min(l), -2.5);
+}
+
+TEST(List, MinMaxFloatWithNaN) {
+  // If
+  const auto nan = std::numeric_limits<Float>::quiet_NaN();
+  List<Float> first;
+  List<Float> middle;
+
+  first.Append(nan);
+
+  for (Int i = 0; i < 100; ++i) {
+    first.Append(static_cast<Float>(i));
+    middle.Append(i == 50 ? nan : i);
+  }
+
+  // When/then
+  // NaN compares false to everything, so it wins only if it comes first
+  EXPECT_TRUE(std::isnan(Min(first)));
+  EXPECT_TRUE(std::isnan(Max(first)));
+  EXPECT_EQ(Min(middle), 0);
+  EXPECT_EQ(Max(middle), 99);
+}
+
+TEST(List, SumEmpty) {
+  // If
+  const List<Int> l;
+
+  // When/then
+  EXPECT_EQ(Sum(l), 0);
+  EXPECT_EQ(Sum(l, 5), 5);
+}
+
+TEST(List, SumInt) {
+  // If
+  List<Int> l;
+
+  for (Int i = 1; i <= 1000; ++i) {
+    l.Append(i);
+  }
+
+  // When/then
+  EXPECT_EQ(Sum(l), 500500);
+  EXPECT_EQ(Sum(l, -500), 500000);
+  EXPECT_EQ(Sum(SmallIntList{1, 2, 3, 4, 5}), 15);
+}
+
+TEST(List, SumIntWrapsAround) {
+  // If
+  const List<Int> l = {std::numeric_limits<Int>::max(), 1};
+
+  // When/then
+  EXPECT_EQ(Sum(l), std::numeric_limits<Int>::min());
+}
+
+TEST(List, SumBool) {
+  // If
+  List<Bool> l;
+
+  for (Int i = 0; i < 100; ++i) {
+    l.Append(i % 3 == 0);
+  }
+
+  // When/then
+  EXPECT_EQ(Sum(l), 34);
+}
+
+TEST(List, SumFloat) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 1000; ++i) {
+    l.Append(0.1);
+  }
+
+  // When/then
+  EXPECT_EQ(Sum(l), 100.0);
+  EXPECT_EQ(Sum(l, 0.5), 100.5);
+  EXPECT_NEAR(Sum(l, 0.0, Summation::kPairwise), 100.0, 1e-12);
+}
+
+TEST(List, SumFloatCompensated) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 100; ++i) {
+    l.Append(1e100);
+    l.Append(1.0);
+    l.Append(-1e100);
+  }
+
+  // When/then
+  EXPECT_EQ(Sum(l), 100.0);
+}
+
+TEST(List, SumFloatNotFinite) {
+  // If
+  const auto inf = std::numeric_limits<Float>::infinity();
+  List<Float> l;
+
+  for (Int i = 0; i < 100; ++i) {
+    l.Append(i == 50 ? inf : 1.0);
+  }
+
+  // When/then
+  EXPECT_EQ(Sum(l), inf);
+  EXPECT_EQ(Sum(l, 0.0, Summation::kPairwise), inf);
+
+  l.Append(-inf);
+  EXPECT_TRUE(std::isnan(Sum(l)));
+}
+
+TEST(List, AnyAll) {
+  // If
+  const List<Int> empty;
+  List<Int> zeros;
+  List<Int> ones;
+
+  for (Int i = 0; i < 100; ++i) {
+    zeros.Append(0);
+    ones.Append(1);
+  }
+
+  List<Int> one_zero = ones;
+  one_zero[70] = 0;
+
+  // When/then
+  EXPECT_FALSE(Any(empty));
+  EXPECT_TRUE(All(empty));
+  EXPECT_FALSE(Any(zeros));
+  EXPECT_FALSE(All(zeros));
+  EXPECT_TRUE(Any(ones));
+  EXPECT_TRUE(All(ones));
+  EXPECT_TRUE(Any(one_zero));
+  EXPECT_FALSE(All(one_zero));
+}
+
+TEST(List, AnyAllFloat) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 100; ++i) {
+    l.Append(-0.0);
+  }
+
+  // When/then
+  // -0.0 is false, and NaN is true
+  EXPECT_FALSE(Any(l));
+
+  l.Append(std::numeric_limits<Float>::quiet_NaN());
+  EXPECT_TRUE(Any(l));
+  EXPECT_FALSE(All(l));
+}
+
+TEST(List, AnyAllNotVectorized) {
+  // If
+  const List<Bool> some = {false, true, false};
+  const List<Bool> none = {false, false};
+
+  // When/then
+  EXPECT_TRUE(Any(some));
+  EXPECT_FALSE(All(some));
+  EXPECT_FALSE(Any(none));
+  EXPECT_TRUE(All(List<Bool>{true, true}));
+}
+
+TEST(List, ReduceInParallel) {
+  // If
+  List<Int> ints;
+  List<Float> floats;
+
+  for (Int i = 0; i < 100000; ++i) {
+    ints.Append(i % 1000 - 400);
+    floats.Append(1.0 / (i + 1));
+  }
+
+  ints.Append(-1000);
+
+  const auto serial_sum = Sum(floats, 0.0, Summation::kPairwise);
+  const auto serial_compensated_sum = Sum(floats);
+  const ParallelReduceThresholdGuard guard(1000);
+
+  // When/then
+  EXPECT_EQ(Sum(ints), 100 * 499500 - 400 * 100000 - 1000);
+  EXPECT_EQ(Min(ints), -1000);
+  EXPECT_EQ(Max(ints), 599);
+  EXPECT_TRUE(Any(ints));
+  EXPECT_FALSE(All(ints));
+  // Blocks are added in the same order whether in parallel or not
+  EXPECT_EQ(Sum(floats, 0.0, Summation::kPairwise), serial_sum);
+  EXPECT_EQ(Sum(floats), serial_compensated_sum);
+  EXPECT_EQ(Min(floats), 1.0 / 100000);
+  EXPECT_EQ(Max(floats), 1.0);
+}
+
 TEST(List, CountEmpty) {
   // If
   const List<Int> l;
@@ -1066,6 +1782,25 @@ TEST(List, CountNonZeroObject) {
   EXPECT_EQ(l.Count(IntWrapper::Init(1)), 2);
 }
 
+TEST(List, CountLong) {
+  // If
+  List<Int> ints;
+  List<Float> floats;
+
+  for (Int i = 0; i < 1003; ++i) {
+    ints.Append(i % 7);
+    floats.Append(static_cast<Float>(i % 7) / 2);
+  }
+
+  // When/then
+  EXPECT_EQ(ints.Count(0), 144);
+  EXPECT_EQ(ints.Count(6), 143);
+  EXPECT_EQ(ints.Count(7), 0);
+  EXPECT_EQ(floats.Count(0.0), 144);
+  EXPECT_EQ(floats.Count(3.0), 143);
+  EXPECT_EQ(floats.Count(0.25), 0);
+}
+
 TEST(List, SliceZeroStep) {
   // If
   const List<Int> l = {1, 3, 5, 1, 7};
@@ -1499,6 +2234,24 @@ TEST(List, IndexNonEmptyObjectNotSame) {
   EXPECT_THROW(l.Index(IntWrapper::Init(5)), ValueError);
 }
 
+TEST(List, IndexLongWithBounds) {
+  // If
+  List<Int> l;
+
+  for (Int i = 0; i < 1000; ++i) {
+    l.Append(i % 100);
+  }
+
+  // When/then
+  EXPECT_EQ(l.Index(42), 42);
+  EXPECT_EQ(l.Index(42, 43), 142);
+  EXPECT_EQ(l.Index(42, 100, 143), 142);
+  EXPECT_EQ(l.Index(99, 950), 999);
+  EXPECT_THROW(l.Index(42, 943), ValueError);
+  EXPECT_THROW(l.Index(42, 100, 142), ValueError);
+  EXPECT_THROW(l.Index(42, 500, 400), ValueError);
+}
+
 TEST(List, RemoveEmpty) {
   // If
   List<Int> l;
@@ -2619,6 +3372,43 @@ TEST(List, IteratorIterationObject) {
   EXPECT_EQ(actual, expected);
 }
 
+TEST(List, IteratorTryNext) {
+  // If
+  List<Int> l = {1, 3};
+  const auto it = Iter(l);
+
+  // When/then
+  EXPECT_EQ(TryNext(it), 1);
+  EXPECT_EQ(TryNext(it), 3);
+  EXPECT_EQ(TryNext(it), std::nullopt);
+  EXPECT_EQ(TryNext(it), std::nullopt);
+}
+
+TEST(List, IteratorNextBatch) {
+  // If
+  List<Int> l = {1, 3, 5};
+  const auto it = Iter(l);
+  std::vector<Int> batch(2);
+
+  // When/then
+  EXPECT_EQ(NextBatch<Int>(it, batch), 2);
+  EXPECT_EQ(batch, (std::vector<Int>{1, 3}));
+  EXPECT_EQ(NextBatch<Int>(it, batch), 1);
+  EXPECT_EQ(batch[0], 5);
+  EXPECT_EQ(NextBatch<Int>(it, batch), 0);
+  EXPECT_EQ(TryNext(it), std::nullopt);
+}
+
+TEST(List, IteratorNextThrowsWhenExhausted) {
+  // If
+  List<Int> l = {1};
+  const auto it = Iter(l);
+
+  // When/then
+  EXPECT_EQ(Next(it), 1);
+  EXPECT_THROW(Next(it), StopIteration);
+}
+
 TEST(List, EqualitySameObject) {
   // If
   const List<Int> l = {1, 3, 5, 7};
@@ -3039,4 +3829,314 @@ TEST(List, SortWithKeyAndReverseObject) {
   EXPECT_EQ(actual, expected);
 }
 
+TEST(List, SortWithKeyIsStable) {
+  for (const Int n : {50, 1000, 20000}) {
+    for (const auto& input : make_sort_inputs(n)) {
+      for (const bool reverse : {false, true}) {
+        // If
+        List<Int> l;
+
+        for (const auto elem : input) {
+          l.Append(elem);
+        }
+
+        const auto key = [](const Int i) -> Int { return i / 8; };
+
+        // When
+        l.Sort(key, reverse);
+
+        // Then
+        auto expected = input;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [&key, reverse](const Int a, const Int b) {
+                           return reverse ? key(b) < key(a) : key(a) < key(b);
+                         });
+
+        ASSERT_EQ(as_vector(l), expected)
+            << "n=" << n << ", reverse=" << reverse;
+      }
+    }
+  }
+}
+
+TEST(List, SortThrowingKeyKeepsElements) {
+  // If
+  const auto input = make_sort_inputs(1000)[0];
+  List<Int> l;
+
+  for (const auto elem : input) {
+    l.Append(elem);
+  }
+
+  // The keys are all computed up front, so this throws half-way through
+  Int calls = 0;
+  const auto key = [&calls](const Int i) -> Int {
+    if (++calls == 500) {
+      throw ValueError("bad key");
+    }
+
+    return i;
+  };
+
+  // When
+  EXPECT_THROW(l.Sort(key), ValueError);
+
+  // Then
+  auto actual = as_vector(l);
+  auto expected = input;
+  std::sort(actual.begin(), actual.end());
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(List, SortWithKeyCallsKeyOncePerElement) {
+  for (const bool reverse : {false, true}) {
+    // If
+    const auto input = make_sort_inputs(1000)[0];
+    List<Int> l;
+
+    for (const auto elem : input) {
+      l.Append(elem);
+    }
+
+    Int calls = 0;
+    const auto key = [&calls](const Int i) -> Int {
+      ++calls;
+      return i;
+    };
+
+    // When
+    l.Sort(key, reverse);
+
+    // Then
+    EXPECT_EQ(calls, 1000) << "reverse=" << reverse;
+  }
+}
+
+TEST(List, SortIntMatchesStdSort) {
+  for (const Int n : {100, 512, 20000}) {
+    auto inputs = make_sort_inputs(n);
+
+    // Spans every byte, and the sign, of the integers
+    auto& wide = inputs.emplace_back();
+    unsigned int seed = 54321;
+
+    for (Int i = 0; i < n; ++i) {
+      seed = seed * 1103515245 + 12345;
+      wide.emplace_back(static_cast<Int>(seed));
+    }
+
+    for (const auto& input : inputs) {
+      for (const bool reverse : {false, true}) {
+        // If
+        List<Int> l;
+
+        for (const auto elem : input) {
+          l.Append(elem - n / 2);
+        }
+
+        // When
+        l.Sort(reverse);
+
+        // Then
+        auto expected = as_vector(l);
+        std::sort(expected.begin(), expected.end());
+
+        if (reverse) {
+          std::reverse(expected.begin(), expected.end());
+        }
+
+        ASSERT_EQ(as_vector(l), expected)
+            << "n=" << n << ", reverse=" << reverse;
+      }
+    }
+  }
+}
+
+TEST(List, SortFloatIsStable) {
+  for (const bool reverse : {false, true}) {
+    // If
+    const std::vector<Float> pattern = {
+        2.5, -0.0, -1e300, 0.0, std::numeric_limits<Float>::infinity(),
+        -2.5, 0.0, -std::numeric_limits<Float>::infinity(), -0.0, 1e-300};
+    List<Float> l;
+
+    for (Int i = 0; i < 200; ++i) {
+      for (const auto elem : pattern) {
+        l.Append(elem);
+      }
+    }
+
+    // When
+    l.Sort(reverse);
+
+    // Then
+    auto expected = as_vector(l);
+    std::stable_sort(expected.begin(), expected.end(),
+                     [reverse](const Float a, const Float b) {
+                       return reverse ? b < a : a < b;
+                     });
+
+    // -0.0 == 0.0, so also compare the signs to check that their order held
+    const auto actual = as_vector(l);
+    std::vector<bool> actual_signs;
+    std::vector<bool> expected_signs;
+
+    for (size_t i = 0; i < actual.size(); ++i) {
+      actual_signs.emplace_back(std::signbit(actual[i]));
+      expected_signs.emplace_back(std::signbit(expected[i]));
+    }
+
+    EXPECT_EQ(actual, expected) << "reverse=" << reverse;
+    EXPECT_EQ(actual_signs, expected_signs) << "reverse=" << reverse;
+  }
+}
+
+TEST(List, SortFloatWithNaN) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 5000; ++i) {
+    l.Append(i % 7 == 0 ? std::numeric_limits<Float>::quiet_NaN()
+                        : static_cast<Float>((i * 37) % 101));
+  }
+
+  auto expected = as_vector(l);
+
+  // When
+  l.Sort();
+
+  // Then
+  // NaN has no place in the order, so the list is sorted like CPython would,
+  // with TimSort, rather than with NaN moved to either end
+  __utils::TimSort(expected.begin(), expected.end(),
+                   [](const Float a, const Float b) { return a < b; });
+
+  const auto actual = as_vector(l);
+  ASSERT_EQ(actual.size(), expected.size());
+
+  for (size_t i = 0; i < actual.size(); ++i) {
+    if (std::isnan(expected[i])) {
+      ASSERT_TRUE(std::isnan(actual[i])) << "at " << i;
+    } else {
+      ASSERT_EQ(actual[i], expected[i]) << "at " << i;
+    }
+  }
+}
+
+TEST(List, SortBool) {
+  for (const bool reverse : {false, true}) {
+    // If
+    List<Bool> l;
+
+    for (Int i = 0; i < 1000; ++i) {
+      l.Append(i % 3 == 0);
+    }
+
+    // When
+    l.Sort(reverse);
+
+    // Then
+    std::vector<bool> expected(1000, reverse);
+    std::fill_n(expected.begin() + (reverse ? 334 : 666), reverse ? 666 : 334,
+                !reverse);
+
+    // Read through Pop(), since std::vector<bool> packs its elements and
+    // hands out proxies rather than references
+    std::vector<bool> actual(1000);
+
+    for (auto it = actual.rbegin(); it != actual.rend(); ++it) {
+      *it = l.Pop();
+    }
+
+    EXPECT_EQ(actual, expected) << "reverse=" << reverse;
+  }
+}
+
+TEST(List, SortInParallel) {
+  // If
+  const ParallelSortThresholdGuard guard(1000);
+
+  for (const Int n : {999, 1000, 20000}) {
+    for (const auto& input : make_sort_inputs(n)) {
+      for (const bool reverse : {false, true}) {
+        List<Int> l;
+
+        for (const auto elem : input) {
+          l.Append(elem);
+        }
+
+        // When
+        l.Sort(reverse);
+
+        // Then
+        auto expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        if (reverse) {
+          std::reverse(expected.begin(), expected.end());
+        }
+
+        ASSERT_EQ(as_vector(l), expected)
+            << "n=" << n << ", reverse=" << reverse;
+      }
+    }
+  }
+}
+
+TEST(List, SortWithKeyInParallelIsStable) {
+  // If
+  const ParallelSortThresholdGuard guard(1000);
+
+  for (const auto& input : make_sort_inputs(20000)) {
+    for (const bool reverse : {false, true}) {
+      List<Int> l;
+
+      for (const auto elem : input) {
+        l.Append(elem);
+      }
+
+      const auto key = [](const Int i) -> Int { return i / 8; };
+
+      // When
+      l.Sort(key, reverse);
+
+      // Then
+      auto expected = input;
+      std::stable_sort(expected.begin(), expected.end(),
+                       [&key, reverse](const Int a, const Int b) {
+                         return reverse ? key(b) < key(a) : key(a) < key(b);
+                       });
+
+      ASSERT_EQ(as_vector(l), expected) << "reverse=" << reverse;
+    }
+  }
+}
+
+TEST(List, SortInParallelStableObject) {
+  // If
+  const ParallelSortThresholdGuard guard(1000);
+  IntWrapper::ResetId();
+
+  const auto input = make_sort_inputs(20000)[0];
+  List<IntWrapper> l;
+
+  for (const auto elem : input) {
+    l.Append(IntWrapper::Init(elem / 8));
+  }
+
+  // When
+  l.Sort();
+
+  // Then
+  for (size_t i = 1; i < Len(l); ++i) {
+    ASSERT_LE(l[i - 1]->Value(), l[i]->Value()) << "at " << i;
+
+    if (l[i - 1]->Value() == l[i]->Value()) {
+      ASSERT_LT(l[i - 1]->Id(), l[i]->Id()) << "at " << i;
+    }
+  }
+}
+
 }  // namespace mamba::builtins::test
@@ -0,0 +1,278 @@
+#include <memory_resource>  // for memory_resource, new_delete_resource
+#include <thread>           // for thread
+#include <utility>          // for move
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/__memory/arena.hpp"      // for Arena
+#include "mamba/__memory/handle.hpp"     // for Init
+#include "mamba/__memory/intrusive.hpp"  // for IntrusiveHandle, RefCounted
+#include "mamba/__memory/pool.hpp"       // for FreeListResource, PoolResource
+#include "mamba/__memory/resource.hpp"   // for CountingResource, ResourceScope
+#include "mamba/builtins/int.hpp"        // for Int
+#include "mamba/builtins/iteration.hpp"  // for Iterator, Next
+#include "mamba/builtins/list.hpp"       // for List
+
+namespace mamba::builtins::test {
+namespace {
+
+struct Base {
+  virtual ~Base() = default;
+};
+
+struct Counted : public Base, public __memory::RefCounted {
+  explicit Counted(bool& destroyed) : destroyed_(destroyed) {}
+  ~Counted() override { destroyed_ = true; }
+
+  bool& destroyed_;
+};
+
+}  // anonymous namespace
+
+TEST(Memory, DefaultResourceIsGlobalHeap) {
+  // If/when
+  const auto* resource = __memory::CurrentResource();
+
+  // Then
+  EXPECT_EQ(resource, std::pmr::new_delete_resource());
+}
+
+TEST(Memory, ResourceScopeRestoresPreviousResource) {
+  // If
+  __memory::CountingResource outer_resource;
+  __memory::CountingResource inner_resource;
+
+  // When/then
+  {
+    __memory::ResourceScope outer(&outer_resource);
+    EXPECT_EQ(__memory::CurrentResource(), &outer_resource);
+
+    {
+      __memory::ResourceScope inner(&inner_resource);
+      EXPECT_EQ(__memory::CurrentResource(), &inner_resource);
+    }
+
+    EXPECT_EQ(__memory::CurrentResource(), &outer_resource);
+  }
+
+  EXPECT_EQ(__memory::CurrentResource(), std::pmr::new_delete_resource());
+}
+
+TEST(Memory, InitAllocatesFromCurrentResource) {
+  // If
+  __memory::CountingResource resource;
+  __memory::ResourceScope scope(&resource);
+
+  // When
+  {
+    const auto l = List<Int>::Init(1, 3, 5, 7);
+
+    // Then
+    EXPECT_EQ(l->Len(), 4);
+    EXPECT_EQ(resource.Stats().allocations, 1);
+    EXPECT_EQ(resource.Stats().deallocations, 0);
+  }
+
+  EXPECT_EQ(resource.Stats().allocations, 1);
+  EXPECT_EQ(resource.Stats().deallocations, 1);
+  EXPECT_EQ(resource.Stats().bytes_allocated,
+            resource.Stats().bytes_deallocated);
+}
+
+TEST(Memory, ArenaAllocatesHandlesInBulk) {
+  // If
+  __memory::Arena arena;
+
+  // When
+  for (Int i = 0; i < 100; ++i) {
+    const auto l = List<Int>::Init(i, i + 1);
+    ASSERT_EQ(l->Len(), 2);
+  }
+
+  // Then
+  EXPECT_EQ(__memory::CurrentResource(), arena.Resource());
+  EXPECT_EQ(arena.UpstreamStats().allocations, 1);
+}
+
+TEST(Memory, ArenaRestoresPreviousResource) {
+  // If/when
+  {
+    __memory::Arena arena;
+  }
+
+  // Then
+  EXPECT_EQ(__memory::CurrentResource(), std::pmr::new_delete_resource());
+}
+
+TEST(Memory, FreeListResourceReusesFreedBlocks) {
+  // If
+  __memory::CountingResource upstream;
+  __memory::FreeListResource pool(&upstream);
+
+  // When
+  for (int i = 0; i < 1000; ++i) {
+    void* ptr = pool.allocate(48, 8);
+    pool.deallocate(ptr, 48, 8);
+  }
+
+  // Then
+  EXPECT_EQ(upstream.Stats().allocations, 1);
+}
+
+TEST(Memory, FreeListResourceForwardsLargeBlocks) {
+  // If
+  __memory::CountingResource upstream;
+  __memory::FreeListResource pool(&upstream);
+
+  // When
+  void* ptr = pool.allocate(__memory::FreeListResource::kMaxBlockSize + 1);
+  pool.deallocate(ptr, __memory::FreeListResource::kMaxBlockSize + 1);
+
+  // Then
+  EXPECT_EQ(upstream.Stats().allocations, 1);
+  EXPECT_EQ(upstream.Stats().deallocations, 1);
+}
+
+TEST(Memory, IteratorsAreNotAllocatedFromCurrentResource) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+  __memory::CountingResource resource;
+  __memory::ResourceScope scope(&resource);
+
+  // When
+  auto it = l->Iter();
+
+  // Then
+  EXPECT_EQ(Next(it), 1);
+  EXPECT_EQ(resource.Stats().allocations, 0);
+}
+
+TEST(Memory, IteratorsReuseFreedBlocks) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+  const void* first = l->Iter().get();
+
+  // When
+  auto it = l->Iter();
+
+  // Then
+  EXPECT_EQ(it.get(), first);
+}
+
+TEST(Memory, IteratorsReleasedOnOtherThreadsAreReused) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+  auto it = l->Iter();
+  const void* first = it.get();
+
+  // When
+  std::thread([&it] { const auto released = std::move(it); }).join();
+
+  // Then
+  // The pool of this thread takes the block back on its next allocation
+  EXPECT_EQ(l->Iter().get(), first);
+}
+
+TEST(Memory, IteratorsOutliveTheThreadThatCreatedThem) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+  __memory::handle_t<Iterator<Int>> it;
+
+  // When
+  std::thread([&l, &it] {
+    it = l->Iter();
+    Next(it);
+  }).join();
+
+  // Then
+  EXPECT_EQ(Next(it), 3);
+  EXPECT_EQ(Next(it), 5);
+
+  // The pool of the exited thread is freed along with its last block
+  it = nullptr;
+}
+
+TEST(Memory, PooledBlocksCanBeFreedOnAnyThread) {
+  // If
+  void* ptr = nullptr;
+
+  // When
+  std::thread([&ptr] { ptr = __memory::AllocatePooled(40); }).join();
+
+  // Then
+  EXPECT_NE(ptr, nullptr);
+  __memory::DeallocatePooled(ptr, 40);
+}
+
+TEST(Memory, IntrusiveHandleCountsReferences) {
+  // If
+  bool destroyed = false;
+  auto h = __memory::InitIntrusive<Counted>(__memory::CurrentResource(),
+                                            destroyed);
+  ASSERT_EQ(h.use_count(), 1);
+
+  // When
+  {
+    const auto copy = h;
+
+    // Then
+    EXPECT_EQ(h.use_count(), 2);
+    EXPECT_EQ(copy, h);
+  }
+
+  EXPECT_EQ(h.use_count(), 1);
+  EXPECT_FALSE(destroyed);
+
+  h.reset();
+
+  EXPECT_TRUE(destroyed);
+}
+
+TEST(Memory, IntrusiveHandleConvertsToBase) {
+  // If
+  bool destroyed = false;
+  auto h = __memory::InitIntrusive<Counted>(__memory::CurrentResource(),
+                                            destroyed);
+
+  // When
+  __memory::IntrusiveHandle<Base> base = std::move(h);
+
+  // Then
+  EXPECT_FALSE(h);
+  EXPECT_EQ(base.use_count(), 1);
+
+  base.reset();
+
+  EXPECT_TRUE(destroyed);
+}
+
+TEST(Memory, IntrusiveHandleDeallocatesFromResource) {
+  // If
+  __memory::CountingResource resource;
+  bool destroyed = false;
+
+  // When
+  __memory::InitIntrusive<Counted>(&resource, destroyed);
+
+  // Then
+  EXPECT_TRUE(destroyed);
+  EXPECT_EQ(resource.Stats().allocations, 1);
+  EXPECT_EQ(resource.Stats().deallocations, 1);
+}
+
+TEST(Memory, IntrusiveHandleDoesNotDestroyUnmanagedObjects) {
+  // If
+  bool destroyed = false;
+  Counted local(destroyed);
+
+  // When
+  {
+    const __memory::IntrusiveHandle<Counted> h(&local);
+    EXPECT_EQ(h.use_count(), 1);
+  }
+
+  // Then
+  EXPECT_FALSE(destroyed);
+}
+
+}  // namespace mamba::builtins::test
@@ -0,0 +1,153 @@
+#include <atomic>  // for atomic
+#include <vector>  // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/__utils/thread_pool.hpp"  // for ThreadPool
+#include "mamba/builtins/error.hpp"       // for ValueError
+#include "mamba/builtins/int.hpp"         // for Int
+#include "mamba/builtins/list.hpp"        // for List
+#include "mamba/builtins/parallel.hpp"    // for ParallelFor, ParallelMap
+#include "mamba/builtins/range.hpp"       // for Range
+#include "mamba/builtins/tuple.hpp"       // for Tuple
+
+namespace mamba::builtins::test {
+
+TEST(ThreadPool, RunsSubmittedTasks) {
+  // If
+  __utils::ThreadPool pool(4);
+  std::atomic<Int> sum = 0;
+
+  // When
+  for (Int i = 1; i <= 100; ++i) {
+    pool.Submit([&sum, i] { sum += i; });
+  }
+
+  pool.WaitUntil([&sum] { return sum.load() == 5050; });
+
+  // Then
+  EXPECT_EQ(sum.load(), 5050);
+  EXPECT_EQ(pool.Size(), 4);
+}
+
+TEST(ParallelFor, List) {
+  // If
+  List<Int> l;
+
+  for (Int i = 0; i < 10000; ++i) {
+    l.Append(i);
+  }
+
+  // When
+  std::atomic<Int> sum = 0;
+  ParallelFor(l, [&sum](Int i) { sum += i; });
+
+  // Then
+  EXPECT_EQ(sum.load(), 49995000);
+}
+
+TEST(ParallelFor, ListHandle) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+
+  // When
+  std::atomic<Int> sum = 0;
+  ParallelFor(l, [&sum](Int i) { sum += i; });
+
+  // Then
+  EXPECT_EQ(sum.load(), 9);
+}
+
+TEST(ParallelFor, Tuple) {
+  // If
+  const Tuple<Int> t = {1, 3, 5, 7};
+
+  // When
+  std::atomic<Int> sum = 0;
+  ParallelFor(t, [&sum](Int i) { sum += i; });
+
+  // Then
+  EXPECT_EQ(sum.load(), 16);
+}
+
+TEST(ParallelFor, RangeVisitsEachElementOnce) {
+  // If
+  const Int n = 100000;
+  std::vector<std::atomic<Int>> visits(n);
+
+  // When
+  ParallelFor(Range(n), [&visits](Int i) { ++visits[i]; });
+
+  // Then
+  for (Int i = 0; i < n; ++i) {
+    ASSERT_EQ(visits[i].load(), 1) << "at " << i;
+  }
+}
+
+TEST(ParallelFor, Empty) {
+  // If
+  const List<Int> l;
+
+  // When
+  Int calls = 0;
+  ParallelFor(l, [&calls](Int) { ++calls; });
+
+  // Then
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(ParallelFor, Nested) {
+  // If/when
+  std::atomic<Int> sum = 0;
+
+  ParallelFor(Range(64), [&sum](Int) {
+    ParallelFor(Range(1000), [&sum](Int j) { sum += j; });
+  });
+
+  // Then
+  EXPECT_EQ(sum.load(), 64 * 499500);
+}
+
+TEST(ParallelFor, RethrowsExceptions) {
+  // If
+  const Range r(10000);
+
+  // When/then
+  EXPECT_THROW(ParallelFor(r,
+                           [](Int i) {
+                             if (i == 7777) {
+                               throw ValueError("bad element");
+                             }
+                           }),
+               ValueError);
+}
+
+TEST(ParallelMap, KeepsOrder) {
+  // If
+  const Range r(5000);
+
+  // When
+  const auto l = ParallelMap([](Int i) { return i * 2; }, r);
+
+  // Then
+  ASSERT_EQ(l->Len(), 5000);
+
+  for (Int i = 0; i < 5000; ++i) {
+    ASSERT_EQ((*l)[i], i * 2);
+  }
+}
+
+TEST(ParallelMap, ListHandle) {
+  // If
+  const auto l = List<Int>::Init(1, 3, 5);
+
+  // When
+  const auto actual = ParallelMap([](Int i) { return i + 1; }, l);
+
+  // Then
+  EXPECT_EQ(actual->Len(), 3);
+  EXPECT_EQ((*actual)[0], 2);
+  EXPECT_EQ((*actual)[2], 6);
+}
+
+}  // namespace mamba::builtins::test
@@ -0,0 +1,179 @@
+#include <optional>  // for nullopt
+#include <vector>    // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/builtins/adaptors.hpp"    // for Reversed
+#include "mamba/builtins/error.hpp"       // for ValueError, IndexError
+#include "mamba/builtins/int.hpp"         // for Int
+#include "mamba/builtins/iteration.hpp"   // for ForEach, NextBatch
+#include "mamba/builtins/list.hpp"        // for List
+#include "mamba/builtins/range.hpp"       // for Range
+#include "mamba/builtins/sequence.hpp"    // for Len, Contains, Sum, Any
+#include "mamba/builtins/slice_view.hpp"  // for kEndIndex
+
+namespace mamba::builtins::test {
+namespace {
+
+std::vector<Int> as_vector(const Range& r) {
+  return std::vector<Int>(r.begin(), r.end());
+}
+
+}  // anonymous namespace
+
+TEST(Range, StopConstructor) {
+  // If/when
+  const Range r(4);
+
+  // Then
+  const std::vector<Int> expected = {0, 1, 2, 3};
+  EXPECT_EQ(as_vector(r), expected);
+  EXPECT_EQ(Len(r), 4);
+}
+
+TEST(Range, StepConstructor) {
+  // If/when
+  const Range r(1, 10, 3);
+
+  // Then
+  const std::vector<Int> expected = {1, 4, 7};
+  EXPECT_EQ(as_vector(r), expected);
+  EXPECT_EQ(Len(r), 3);
+}
+
+TEST(Range, NegativeStep) {
+  // If/when
+  const Range r(5, -1, -2);
+
+  // Then
+  const std::vector<Int> expected = {5, 3, 1};
+  EXPECT_EQ(as_vector(r), expected);
+  EXPECT_EQ(Min(r), 1);
+  EXPECT_EQ(Max(r), 5);
+}
+
+TEST(Range, Empty) {
+  // If/when
+  const Range r(3, 1);
+
+  // Then
+  EXPECT_EQ(Len(r), 0);
+  EXPECT_FALSE(r);
+  EXPECT_THROW(Min(r), ValueError);
+  EXPECT_THROW(Max(r), ValueError);
+}
+
+TEST(Range, ZeroStep) {
+  // If/when/then
+  EXPECT_THROW(Range(0, 1, 0), ValueError);
+}
+
+TEST(Range, Contains) {
+  // If
+  const Range r(1, 10, 3);
+
+  // When/then
+  EXPECT_TRUE(Contains(r, 4));
+  EXPECT_FALSE(Contains(r, 5));
+  EXPECT_FALSE(Contains(r, 10));
+  EXPECT_FALSE(Contains(r, -2));
+  EXPECT_EQ(r.Index(7), 2);
+  EXPECT_THROW(r.Index(5), ValueError);
+}
+
+TEST(Range, Reduce) {
+  // If
+  const Range r(-3, 10, 3);
+
+  // When/then
+  EXPECT_EQ(Sum(r), 15);
+  EXPECT_EQ(Sum(r, 8), 23);
+  EXPECT_TRUE(Any(r));
+  EXPECT_FALSE(All(r));
+  EXPECT_TRUE(All(Range(1, 4)));
+  EXPECT_FALSE(Any(Range(0)));
+}
+
+TEST(Range, Index) {
+  // If
+  const Range r(1, 10, 3);
+
+  // When/then
+  EXPECT_EQ(r[0], 1);
+  EXPECT_EQ(r[-1], 7);
+  EXPECT_THROW(r[3], IndexError);
+  EXPECT_THROW(r[-4], IndexError);
+}
+
+TEST(Range, Slice) {
+  // If
+  const Range r(0, 20, 2);
+
+  // When
+  const auto sliced = r.Slice(1, kEndIndex, 3);
+
+  // Then
+  const std::vector<Int> expected = {2, 8, 14};
+  EXPECT_EQ(as_vector(*sliced), expected);
+  EXPECT_EQ(sliced->Repr(), "range(2, 20, 6)");
+}
+
+TEST(Range, Eq) {
+  // If/when/then
+  EXPECT_TRUE(Range(0).Eq(Range(2, 2)));
+  EXPECT_TRUE(Range(1, 2, 5).Eq(Range(1, 3, 7)));
+  EXPECT_TRUE(Range(0, 6, 2).Eq(Range(0, 5, 2)));
+  EXPECT_FALSE(Range(0, 6, 2).Eq(Range(0, 6, 3)));
+}
+
+TEST(Range, Repr) {
+  // If/when/then
+  EXPECT_EQ(Range(3).Repr(), "range(0, 3)");
+  EXPECT_EQ(Range(3, 0, -1).Repr(), "range(3, 0, -1)");
+}
+
+TEST(Range, Iter) {
+  // If
+  const Range r(2);
+
+  // When
+  const auto it = Iter(r);
+
+  // Then
+  EXPECT_EQ(TryNext(it), 0);
+  EXPECT_EQ(TryNext(it), 1);
+  EXPECT_EQ(TryNext(it), std::nullopt);
+}
+
+TEST(Range, IterNextBatch) {
+  // If
+  const Range r(0, 10, 3);
+  const auto it = Iter(r);
+  std::vector<Int> batch(8);
+
+  // When
+  const auto n = NextBatch<Int>(it, batch);
+
+  // Then
+  EXPECT_EQ(n, 4);
+  EXPECT_EQ(batch[0], 0);
+  EXPECT_EQ(batch[3], 9);
+  EXPECT_EQ(TryNext(it), std::nullopt);
+}
+
+TEST(Range, ForEachAndReversed) {
+  // If
+  const Range r(3);
+
+  // When
+  const List<Int> l(Reversed(r));
+  Int sum = 0;
+  ForEach(r, [&sum](Int i) { sum += i; });
+
+  // Then
+  EXPECT_EQ(sum, 3);
+  EXPECT_EQ(l[0], 2);
+  EXPECT_EQ(l[2], 0);
+}
+
+}  // namespace mamba::builtins::test
@@ -0,0 +1,134 @@
+#include <vector>  // for vector
+
+#include "gtest/gtest.h"  // for Test, TEST
+
+#include "mamba/builtins/error.hpp"       // for IndexError, StopIteration
+#include "mamba/builtins/int.hpp"         // for Int
+#include "mamba/builtins/iteration.hpp"   // for Next
+#include "mamba/builtins/list.hpp"        // for List
+#include "mamba/builtins/sequence.hpp"    // for Len, Contains, Max, Min
+#include "mamba/builtins/slice_view.hpp"  // for SliceView
+#include "mamba/builtins/tuple.hpp"       // for Tuple
+
+namespace mamba::builtins::test {
+
+TEST(SliceView, EmptyConstructor) {
+  // If/when
+  const SliceView<Int> v;
+
+  // Then
+  EXPECT_EQ(Len(v), 0);
+  EXPECT_FALSE(v);
+}
+
+TEST(SliceView, ViewDoesNotCopy) {
+  // If
+  const List<Int> l = {1, 3, 5, 7};
+
+  // When
+  const auto v = l.View(1, 3);
+
+  // Then
+  EXPECT_EQ(Len(v), 2);
+  EXPECT_EQ(&v[0], &l[1]);
+  EXPECT_EQ(&v[1], &l[2]);
+}
+
+TEST(SliceView, ViewStepped) {
+  // If
+  const List<Int> l = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  // When
+  const auto v = l.View(1, kEndIndex, 3);
+
+  // Then
+  const std::vector<Int> actual(v.begin(), v.end());
+  const std::vector<Int> expected = {1, 4, 7};
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(SliceView, ViewNegativeIndices) {
+  // If
+  const List<Int> l = {1, 3, 5, 7};
+
+  // When
+  const auto v = l.View(-3, -1);
+
+  // Then
+  EXPECT_EQ(Len(v), 2);
+  EXPECT_EQ(v[0], 3);
+  EXPECT_EQ(v[-1], 5);
+  EXPECT_THROW(v[2], IndexError);
+}
+
+TEST(SliceView, ViewNegativeStep) {
+  // If
+  const List<Int> l = {1, 3, 5, 7};
+
+  // When
+  const auto v = l.View(0, 3, -1);
+
+  // Then
+  EXPECT_EQ(Len(v), 0);
+}
+
+TEST(SliceView, Sequence) {
+  // If
+  const Tuple<Int> t = {7, 3, 9, 1, 5};
+
+  // When
+  const auto v = t.View(0, kEndIndex, 2);
+
+  // Then
+  EXPECT_EQ(Len(v), 3);
+  EXPECT_EQ(Min(v), 5);
+  EXPECT_EQ(Max(v), 9);
+  EXPECT_TRUE(Contains(v, 9));
+  EXPECT_FALSE(Contains(v, 3));
+  EXPECT_EQ(v.Count(7), 1);
+}
+
+TEST(SliceView, Iter) {
+  // If
+  const List<Int> l = {1, 3, 5, 7};
+  const auto v = l.View(1);
+
+  // When
+  auto it = v.Iter();
+
+  // Then
+  EXPECT_EQ(Next(it), 3);
+  EXPECT_EQ(Next(it), 5);
+  EXPECT_EQ(Next(it), 7);
+  EXPECT_THROW(Next(it), StopIteration);
+}
+
+TEST(SliceView, Materialize) {
+  // If
+  List<Int> l = {1, 3, 5, 7};
+  const auto v = l.View(0, kEndIndex, 2);
+
+  // When
+  auto materialized = List<Int>::Init(v);
+  l[0] = 2;
+
+  // Then
+  EXPECT_EQ(materialized->Len(), 2);
+  EXPECT_EQ((*materialized)[0], 1);
+  EXPECT_EQ((*materialized)[1], 5);
+}
+
+TEST(SliceView, EqAndRepr) {
+  // If
+  const List<Int> l = {1, 3, 1, 3};
+
+  // When
+  const auto first = l.View(0, 2);
+  const auto second = l.View(2);
+
+  // Then
+  EXPECT_TRUE(first.Eq(second));
+  EXPECT_EQ(first.Repr(), "[1, 3]");
+}
+
+}  // namespace mamba::builtins::test
@@ -2,8 +2,12 @@
 
 #include "gtest/gtest.h"  // for Test, TEST
 
-#include "mamba/builtins/int.hpp"    // for Int
-#include "mamba/builtins/tuple.hpp"  // for Tuple
+#include "mamba/builtins/error.hpp"     // for ValueError
+#include "mamba/builtins/float.hpp"     // for Float
+#include "mamba/builtins/int.hpp"       // for Int
+#include "mamba/builtins/list.hpp"      // for List
+#include "mamba/builtins/sequence.hpp"  // for Sum, Any, All, Min, Max
+#include "mamba/builtins/tuple.hpp"     // for Tuple
 
 namespace mamba::builtins::test {
 
@@ -15,4 +19,79 @@ TEST(Tuple, EmptyConstructor) {
   EXPECT_EQ(t.Len(), 0);
 }
 
+TEST(Tuple, CopyIsTheSameTuple) {
+  // If
+  const auto t = Tuple<Int>::Init(1, 3, 5);
+
+  // When
+  const auto copy = t->Copy();
+
+  // Then
+  EXPECT_EQ(copy, t);
+}
+
+TEST(Tuple, CopyOfLocal) {
+  // If
+  const Tuple<Int> t = {1, 3, 5};
+
+  // When
+  const auto copy = t.Copy();
+
+  // Then
+  EXPECT_NE(&(*copy)[0], &t[0]);
+  EXPECT_EQ(copy->Len(), 3);
+  EXPECT_EQ((*copy)[2], 5);
+}
+
+TEST(Tuple, AdditionOperator) {
+  // If
+  const Tuple<Int> t = {1, 3};
+  const Tuple<Int> other = {5, 7};
+
+  // When
+  const auto res = t + other;
+
+  // Then
+  EXPECT_EQ(res->Len(), 4);
+  EXPECT_EQ((*res)[0], 1);
+  EXPECT_EQ((*res)[3], 7);
+  EXPECT_EQ(t.Len(), 2);
+}
+
+TEST(Tuple, SearchLong) {
+  // If
+  List<Int> l;
+
+  for (Int i = 0; i < 1000; ++i) {
+    l.Append(i % 100);
+  }
+
+  const Tuple<Int> t(l);
+
+  // When/then
+  EXPECT_TRUE(t.Contains(99));
+  EXPECT_FALSE(t.Contains(100));
+  EXPECT_EQ(t.Count(42), 10);
+  EXPECT_EQ(t.Index(42, 43), 142);
+  EXPECT_THROW(t.Index(42, 100, 142), ValueError);
+}
+
+TEST(Tuple, Reduce) {
+  // If
+  List<Float> l;
+
+  for (Int i = 0; i < 1000; ++i) {
+    l.Append(i % 100 - 50.5);
+  }
+
+  const Tuple<Float> t(l);
+
+  // When/then
+  EXPECT_EQ(Sum(t), -1000.0);
+  EXPECT_EQ(Min(t), -50.5);
+  EXPECT_EQ(Max(t), 48.5);
+  EXPECT_TRUE(Any(t));
+  EXPECT_TRUE(All(t));
+}
+
 }  // namespace mamba::builtins::test
@@ -0,0 +1,434 @@
+import ast
+import enum
+
+from typing import Iterator, Optional, Union
+
+
+class Representation(enum.Enum):
+    # Plain value with automatic storage, e.g. mamba::list_t<T>
+    VALUE = "value"
+    # Reference-counted handle to a heap object, e.g. mamba::handle_t<...>
+    HANDLE = "handle"
+
+
+FunctionLike = Union[ast.Module, ast.FunctionDef]
+
+CONTAINER_TYPES: "set[str]" = {"dict", "list", "set", "tuple"}
+
+# Builtins that only read their arguments and never keep a reference to them
+NON_ESCAPING_CALLS: "set[str]" = {
+    "all",
+    "any",
+    "bool",
+    "dict",
+    "len",
+    "list",
+    "max",
+    "min",
+    "parallel",
+    "parallel_map",
+    "print",
+    "repr",
+    "set",
+    "sorted",
+    "str",
+    "sum",
+    "tuple",
+}
+
+# Builtins that return lazy iterators over their arguments, which therefore
+# live as long as the iterators
+ADAPTOR_CALLS: "set[str]" = {"enumerate", "filter", "map", "reversed", "zip"}
+
+# Expressions that are lowered to C++ lambdas, e.g. (f(x) for x in xs) becomes
+# Map([&](auto x) { return f(x); }, xs)
+CLOSURE_NODES = (ast.GeneratorExp, ast.Lambda, ast.ListComp)
+
+# Expressions that always evaluate to a new container
+FRESH_CONTAINER_NODES = (
+    ast.Dict,
+    ast.DictComp,
+    ast.List,
+    ast.ListComp,
+    ast.Set,
+    ast.SetComp,
+    ast.Tuple,
+)
+
+# Methods of sequences that only read them
+READ_ONLY_METHODS: "set[str]" = {"count", "index"}
+
+NESTED_SCOPE_NODES = (
+    ast.AsyncFunctionDef,
+    ast.ClassDef,
+    ast.FunctionDef,
+    ast.Lambda,
+)
+
+# Parents that only read the container or copy its elements, e.g. x + y,
+# for i in x, if x, print(*x). Subscripts only read the container that they
+# index, not one that is the index, see EscapeAnalyzer._escapes()
+NON_ESCAPING_PARENTS = (
+    ast.AugAssign,
+    ast.BinOp,
+    ast.Compare,
+    ast.Delete,
+    ast.Expr,
+    ast.For,
+    ast.FormattedValue,
+    ast.If,
+    ast.Starred,
+    ast.Subscript,
+    ast.UnaryOp,
+    ast.While,
+    ast.comprehension,
+)
+
+
+def analyze(function: FunctionLike) -> "dict[str, Representation]":
+    """Picks a representation for every local container of function.
+
+    A local can be a value if it is only ever bound to new containers and is
+    never returned, yielded, aliased, stored into another object, passed to a
+    function that might keep it, or captured by a nested scope. Parameters
+    belong to the caller and are never values.
+    """
+    return EscapeAnalyzer(function=function).run()
+
+
+def find_read_only_slices(function: FunctionLike) -> "set[ast.Subscript]":
+    """Returns the slice expressions of function, e.g. xs[i:j], whose result is
+    only read where it is created, so that it can be a view of xs rather than
+    a new list. Only local containers that analyze() keeps as values, and that
+    do not change while the view is alive, can be viewed. Slices that are
+    bound, returned, passed to unknown callees, etc. must be materialized."""
+    return EscapeAnalyzer(function=function).read_only_slices()
+
+
+def find_scoped_closures(function: FunctionLike) -> "set[ast.expr]":
+    """Returns the lambdas and comprehensions of function that are only used by
+    the statement that creates them, e.g. the iterable of a for loop or an
+    argument of sum(), so that they can capture locals by reference. Any other
+    closure may outlive the locals that it uses and must capture them by
+    value."""
+    return EscapeAnalyzer(function=function).scoped_closures()
+
+
+def is_container_annotation(annotation: Optional[ast.expr]) -> bool:
+    if isinstance(annotation, ast.Subscript):
+        annotation = annotation.value
+
+    return isinstance(annotation, ast.Name) and annotation.id in CONTAINER_TYPES
+
+
+def is_fresh_container(value: Optional[ast.expr]) -> bool:
+    if isinstance(value, FRESH_CONTAINER_NODES):
+        return True
+
+    if isinstance(value, ast.Call) and isinstance(value.func, ast.Name):
+        return value.func.id in CONTAINER_TYPES or value.func.id == "sorted"
+
+    # Concatenation and repetition create new containers
+    return isinstance(value, ast.BinOp) and isinstance(value.op, (ast.Add, ast.Mult))
+
+
+class EscapeAnalyzer:
+    def __init__(self, function: FunctionLike) -> None:
+        self._function: FunctionLike = function
+        self._parents: "dict[ast.AST, ast.AST]" = {}
+        self._candidates: "set[str]" = set()
+        self._escaping: "set[str]" = set()
+        # Containers that are values, see read_only_slices()
+        self._values: "set[str]" = set()
+
+    def run(self) -> "dict[str, Representation]":
+        self._link_parents()
+        self._collect_candidates()
+        self._collect_escapes()
+
+        return {
+            name: (
+                Representation.HANDLE
+                if name in self._escaping
+                else Representation.VALUE
+            )
+            for name in self._candidates
+        }
+
+    def read_only_slices(self) -> "set[ast.Subscript]":
+        self._link_parents()
+        # Only containers that nothing else refers to can be viewed safely
+        self._values = {
+            name
+            for name, representation in self.run().items()
+            if representation is Representation.VALUE
+        }
+
+        return {
+            node
+            for node in self._own_nodes()
+            if isinstance(node, ast.Subscript)
+            and isinstance(node.slice, ast.Slice)
+            and isinstance(node.ctx, ast.Load)
+            and self._is_read_only(node)
+            and self._is_unchanged_during(node)
+        }
+
+    def scoped_closures(self) -> "set[ast.expr]":
+        self._link_parents()
+
+        return {
+            node
+            for node in self._own_nodes()
+            if isinstance(node, CLOSURE_NODES) and not self._outlives_statement(node)
+        }
+
+    def _link_parents(self) -> None:
+        for node in ast.walk(self._function):
+            for child in ast.iter_child_nodes(node):
+                self._parents[child] = node
+
+    def _own_nodes(self) -> Iterator[ast.AST]:
+        """Yields the nodes of the function but not those of nested scopes,
+        whose locals are separate."""
+        stack = list(ast.iter_child_nodes(self._function))
+
+        while stack:
+            node = stack.pop()
+            yield node
+
+            if not isinstance(node, NESTED_SCOPE_NODES):
+                stack.extend(ast.iter_child_nodes(node))
+
+    def _collect_candidates(self) -> None:
+        for node in self._own_nodes():
+            if isinstance(node, ast.AnnAssign) and isinstance(node.target, ast.Name):
+                if is_container_annotation(node.annotation):
+                    self._candidates.add(node.target.id)
+            elif isinstance(node, ast.Assign) and is_fresh_container(node.value):
+                for target in node.targets:
+                    if isinstance(target, ast.Name):
+                        self._candidates.add(target.id)
+
+        if isinstance(self._function, ast.FunctionDef):
+            arguments: ast.arguments = self._function.args
+
+            for arg in [
+                *arguments.posonlyargs,
+                *arguments.args,
+                *arguments.kwonlyargs,
+            ]:
+                self._candidates.discard(arg.arg)
+
+    def _collect_escapes(self) -> None:
+        for node in self._own_nodes():
+            if isinstance(node, (ast.Global, ast.Nonlocal)):
+                self._escaping.update(node.names)
+            elif isinstance(node, (ast.Assign, ast.AnnAssign)):
+                # Binding anything but a new container aliases another object
+                if node.value is None or is_fresh_container(node.value):
+                    continue
+
+                targets: "list[ast.expr]" = (
+                    node.targets if isinstance(node, ast.Assign) else [node.target]
+                )
+
+                for target in targets:
+                    if isinstance(target, ast.Name):
+                        self._escaping.add(target.id)
+
+        # Comprehensions that outlive their statement capture the containers
+        # that they use by value, which must then be handles
+        for node in self._own_nodes():
+            if isinstance(
+                node, (ast.GeneratorExp, ast.ListComp)
+            ) and self._outlives_statement(node):
+                self._escaping.update(
+                    i.id
+                    for i in ast.walk(node)
+                    if isinstance(i, ast.Name)
+                    and isinstance(i.ctx, ast.Load)
+                    and i.id in self._candidates
+                )
+
+        # Walks nested scopes too, so that captures are found
+        for node in ast.walk(self._function):
+            if (
+                isinstance(node, ast.Name)
+                and isinstance(node.ctx, ast.Load)
+                and node.id in self._candidates
+                and self._escapes(node)
+            ):
+                self._escaping.add(node.id)
+
+    def _in_nested_scope(self, node: ast.AST) -> bool:
+        parent: Optional[ast.AST] = self._parents.get(node)
+
+        while parent is not None and parent is not self._function:
+            if isinstance(parent, NESTED_SCOPE_NODES):
+                return True
+
+            parent = self._parents.get(parent)
+
+        return False
+
+    def _escapes(self, node: ast.expr) -> bool:
+        if self._in_nested_scope(node):
+            return True
+
+        parent: Optional[ast.AST] = self._parents.get(node)
+
+        if isinstance(parent, (ast.Return, ast.Yield, ast.YieldFrom, ast.Await)):
+            return True
+
+        if isinstance(parent, (ast.Assign, ast.AnnAssign, ast.NamedExpr)):
+            return parent.value is node
+
+        if isinstance(parent, ast.keyword):
+            return self._escapes_as_argument(call=self._parents.get(parent))
+
+        if isinstance(parent, ast.Call):
+            return parent.func is node or self._escapes_as_argument(call=parent)
+
+        if isinstance(parent, ast.Attribute):
+            # Calling a method, e.g. x.append(1), is fine, but a bound method
+            # keeps a reference to x
+            grandparent: Optional[ast.AST] = self._parents.get(parent)
+            return not (
+                isinstance(grandparent, ast.Call) and grandparent.func is parent
+            )
+
+        if isinstance(parent, ast.Subscript):
+            # x[0] reads x, but d[x] = 1 stores x as a key, and a lookup of x
+            # may hash or keep it too
+            return parent.value is not node
+
+        if isinstance(parent, ast.IfExp) and parent.test is node:
+            return False
+
+        if isinstance(parent, (ast.BoolOp, ast.IfExp)):
+            # These evaluate to one of their operands, e.g. x or y
+            return self._escapes(node=parent)
+
+        if isinstance(parent, NON_ESCAPING_PARENTS):
+            return False
+
+        # Anything else, e.g. being an element of a container literal, stores
+        # a reference to the container somewhere else
+        return True
+
+    def _outlives_statement(self, node: ast.expr) -> bool:
+        """Returns whether the value of node, e.g. a lazy iterator, may still be
+        used once the statement that evaluates it is done."""
+        parent: Optional[ast.AST] = self._parents.get(node)
+
+        if (
+            isinstance(parent, ast.Call)
+            and isinstance(parent.func, ast.Name)
+            and parent.func.id in ADAPTOR_CALLS
+            and parent.func is not node
+        ):
+            return self._outlives_statement(node=parent)
+
+        # Comprehensions iterate over their iterable lazily too
+        if isinstance(parent, ast.comprehension) and parent.iter is node:
+            return self._outlives_statement(node=self._parents.get(parent))
+
+        # yield from exhausts its iterable before the statement is done
+        if isinstance(parent, ast.YieldFrom):
+            return False
+
+        # List comprehensions that are bound or returned are materialized
+        if isinstance(node, ast.ListComp) and isinstance(
+            parent, (ast.AnnAssign, ast.Assign, ast.Return)
+        ):
+            return False
+
+        return self._escapes(node=node)
+
+    def _is_read_only(self, node: ast.expr) -> bool:
+        parent: Optional[ast.AST] = self._parents.get(node)
+
+        if isinstance(parent, ast.Call):
+            return parent.func is not node and not self._escapes_as_argument(
+                call=parent
+            )
+
+        if isinstance(parent, ast.Attribute):
+            grandparent: Optional[ast.AST] = self._parents.get(parent)
+            return (
+                isinstance(grandparent, ast.Call)
+                and grandparent.func is parent
+                and parent.attr in READ_ONLY_METHODS
+            )
+
+        if isinstance(parent, ast.For):
+            return parent.iter is node
+
+        if isinstance(parent, ast.comprehension):
+            return parent.iter is node and not self._outlives_statement(
+                node=self._parents.get(parent)
+            )
+
+        return isinstance(parent, (ast.Compare, ast.Expr, ast.Subscript))
+
+    def _is_unchanged_during(self, node: ast.Subscript) -> bool:
+        """Returns whether the container that node slices is neither mutated nor
+        rebound by the statement that evaluates node, including the body of a
+        for loop over it, so that a view of it stays valid. Parameters and
+        handles may be mutated through other references, e.g. by the caller
+        while a generator is suspended, so only local values qualify."""
+        if not (isinstance(node.value, ast.Name) and node.value.id in self._values):
+            return False
+
+        name: str = node.value.id
+        statement: Optional[ast.AST] = self._parents.get(node)
+
+        while statement is not None and not isinstance(statement, ast.stmt):
+            statement = self._parents.get(statement)
+
+        if statement is None:
+            return False
+
+        # Walks nested scopes too, e.g. a lambda that appends to the container
+        for i in ast.walk(statement):
+            if isinstance(i, (ast.Await, ast.Yield, ast.YieldFrom)):
+                # The caller runs while the view is alive
+                return False
+
+            if not isinstance(i, ast.Name) or i.id != name:
+                continue
+
+            if not isinstance(i.ctx, ast.Load):
+                # e.g. xs = [], for xs in ..., del xs, xs += ys
+                return False
+
+            parent: Optional[ast.AST] = self._parents.get(i)
+
+            if isinstance(parent, ast.Subscript) and parent.value is i:
+                # e.g. xs[0] = 1, xs[0] += 1, del xs[0]
+                if not isinstance(parent.ctx, ast.Load):
+                    return False
+            elif isinstance(parent, ast.Attribute):
+                # Only calls to read-only methods, not e.g. xs.append(x)
+                grandparent: Optional[ast.AST] = self._parents.get(parent)
+
+                if not (
+                    isinstance(grandparent, ast.Call)
+                    and grandparent.func is parent
+                    and parent.attr in READ_ONLY_METHODS
+                ):
+                    return False
+            elif self._escapes(node=i):
+                # Aliases and unknown callees may mutate it too
+                return False
+
+        return True
+
+    def _escapes_as_argument(self, call: Optional[ast.AST]) -> bool:
+        if isinstance(call, ast.Call) and isinstance(call.func, ast.Name):
+            return call.func.id not in NON_ESCAPING_CALLS
+
+        # Unknown callees, including methods of other objects, e.g.
+        # other.append(x), may keep their arguments
+        return True
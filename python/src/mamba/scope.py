@@ -16,10 +16,15 @@ class ScopeBase:
     def symbols(self) -> Mapping[str, str]:
         return self._symbols
 
-    def define_symbol(self, name: str) -> None:
+    def define_symbol(self, name: str, decltype: str = "") -> None:
         if self.has_symbol(name=name):
             raise SymbolAlreadyDefinedException(f"Symbol {name} already defined.")
 
+        self._symbols[name] = decltype
+
+    def symbol_type(self, name: str) -> Optional[str]:
+        return self._symbols.get(name)
+
     def has_symbol(self, name: str, decltype: Optional[str] = None) -> bool:
         if decltype:
             return name in self._symbols and self._symbols[name] == decltype
@@ -45,3 +50,9 @@ class Scope(ScopeBase):
             return True
 
         return self._parent.has_symbol(name, decltype=decltype)
+
+    def symbol_type(self, name: str) -> Optional[str]:
+        if name in self._symbols:
+            return self._symbols[name]
+
+        return self._parent.symbol_type(name)
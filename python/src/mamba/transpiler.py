@@ -2,7 +2,16 @@ import ast
 import io
 import sys
 
-from typing import Sequence
+from typing import Optional, Sequence
+from mamba.escape import (
+    NESTED_SCOPE_NODES,
+    READ_ONLY_METHODS,
+    Representation,
+    analyze,
+    find_read_only_slices,
+    find_scoped_closures,
+    is_container_annotation,
+)
 from mamba.scope import Scope, RootScope
 
 
@@ -29,26 +38,94 @@ class Transpiler:
         "tuple": "mamba::tuple_t",
     }
 
+    mamba_function_to_cpp: "dict[str, str]" = {
+        "enumerate": "Enumerate",
+        "filter": "Filter",
+        "len": "Len",
+        "map": "Map",
+        "parallel_map": "ParallelMap",
+        "print": "print",
+        "range": "Range",
+        "reversed": "Reversed",
+        "zip": "Zip",
+    }
+
+    # Builtins that create a container from any iterable
+    mamba_container_constructors: "set[str]" = {"list", "tuple"}
+
+    mamba_binary_operator_to_cpp: "dict[type, str]" = {
+        ast.Add: "+",
+        ast.Sub: "-",
+        ast.Mult: "*",
+    }
+
+    mamba_unary_operator_to_cpp: "dict[type, str]" = {
+        ast.Not: "!",
+        ast.UAdd: "+",
+        ast.USub: "-",
+    }
+
+    mamba_comparison_operator_to_cpp: "dict[type, str]" = {
+        ast.Eq: "==",
+        ast.NotEq: "!=",
+        ast.Lt: "<",
+        ast.LtE: "<=",
+        ast.Gt: ">",
+        ast.GtE: ">=",
+    }
+
+    mamba_boolean_operator_to_cpp: "dict[type, str]" = {
+        ast.And: "&&",
+        ast.Or: "||",
+    }
+
+    handle_type: str = "mamba::handle_t"
+
+    # Mamba-specific marker for loops whose iterations may run in parallel,
+    # e.g. for x in parallel(xs)
+    parallel_marker: str = "parallel"
+
+    generator_type: str = "mamba::generator_t"
+
+    # Type-erased iterator, e.g. of a parameter annotated Iterator[int], which
+    # any iterator, generators included, can be passed as
+    iterator_type: str = "mamba::iterator_t"
+
+    # Annotations of generator functions, e.g. Iterator[int], whose first
+    # argument is the type of the yielded values
+    mamba_generator_annotations: "set[str]" = {"Generator", "Iterable", "Iterator"}
+
     def __init__(self, buffer: io.StringIO, module: ast.Module) -> None:
         self._module: ast.Module = module
         self._buffer: io.StringIO = buffer
-        self._root_scope: RootScope = RootScope
+        self._root_scope: RootScope = RootScope()
         self._non_root_scopes: Sequence[Scope] = []
+        # Representation of each local container of the function being emitted
+        self._representations: "dict[str, Representation]" = {}
+        # Slices of the function being emitted that can be views
+        self._read_only_slices: "set[ast.Subscript]" = set()
+        # Closures of the function being emitted that can capture by reference
+        self._scoped_closures: "set[ast.expr]" = set()
+        # Whether each enclosing loop is parallel, innermost last
+        self._loops: "list[bool]" = []
+        # Number of hidden variables emitted so far, see new_hidden_name()
+        self._hidden_names: int = 0
 
     def transpile(self) -> None:
         self.emit_header()
 
         for i in self._module.body:
-            i_type = type(i)
-            if i_type is ast.AnnAssign:
-                self.emit_ann_assign(buffer=self._buffer, ann_assign=i)
-            elif i_type is ast.Expr:
-                self.emit_expr(buffer=self._buffer, expr=i)
-            else:
-                print(f"Unsupported type {i_type}", flush=True, file=sys.stderr)
-                continue
+            if type(i) is ast.FunctionDef:
+                self.emit_function_def(buffer=self._buffer, function_def=i)
+
+        self._buffer.write("int main() {\n")
+        self._representations = analyze(function=self._module)
+        self._read_only_slices = find_read_only_slices(function=self._module)
+        self._scoped_closures = find_scoped_closures(function=self._module)
 
-            self._buffer.write("\n")
+        for i in self._module.body:
+            if type(i) is not ast.FunctionDef:
+                self.emit_statement(buffer=self._buffer, statement=i)
 
         self.emit_footer()
 
@@ -58,16 +135,48 @@ class Transpiler:
 
 using namespace mamba;
 
-int main() {
 """
         )
 
     def emit_footer(self) -> None:
         self._buffer.write("}\n")
 
-    def translate_mamba_type_to_cpp(self, annotation: ast.Name) -> str:
+    def translate_mamba_type_to_cpp(self, annotation: ast.expr) -> str:
+        if (
+            isinstance(annotation, ast.Subscript)
+            and annotation.value.id in self.mamba_generator_annotations
+        ):
+            # Only the return types of generator functions are generators
+            return self.translate_iterator_type(annotation=annotation)
+
+        if isinstance(annotation, ast.Subscript):
+            elements: "list[ast.expr]" = (
+                annotation.slice.elts
+                if isinstance(annotation.slice, ast.Tuple)
+                else [annotation.slice]
+            )
+            args: str = ", ".join(
+                self.translate_mamba_type_to_cpp(annotation=i) for i in elements
+            )
+
+            return f"{self.mamba_type_to_cpp[annotation.value.id]}<{args}>"
+
         return self.mamba_type_to_cpp[annotation.id]
 
+    def translate_declared_type(
+        self, annotation: ast.expr, representation: Representation
+    ) -> str:
+        cpp_type: str = self.translate_mamba_type_to_cpp(annotation=annotation)
+
+        if representation is Representation.HANDLE:
+            return f"{self.handle_type}<{cpp_type}>"
+
+        return cpp_type
+
+    def container_representation(self, symbol_name: str) -> Representation:
+        # Containers that were not analyzed, e.g. parameters, are handles
+        return self._representations.get(symbol_name, Representation.HANDLE)
+
     def current_scope(self) -> Scope:
         if self._non_root_scopes:
             return self._non_root_scopes[-1]
@@ -77,32 +186,743 @@ int main() {
     def pop_scope(self) -> None:
         if self._non_root_scopes:
             self._non_root_scopes.pop()
+            return
 
         raise EmptyScopePopException("Attempted to pop scope when scope list is empty")
 
-    def push_scope(self) -> Scope:
+    def push_scope(self, name: str) -> Scope:
         parent: Scope = self._root_scope
 
         if self._non_root_scopes:
             parent: Scope = self._non_root_scopes[-1]
 
-        self._non_root_scopes.append(Scope(parent=parent))
+        self._non_root_scopes.append(Scope(name=name, parent=parent))
+
+        return self._non_root_scopes[-1]
+
+    def emit_function_def(
+        self, buffer: io.StringIO, function_def: ast.FunctionDef
+    ) -> None:
+        scope: Scope = self.push_scope(name=function_def.name)
+        self._representations = analyze(function=function_def)
+        self._read_only_slices = find_read_only_slices(function=function_def)
+        self._scoped_closures = find_scoped_closures(function=function_def)
+
+        params: "list[str]" = []
+
+        for arg in function_def.args.args:
+            param_type: str = self.translate_declared_type(
+                annotation=arg.annotation,
+                representation=(
+                    Representation.HANDLE
+                    if is_container_annotation(arg.annotation)
+                    else Representation.VALUE
+                ),
+            )
+            scope.define_symbol(name=arg.arg, decltype=param_type)
+            params.append(f"{param_type} {arg.arg}")
+
+        return_type: str = "void"
+
+        if self.is_generator(function_def=function_def) or self.returns_iterator(
+            function_def=function_def
+        ):
+            # Generator functions are coroutines returning a new generator
+            return_type = self.translate_generator_type(
+                annotation=function_def.returns
+            )
+        elif function_def.returns and not (
+            isinstance(function_def.returns, ast.Constant)
+            and function_def.returns.value is None
+        ):
+            # Returned containers escape by definition
+            return_type = self.translate_declared_type(
+                annotation=function_def.returns,
+                representation=(
+                    Representation.HANDLE
+                    if is_container_annotation(function_def.returns)
+                    else Representation.VALUE
+                ),
+            )
+
+        buffer.write(f"{return_type} {function_def.name}({', '.join(params)}) {{\n")
+
+        for i in function_def.body:
+            self.emit_statement(buffer=buffer, statement=i)
+
+        buffer.write("}\n\n")
+
+        self.pop_scope()
+        self._representations = {}
+        self._read_only_slices = set()
+        self._scoped_closures = set()
+
+    def is_generator(self, function_def: ast.FunctionDef) -> bool:
+        """Returns whether function_def yields, not counting nested scopes."""
+        nodes: "list[ast.AST]" = list(function_def.body)
+
+        while nodes:
+            node: ast.AST = nodes.pop()
+
+            if isinstance(node, (ast.Yield, ast.YieldFrom)):
+                return True
+
+            if not isinstance(node, NESTED_SCOPE_NODES):
+                nodes.extend(ast.iter_child_nodes(node))
+
+        return False
+
+    def returns_iterator(self, function_def: ast.FunctionDef) -> bool:
+        """Returns whether function_def returns an iterator, e.g. a pipeline of
+        adaptors, without yielding."""
+        annotation: Optional[ast.expr] = function_def.returns
+
+        return (
+            isinstance(annotation, ast.Subscript)
+            and isinstance(annotation.value, ast.Name)
+            and annotation.value.id in self.mamba_generator_annotations
+            and not self.is_generator(function_def=function_def)
+        )
+
+    def translate_generator_type(self, annotation: Optional[ast.expr]) -> str:
+        yield_type: Optional[str] = self.translate_yield_type(annotation=annotation)
+
+        if yield_type is None:
+            print(
+                "Unsupported generator function without an Iterator[T] or "
+                "Generator[T, None, None] return annotation",
+                flush=True,
+                file=sys.stderr,
+            )
+            return ""
+
+        return f"{self.handle_type}<{self.generator_type}<{yield_type}>>"
+
+    def translate_iterator_type(self, annotation: ast.Subscript) -> str:
+        yield_type: Optional[str] = self.translate_yield_type(annotation=annotation)
+
+        return f"{self.handle_type}<{self.iterator_type}<{yield_type}>>"
+
+    def translate_yield_type(self, annotation: Optional[ast.expr]) -> Optional[str]:
+        """Translates the type of the values of an iterator annotation, e.g.
+        Iterator[T] or Generator[T, None, None], or returns None if annotation
+        is not one."""
+        if not (
+            isinstance(annotation, ast.Subscript)
+            and isinstance(annotation.value, ast.Name)
+            and annotation.value.id in self.mamba_generator_annotations
+        ):
+            return None
+
+        yield_annotation: ast.expr = (
+            annotation.slice.elts[0]
+            if isinstance(annotation.slice, ast.Tuple)
+            else annotation.slice
+        )
+
+        # Yielded containers escape by definition
+        return self.translate_declared_type(
+            annotation=yield_annotation,
+            representation=(
+                Representation.HANDLE
+                if is_container_annotation(yield_annotation)
+                else Representation.VALUE
+            ),
+        )
+
+    def emit_statement(self, buffer: io.StringIO, statement: ast.stmt) -> None:
+        statement_type = type(statement)
+
+        if statement_type is ast.AnnAssign:
+            self.emit_ann_assign(buffer=buffer, ann_assign=statement)
+        elif statement_type is ast.Expr:
+            self.emit_expr(buffer=buffer, expr=statement)
+        elif statement_type is ast.Return:
+            self.emit_return(buffer=buffer, return_=statement)
+        elif statement_type is ast.AugAssign:
+            self.emit_aug_assign(buffer=buffer, aug_assign=statement)
+        elif statement_type is ast.For:
+            self.emit_for(buffer=buffer, for_=statement)
+        elif statement_type is ast.Break:
+            self.emit_break(buffer=buffer)
+        elif statement_type is ast.Continue:
+            self.emit_continue(buffer=buffer)
+        elif statement_type is ast.ImportFrom and statement.module == "typing":
+            # Only needed for annotations, e.g. Iterator[int]
+            return
+        else:
+            print(f"Unsupported type {statement_type}", flush=True, file=sys.stderr)
+            return
+
+        buffer.write("\n")
 
     def emit_ann_assign(self, buffer: io.StringIO, ann_assign: ast.AnnAssign) -> None:
         symbol_name: str = ann_assign.target.id
-        symbol_type: str = self.translate_mamba_type_to_cpp(
-            annotation=ann_assign.annotation
+        representation: Representation = Representation.VALUE
+
+        if is_container_annotation(ann_assign.annotation):
+            representation = self.container_representation(symbol_name)
+
+        symbol_type: str = self.translate_declared_type(
+            annotation=ann_assign.annotation, representation=representation
+        )
+        value: str = self.translate_value(
+            value=ann_assign.value,
+            cpp_type=self.translate_mamba_type_to_cpp(
+                annotation=ann_assign.annotation
+            ),
+            representation=representation,
         )
 
         if self.current_scope().has_symbol(symbol_name):
-            # Make sure value is Constant
-            buffer.write(f'{symbol_name} = "{ann_assign.value.value}";')
+            buffer.write(f"{symbol_name} = {value};")
         else:
-            buffer.write(f'{symbol_type} {symbol_name} = "{ann_assign.value.value}";')
+            buffer.write(f"{symbol_type} {symbol_name} = {value};")
+            self.current_scope().define_symbol(name=symbol_name, decltype=symbol_type)
+
+    def emit_aug_assign(
+        self, buffer: io.StringIO, aug_assign: ast.AugAssign
+    ) -> None:
+        target: str = self.translate_expression(expr=aug_assign.target)
+        op: str = self.mamba_binary_operator_to_cpp[type(aug_assign.op)]
+        value: str = self.translate_expression(expr=aug_assign.value)
+
+        buffer.write(f"{target} {op}= {value};")
+
+    def emit_for(self, buffer: io.StringIO, for_: ast.For) -> None:
+        if for_.orelse:
+            print("Unsupported for..else", flush=True, file=sys.stderr)
+            return
+
+        if self.is_parallel_call(expr=for_.iter):
+            self.emit_parallel_for(buffer=buffer, for_=for_)
+            return
+
+        header: Optional[str] = self.translate_range_for_header(for_=for_)
+
+        if header is None:
+            target: Optional[str] = self.translate_for_target(target=for_.target)
+
+            if target is None:
+                print(
+                    "Unsupported for with a target other than a name or a "
+                    "tuple of names",
+                    flush=True,
+                    file=sys.stderr,
+                )
+                return
+
+            iterable: str = self.translate_expression(expr=for_.iter)
+
+            if self.is_handle(expr=for_.iter):
+                iterable = f"*{iterable}"
+
+            header = f"for (const auto {target} : {iterable})"
+
+        buffer.write(f"{header} {{\n")
+        self.emit_loop_body(buffer=buffer, body=for_.body, parallel=False)
+        buffer.write("}")
+
+    def translate_for_target(self, target: ast.expr) -> Optional[str]:
+        """Translates the target of a for loop, where tuples of names, e.g.
+        for i, x in enumerate(xs), become structured bindings."""
+        if isinstance(target, ast.Name):
+            return target.id
+
+        if isinstance(target, (ast.List, ast.Tuple)) and all(
+            isinstance(i, ast.Name) for i in target.elts
+        ):
+            return f"[{', '.join(i.id for i in target.elts)}]"
+
+        return None
+
+    def is_parallel_call(self, expr: ast.expr) -> bool:
+        return (
+            isinstance(expr, ast.Call)
+            and isinstance(expr.func, ast.Name)
+            and expr.func.id == self.parallel_marker
+            and len(expr.args) == 1
+            and not expr.keywords
+        )
+
+    def emit_parallel_for(self, buffer: io.StringIO, for_: ast.For) -> None:
+        """Lowers for x in parallel(xs) to a ParallelFor() call whose body is a
+        lambda, where continue becomes return. The iterations must be
+        independent of each other."""
+        if not isinstance(for_.target, ast.Name):
+            print(
+                "Unsupported parallel for without a single target",
+                flush=True,
+                file=sys.stderr,
+            )
+            return
+
+        shared_writes: "list[str]" = self.find_shared_writes(for_=for_)
+
+        if shared_writes:
+            print(
+                "Unsupported parallel for that assigns or mutates "
+                f"{', '.join(shared_writes)}, which would race between "
+                "iterations",
+                flush=True,
+                file=sys.stderr,
+            )
+            return
+
+        iterable: str = self.translate_expression(expr=for_.iter.args[0])
+
+        buffer.write(f"ParallelFor({iterable}, [&](const auto {for_.target.id}) {{\n")
+        self.emit_loop_body(buffer=buffer, body=for_.body, parallel=True)
+        buffer.write("});")
+
+    def find_shared_writes(self, for_: ast.For) -> "list[str]":
+        """Returns the names from outside the body of for_ that the body assigns,
+        e.g. total += x, or mutates, e.g. out.append(x), in order of first
+        appearance. Names that the body declares, e.g. y: int = x, and the
+        targets of loops within it are local to each iteration."""
+        nodes: "list[ast.AST]" = [
+            i for statement in for_.body for i in ast.walk(statement)
+        ]
+        local: "set[str]" = {for_.target.id}
+
+        for node in nodes:
+            if isinstance(node, ast.AnnAssign) and isinstance(node.target, ast.Name):
+                local.add(node.target.id)
+            elif isinstance(node, (ast.For, ast.comprehension)):
+                local.update(
+                    i.id for i in ast.walk(node.target) if isinstance(i, ast.Name)
+                )
+
+        shared: "list[str]" = []
+
+        for node in nodes:
+            name: Optional[ast.expr] = None
+
+            if isinstance(node, ast.Name) and not isinstance(node.ctx, ast.Load):
+                name = node
+            elif isinstance(node, (ast.Attribute, ast.Subscript)) and not isinstance(
+                node.ctx, ast.Load
+            ):
+                # e.g. out[0] = x
+                name = node.value
+            elif (
+                isinstance(node, ast.Call)
+                and isinstance(node.func, ast.Attribute)
+                and node.func.attr not in READ_ONLY_METHODS
+            ):
+                # e.g. out.append(x)
+                name = node.func.value
+
+            if (
+                isinstance(name, ast.Name)
+                and name.id not in local
+                and name.id not in shared
+            ):
+                shared.append(name.id)
+
+        return shared
+
+    def emit_loop_body(
+        self, buffer: io.StringIO, body: "list[ast.stmt]", parallel: bool
+    ) -> None:
+        self._loops.append(parallel)
+
+        for i in body:
+            self.emit_statement(buffer=buffer, statement=i)
+
+        self._loops.pop()
+
+    def emit_break(self, buffer: io.StringIO) -> None:
+        if self._loops and self._loops[-1]:
+            print("Unsupported break in a parallel for", flush=True, file=sys.stderr)
+            return
+
+        buffer.write("break;")
+
+    def emit_continue(self, buffer: io.StringIO) -> None:
+        # The body of a parallel for is a lambda called once per element
+        buffer.write("return;" if self._loops and self._loops[-1] else "continue;")
+
+    def translate_range_for_header(self, for_: ast.For) -> Optional[str]:
+        """Translates for i in range(...) to a plain counted loop, so that the
+        C++ compiler can unroll and vectorize it. Returns None if for_ does not
+        loop over a range."""
+        call: ast.expr = for_.iter
+
+        if not (
+            isinstance(for_.target, ast.Name)
+            and isinstance(call, ast.Call)
+            and isinstance(call.func, ast.Name)
+            and call.func.id == "range"
+            and 1 <= len(call.args) <= 3
+            and not call.keywords
+        ):
+            return None
+
+        name: str = for_.target.id
+        int_type: str = self.mamba_type_to_cpp["int"]
+        args: "list[str]" = [self.translate_expression(expr=i) for i in call.args]
+
+        if len(args) == 1:
+            args.insert(0, "0")
+
+        if any(
+            isinstance(i, ast.Name) and i.id == name and not isinstance(i.ctx, ast.Load)
+            for statement in for_.body
+            for i in ast.walk(statement)
+        ):
+            # Assigning to the target must not change which numbers come next,
+            # so iterate over an actual range, which counts by index
+            return f"for ({int_type} {name} : Range({', '.join(args)}))"
+
+        step: Optional[int] = 1
+
+        if len(call.args) == 3:
+            step = self.constant_int_value(expr=call.args[2])
+
+        if step not in (1, -1):
+            # A step that is unknown until runtime may be zero, which must
+            # raise ValueError, and a larger one may step past the largest
+            # int before reaching stop, so iterate over an actual range
+            return f"for (const {int_type} {name} : Range({', '.join(args)}))"
+
+        comparison: str = "<" if step > 0 else ">"
+        increment: str = f"++{name}" if step > 0 else f"--{name}"
+
+        # range() evaluates its arguments once, so the stop is kept aside in
+        # case the loop changes it. Stepping by one never overflows, since it
+        # stops at stop.
+        stop: str = self.new_hidden_name(prefix="stop")
+
+        return (
+            f"for ({int_type} {name} = {args[0]}, {stop} = {args[1]}; "
+            f"{name} {comparison} {stop}; {increment})"
+        )
+
+    def new_hidden_name(self, prefix: str) -> str:
+        """Returns a new name for a variable that the transpiler introduces.
+        Names starting with __mamba_ are reserved, so it cannot clash with any
+        name from the source, and each call returns a different one."""
+        self._hidden_names += 1
+
+        return f"__mamba_{prefix}_{self._hidden_names}"
+
+    def constant_int_value(self, expr: ast.expr) -> Optional[int]:
+        if isinstance(expr, ast.Constant) and type(expr.value) is int:
+            return expr.value
+
+        if isinstance(expr, ast.UnaryOp) and isinstance(expr.op, ast.USub):
+            value: Optional[int] = self.constant_int_value(expr=expr.operand)
+
+            return -value if value is not None else None
+
+        return None
 
     def emit_expr(self, buffer: io.StringIO, expr: ast.Expr) -> None:
-        call: ast.Call = expr.value
-        func_name: str = call.func.id
-        args: "list[ast.Name]" = call.args
+        if isinstance(expr.value, ast.YieldFrom):
+            self.emit_yield_from(buffer=buffer, yield_from=expr.value)
+            return
+
+        buffer.write(f"{self.translate_expression(expr=expr.value)};")
+
+    def emit_yield_from(self, buffer: io.StringIO, yield_from: ast.YieldFrom) -> None:
+        self.emit_yield_each(buffer=buffer, iterable=yield_from.value)
+
+    def emit_yield_each(self, buffer: io.StringIO, iterable: ast.expr) -> None:
+        cpp_iterable: str = self.translate_expression(expr=iterable)
+
+        if self.is_handle(expr=iterable):
+            cpp_iterable = f"*{cpp_iterable}"
+
+        buffer.write(f"for (const auto elem : {cpp_iterable}) {{\nco_yield elem;\n}}")
+
+    def emit_return(self, buffer: io.StringIO, return_: ast.Return) -> None:
+        if any(self._loops):
+            print("Unsupported return in a parallel for", flush=True, file=sys.stderr)
+            return
+
+        function_def: ast.FunctionDef = self.current_function_def()
+
+        if self.is_generator(function_def=function_def):
+            if return_.value is not None:
+                print(
+                    "Unsupported return with a value in a generator",
+                    flush=True,
+                    file=sys.stderr,
+                )
+
+            buffer.write("co_return;")
+            return
+
+        if self.returns_iterator(function_def=function_def):
+            # The iterator is lowered to a generator yielding its values, whose
+            # coroutine frame keeps the parameters that it iterates over alive
+            if return_.value is not None:
+                self.emit_yield_each(buffer=buffer, iterable=return_.value)
+                buffer.write("\n")
+
+            buffer.write("co_return;")
+            return
+
+        if return_.value is None:
+            buffer.write("return;")
+            return
+
+        value: str = self.translate_value(
+            value=return_.value,
+            cpp_type=self.translate_mamba_type_to_cpp(annotation=function_def.returns),
+            representation=Representation.HANDLE,
+        )
+
+        buffer.write(f"return {value};")
+
+    def current_function_def(self) -> ast.FunctionDef:
+        name: str = self.current_scope().name()
+
+        return next(
+            i
+            for i in self._module.body
+            if type(i) is ast.FunctionDef and i.name == name
+        )
+
+    def translate_value(
+        self, value: ast.expr, cpp_type: str, representation: Representation
+    ) -> str:
+        """Translates the initial value of a variable of type cpp_type, where
+        container literals become either values or newly created handles."""
+        if isinstance(value, (ast.List, ast.Tuple)):
+            elements: str = ", ".join(
+                self.translate_expression(expr=i) for i in value.elts
+            )
+
+            if representation is Representation.HANDLE:
+                return f"{cpp_type}::Init({elements})"
+
+            return f"{{{elements}}}"
+
+        iterable: Optional[ast.expr] = None
+
+        if isinstance(value, ast.ListComp):
+            iterable = value
+        elif (
+            isinstance(value, ast.Call)
+            and isinstance(value.func, ast.Name)
+            and value.func.id in self.mamba_container_constructors
+            and len(value.args) == 1
+        ):
+            iterable = value.args[0]
+
+        if iterable is not None:
+            # Fills the container straight from the (lazy) iterable
+            source: str = self.translate_expression(expr=iterable)
+
+            if representation is Representation.HANDLE:
+                return f"{cpp_type}::Init({source})"
+
+            return f"{cpp_type}({source})"
+
+        return self.translate_expression(expr=value)
+
+    def translate_expression(self, expr: ast.expr) -> str:
+        if isinstance(expr, ast.Constant):
+            if isinstance(expr.value, bool):
+                return "true" if expr.value else "false"
+            if isinstance(expr.value, str):
+                return f'"{expr.value}"'
+
+            return str(expr.value)
+
+        if isinstance(expr, ast.Name):
+            return expr.id
+
+        if isinstance(expr, ast.BinOp):
+            op: str = self.mamba_binary_operator_to_cpp[type(expr.op)]
+            lhs: str = self.translate_expression(expr=expr.left)
+            rhs: str = self.translate_expression(expr=expr.right)
+
+            return f"{lhs} {op} {rhs}"
+
+        if isinstance(expr, ast.UnaryOp):
+            op: str = self.mamba_unary_operator_to_cpp[type(expr.op)]
+
+            return f"{op}{self.translate_expression(expr=expr.operand)}"
+
+        if isinstance(expr, ast.Compare):
+            operands: "list[str]" = [
+                self.translate_expression(expr=i)
+                for i in [expr.left, *expr.comparators]
+            ]
+            # Chained comparisons, e.g. a < b < c, become a < b && b < c
+            comparisons: "list[str]" = [
+                f"{lhs} {self.mamba_comparison_operator_to_cpp[type(op)]} {rhs}"
+                for lhs, op, rhs in zip(operands, expr.ops, operands[1:])
+            ]
+
+            return " && ".join(comparisons)
+
+        if isinstance(expr, ast.BoolOp):
+            op: str = self.mamba_boolean_operator_to_cpp[type(expr.op)]
+
+            return f" {op} ".join(
+                f"({self.translate_expression(expr=i)})" for i in expr.values
+            )
+
+        if isinstance(expr, ast.Lambda):
+            params: "list[str]" = [f"auto {i.arg}" for i in expr.args.args]
+
+            return self.translate_lambda(
+                params=params, body=expr.body, closure=expr
+            )
+
+        if isinstance(expr, (ast.GeneratorExp, ast.ListComp)):
+            return self.translate_generator(generator=expr)
+
+        if isinstance(expr, ast.Yield):
+            if expr.value is None:
+                print("Unsupported yield without a value", flush=True, file=sys.stderr)
+                return ""
+
+            return f"co_yield {self.translate_expression(expr=expr.value)}"
+
+        if isinstance(expr, ast.Call):
+            args: str = ", ".join(self.translate_expression(expr=i) for i in expr.args)
+
+            if isinstance(expr.func, ast.Attribute):
+                return f"{self.translate_method(attribute=expr.func)}({args})"
+
+            func_name: str = self.mamba_function_to_cpp.get(expr.func.id, expr.func.id)
+
+            return f"{func_name}({args})"
+
+        if isinstance(expr, ast.Subscript):
+            return self.translate_subscript(subscript=expr)
+
+        print(f"Unsupported expression {type(expr)}", flush=True, file=sys.stderr)
+        return ""
+
+    def translate_lambda(
+        self,
+        params: "list[str]",
+        body: ast.expr,
+        closure: ast.expr,
+        prologue: str = "",
+    ) -> str:
+        """Translates body as a lambda for closure, the Python lambda or
+        comprehension that it comes from. Closures that may outlive the
+        statement creating them, e.g. returned generators, capture by value,
+        which copies handles rather than leaving references to locals."""
+        capture: str = "&" if closure in self._scoped_closures else "="
+
+        return (
+            f"[{capture}]({', '.join(params)}) {{ "
+            f"{prologue}return {self.translate_expression(expr=body)}; }}"
+        )
+
+    def translate_element_lambda(
+        self, target: ast.expr, body: ast.expr, closure: ast.expr
+    ) -> str:
+        """Translates body as a lambda taking one element of an iterable that
+        is bound to target, e.g. the x or (i, x) of a comprehension."""
+        if isinstance(target, ast.Name):
+            return self.translate_lambda(
+                params=[f"auto {target.id}"], body=body, closure=closure
+            )
+
+        names: str = ", ".join(i.id for i in target.elts)
+
+        return self.translate_lambda(
+            params=["const auto& elem"],
+            body=body,
+            closure=closure,
+            prologue=f"const auto& [{names}] = elem; ",
+        )
+
+    def translate_generator(self, generator: ast.GeneratorExp) -> str:
+        """Lowers a generator expression or list comprehension onto the lazy
+        adaptors, e.g. (f(x) for x in xs if p(x)) becomes
+        Map(f', Filter(p', xs)), so that chained generators fuse into a single
+        loop without intermediate lists."""
+        if len(generator.generators) != 1 or generator.generators[0].is_async:
+            print(
+                "Unsupported comprehension with multiple or async for clauses",
+                flush=True,
+                file=sys.stderr,
+            )
+            return ""
+
+        comprehension: ast.comprehension = generator.generators[0]
+        target: ast.expr = comprehension.target
+        result: str = self.translate_expression(expr=comprehension.iter)
+
+        if comprehension.ifs:
+            condition: ast.expr = (
+                ast.BoolOp(op=ast.And(), values=comprehension.ifs)
+                if len(comprehension.ifs) > 1
+                else comprehension.ifs[0]
+            )
+            predicate: str = self.translate_element_lambda(
+                target=target, body=condition, closure=generator
+            )
+            result = f"Filter({predicate}, {result})"
+
+        # Identity maps, e.g. (x for x in xs if p(x)), are left out
+        if not (
+            isinstance(target, ast.Name)
+            and isinstance(generator.elt, ast.Name)
+            and target.id == generator.elt.id
+        ):
+            func: str = self.translate_element_lambda(
+                target=target, body=generator.elt, closure=generator
+            )
+            result = f"Map({func}, {result})"
+
+        return result
+
+    def is_handle(self, expr: ast.expr) -> bool:
+        if not isinstance(expr, ast.Name):
+            return False
+
+        decltype: Optional[str] = self.current_scope().symbol_type(name=expr.id)
+
+        return bool(decltype) and decltype.startswith(self.handle_type)
+
+    def translate_method(self, attribute: ast.Attribute) -> str:
+        receiver: str = self.translate_expression(expr=attribute.value)
+        accessor: str = "->" if self.is_handle(expr=attribute.value) else "."
+
+        # e.g. append() -> Append()
+        method: str = "".join(i.capitalize() for i in attribute.attr.split("_"))
+
+        return f"{receiver}{accessor}{method}"
+
+    def translate_subscript(self, subscript: ast.Subscript) -> str:
+        receiver: str = self.translate_expression(expr=subscript.value)
+
+        if not isinstance(subscript.slice, ast.Slice):
+            index: str = self.translate_expression(expr=subscript.slice)
+
+            if self.is_handle(expr=subscript.value):
+                return f"(*{receiver})[{index}]"
+
+            return f"{receiver}[{index}]"
+
+        accessor: str = "->" if self.is_handle(expr=subscript.value) else "."
+        # Slices that are only read become views instead of new lists
+        method: str = "View" if subscript in self._read_only_slices else "Slice"
+
+        defaults: "list[str]" = ["0", "mamba::kEndIndex", "1"]
+        bounds: "list[Optional[ast.expr]]" = [
+            subscript.slice.lower,
+            subscript.slice.upper,
+            subscript.slice.step,
+        ]
+        args: "list[str]" = [
+            self.translate_expression(expr=i) if i else default
+            for i, default in zip(bounds, defaults)
+        ]
+
+        # Drop trailing default arguments
+        while args and args[-1] == defaults[len(args) - 1]:
+            args.pop()
 
-        buffer.write(f"{func_name}({args[0].id});")
+        return f"{receiver}{accessor}{method}({', '.join(args)})"
@@ -0,0 +1,242 @@
+import ast
+import textwrap
+import unittest
+
+from mamba.escape import Representation, analyze, find_read_only_slices
+
+
+def parse_function(source: str) -> ast.FunctionDef:
+    """Returns the first function that source defines."""
+    module: ast.Module = ast.parse(source=textwrap.dedent(source))
+
+    return next(i for i in module.body if isinstance(i, ast.FunctionDef))
+
+
+def slice_sources(source: str) -> "set[str]":
+    """Returns the read-only slices of the first function in source."""
+    return {
+        ast.unparse(i) for i in find_read_only_slices(function=parse_function(source))
+    }
+
+
+class AnalyzeTest(unittest.TestCase):
+    def test_local_containers_are_values(self) -> None:
+        representations = analyze(
+            function=parse_function(
+                """
+                def f(n: int) -> int:
+                    xs: list[int] = []
+                    ys = [1, 2]
+                    xs.append(n)
+                    for y in ys:
+                        xs[0] += y
+                    return len(xs) + xs[0] + sum(ys)
+                """
+            )
+        )
+
+        self.assertEqual(
+            representations,
+            {"xs": Representation.VALUE, "ys": Representation.VALUE},
+        )
+
+    def test_parameters_and_non_containers_are_not_candidates(self) -> None:
+        representations = analyze(
+            function=parse_function(
+                """
+                def f(xs: list[int]) -> None:
+                    n: int = 0
+                    xs.append(n)
+                """
+            )
+        )
+
+        self.assertEqual(representations, {})
+
+    def test_returned_yielded_and_aliased_containers_are_handles(self) -> None:
+        representations = analyze(
+            function=parse_function(
+                """
+                def f() -> list[int]:
+                    a: list[int] = []
+                    b: list[int] = []
+                    c: list[int] = []
+                    d: list[int] = c
+                    e: list[int] = []
+                    f: list[int] = []
+                    g: list[int] = []
+                    yield b
+                    other(e)
+                    h = [f]
+                    h.append(g)
+                    return a
+                """
+            )
+        )
+
+        for name in ["a", "b", "c", "d", "e", "f", "g"]:
+            self.assertEqual(representations[name], Representation.HANDLE, name)
+
+        self.assertEqual(representations["h"], Representation.VALUE)
+
+    def test_captured_containers_are_handles(self) -> None:
+        representations = analyze(
+            function=parse_function(
+                """
+                def f() -> None:
+                    xs: list[int] = []
+                    ys: list[int] = []
+                    g = lambda: len(xs)
+                    zs = (v for v in ys)
+                    return zs
+                """
+            )
+        )
+
+        self.assertEqual(representations["xs"], Representation.HANDLE)
+        self.assertEqual(representations["ys"], Representation.HANDLE)
+
+    def test_containers_used_as_keys_are_handles(self) -> None:
+        representations = analyze(
+            function=parse_function(
+                """
+                def f() -> None:
+                    d: dict[tuple[int], int] = {}
+                    t: tuple[int] = (1,)
+                    u: tuple[int] = (2,)
+                    xs: list[int] = [3]
+                    d[t] = 3
+                    print(d[u])
+                    print(xs[0])
+                """
+            )
+        )
+
+        self.assertEqual(representations["d"], Representation.VALUE)
+        self.assertEqual(representations["t"], Representation.HANDLE)
+        self.assertEqual(representations["u"], Representation.HANDLE)
+        self.assertEqual(representations["xs"], Representation.VALUE)
+
+    def test_global_and_nonlocal_containers_are_handles(self) -> None:
+        representations = analyze(
+            function=parse_function(
+                """
+                def f() -> None:
+                    global xs
+                    xs = []
+                """
+            )
+        )
+
+        self.assertEqual(representations, {"xs": Representation.HANDLE})
+
+
+class FindReadOnlySlicesTest(unittest.TestCase):
+    def test_slices_that_are_only_read(self) -> None:
+        self.assertEqual(
+            slice_sources(
+                """
+                def f() -> None:
+                    xs: list[int] = [1, 2, 3]
+                    for x in xs[1:]:
+                        print(x)
+                    print(sum(xs[:2]))
+                    print(xs[::2][0])
+                    print(xs[1:] == xs[:1])
+                """
+            ),
+            {"xs[1:]", "xs[:2]", "xs[::2]", "xs[:1]"},
+        )
+
+    def test_slices_that_are_kept(self) -> None:
+        self.assertEqual(
+            slice_sources(
+                """
+                def f() -> None:
+                    xs: list[int] = [1, 2, 3]
+                    ys = xs[1:]
+                    other(xs[2:])
+                    xs[3:].append(1)
+                """
+            ),
+            set(),
+        )
+
+    def test_slices_of_containers_that_change_during_the_loop(self) -> None:
+        self.assertEqual(
+            slice_sources(
+                """
+                def f() -> None:
+                    xs: list[int] = [1]
+                    ys: list[int] = [2]
+                    zs: list[int] = [3]
+                    ws: list[int] = [4]
+                    for x in xs[1:]:
+                        xs.append(x)
+                    for y in ys[1:]:
+                        ys[0] = y
+                    for z in zs[1:]:
+                        zs = []
+                    for w in ws[1:]:
+                        print(ws.count(w))
+                """
+            ),
+            {"ws[1:]"},
+        )
+
+    def test_slices_of_aliased_containers(self) -> None:
+        self.assertEqual(
+            slice_sources(
+                """
+                def f() -> None:
+                    ws: list[int] = [1, 2]
+                    vs = ws
+                    for y in ws[1:]:
+                        vs.append(y)
+                """
+            ),
+            set(),
+        )
+
+    def test_slices_of_parameters(self) -> None:
+        # xs and ys may be the same list
+        self.assertEqual(
+            slice_sources(
+                """
+                def k(xs: list[int], ys: list[int]) -> None:
+                    for y in xs[1:]:
+                        ys.append(y)
+                """
+            ),
+            set(),
+        )
+
+    def test_slices_that_are_alive_across_yield(self) -> None:
+        # The caller may change xs while the generator is suspended
+        self.assertEqual(
+            slice_sources(
+                """
+                def g(xs: list[int]) -> Iterator[int]:
+                    for y in xs[1:]:
+                        yield y
+                """
+            ),
+            set(),
+        )
+
+    def test_slices_of_locals_are_never_alive_across_yield(self) -> None:
+        self.assertEqual(
+            slice_sources(
+                """
+                def g() -> Iterator[int]:
+                    xs: list[int] = [1, 2]
+                    for y in xs[1:]:
+                        yield y
+                """
+            ),
+            set(),
+        )
+
+
+if __name__ == "__main__":
+    unittest.main()
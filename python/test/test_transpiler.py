@@ -0,0 +1,463 @@
+import ast
+import contextlib
+import io
+import textwrap
+import unittest
+
+from mamba.transpiler import transpile
+
+
+def transpile_source(source: str) -> "list[str]":
+    """Returns the lines that the transpiler emits for source."""
+    module: ast.Module = ast.parse(source=textwrap.dedent(source))
+
+    return transpile(module=module).splitlines()
+
+
+class ForTest(unittest.TestCase):
+    def test_adaptor_loops(self) -> None:
+        # Kept in sync with Adaptors.RangeBasedForLoops in
+        # cpp/test/test_adaptors.cpp, which compiles and runs these loops
+        lines: "list[str]" = transpile_source(
+            """
+            def loops(xs: list[int], ys: list[int]) -> None:
+                for z in map(lambda v: v * 2, xs):
+                    print(z)
+                for z in filter(lambda v: v > 1, xs):
+                    print(z)
+                for a, b in zip(xs, ys):
+                    print(a * b)
+                for i, y in enumerate(ys):
+                    print(i + y)
+                for z in reversed(xs):
+                    print(z)
+                for z in (v * 10 for v in xs if v != 2):
+                    print(z)
+            """
+        )
+
+        for header in [
+            "for (const auto z : Map([&](auto v) { return v * 2; }, xs)) {",
+            "for (const auto z : Filter([&](auto v) { return v > 1; }, xs)) {",
+            "for (const auto [a, b] : Zip(xs, ys)) {",
+            "for (const auto [i, y] : Enumerate(ys)) {",
+            "for (const auto z : Reversed(xs)) {",
+            "for (const auto z : Map([&](auto v) { return v * 10; }, "
+            "Filter([&](auto v) { return v != 2; }, xs))) {",
+        ]:
+            self.assertIn(header, lines)
+
+    def test_yield_from_adaptor(self) -> None:
+        # Kept in sync with Adaptors.YieldFrom in cpp/test/test_adaptors.cpp
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def doubled(xs: list[int]) -> Iterator[int]:
+                yield from map(lambda v: v * 2, xs)
+            """
+        )
+
+        self.assertIn(
+            "for (const auto elem : Map([&](auto v) { return v * 2; }, xs)) {",
+            lines,
+        )
+        self.assertIn("co_yield elem;", lines)
+
+    def test_unsupported_target(self) -> None:
+        errors = io.StringIO()
+
+        with contextlib.redirect_stderr(errors):
+            lines: "list[str]" = transpile_source(
+                """
+                def f(xs: list[int]) -> None:
+                    for (a, b), c in xs:
+                        print(c)
+                """
+            )
+
+        self.assertIn("Unsupported for", errors.getvalue())
+        self.assertFalse(any(i.startswith("for") for i in lines))
+
+
+class RangeTest(unittest.TestCase):
+    def test_unit_steps_are_counted_loops(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(n: int) -> None:
+                for i in range(n):
+                    print(i)
+                for j in range(n, 0, -1):
+                    print(j)
+            """
+        )
+
+        self.assertIn(
+            "for (mamba::int_t i = 0, __mamba_stop_1 = n; i < __mamba_stop_1; "
+            "++i) {",
+            lines,
+        )
+        self.assertIn(
+            "for (mamba::int_t j = n, __mamba_stop_2 = 0; j > __mamba_stop_2; "
+            "--j) {",
+            lines,
+        )
+
+    def test_stop_does_not_clash_with_locals(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(n: int) -> None:
+                for i in range(n):
+                    i_stop: int = 3
+                    print(i + i_stop)
+            """
+        )
+
+        self.assertIn(
+            "for (mamba::int_t i = 0, __mamba_stop_1 = n; i < __mamba_stop_1; "
+            "++i) {",
+            lines,
+        )
+        self.assertIn("mamba::int_t i_stop = 3;", lines)
+
+    def test_other_steps_iterate_over_a_range(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(n: int, s: int) -> None:
+                for i in range(0, n, 2):
+                    print(i)
+                for j in range(0, n, s):
+                    print(j)
+            """
+        )
+
+        self.assertIn("for (const mamba::int_t i : Range(0, n, 2)) {", lines)
+        self.assertIn("for (const mamba::int_t j : Range(0, n, s)) {", lines)
+
+    def test_assigning_to_the_target_keeps_the_iteration_count(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f() -> None:
+                for i in range(0, 10):
+                    i += 2
+                    print(i)
+            """
+        )
+
+        self.assertIn("for (mamba::int_t i : Range(0, 10)) {", lines)
+
+
+class ParallelTest(unittest.TestCase):
+    def test_parallel_for(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(xs: list[int]) -> None:
+                for x in parallel(xs):
+                    for y in xs:
+                        continue
+                    print(x)
+            """
+        )
+
+        self.assertIn("ParallelFor(xs, [&](const auto x) {", lines)
+        # continue only returns from the lambda of the parallel loop itself
+        self.assertIn("continue;", lines)
+        self.assertNotIn("return;", lines)
+
+    def test_parallel_for_continue_returns(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(xs: list[int]) -> None:
+                for x in parallel(xs):
+                    continue
+            """
+        )
+
+        self.assertIn("return;", lines)
+
+    def test_parallel_for_with_iteration_locals(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(xs: list[int]) -> None:
+                for x in parallel(xs):
+                    y: int = x * 2
+                    y += 1
+                    for z in xs:
+                        y += z
+                    print(y + xs.count(x))
+            """
+        )
+
+        self.assertIn("ParallelFor(xs, [&](const auto x) {", lines)
+        self.assertIn("y += 1;", lines)
+
+    def test_parallel_for_with_shared_writes_is_rejected(self) -> None:
+        for body in [
+            "total += x",
+            "out.append(x)",
+            "out[0] += x",
+            "total = x",
+        ]:
+            errors = io.StringIO()
+
+            with contextlib.redirect_stderr(errors):
+                lines: "list[str]" = transpile_source(
+                    f"""
+                    def f(xs: list[int], out: list[int]) -> None:
+                        total: int = 0
+                        for x in parallel(xs):
+                            {body}
+                    """
+                )
+
+            self.assertIn("would race between iterations", errors.getvalue(), body)
+            self.assertFalse(any("ParallelFor" in i for i in lines), body)
+
+    def test_parallel_map(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(xs: list[int]) -> int:
+                return sum(parallel_map(lambda v: v * 2, xs))
+            """
+        )
+
+        self.assertIn(
+            "return sum(ParallelMap([&](auto v) { return v * 2; }, xs));", lines
+        )
+
+
+class SliceTest(unittest.TestCase):
+    def test_read_only_slices_are_views(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f() -> None:
+                xs: list[int] = [1, 2, 3]
+                for x in xs[1:]:
+                    print(x + xs.count(x))
+                n: int = sum(xs[1:])
+            """
+        )
+
+        self.assertIn("for (const auto x : xs.View(1)) {", lines)
+        self.assertIn("mamba::int_t n = sum(xs.View(1));", lines)
+
+    def test_slices_of_mutated_containers_are_copies(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f() -> None:
+                xs: list[int] = [1, 2, 3]
+                ys: list[int] = [1, 2, 3]
+                for x in xs[1:]:
+                    xs.append(x)
+                for y in ys[1:]:
+                    ys[0] += y
+            """
+        )
+
+        self.assertIn("for (const auto x : xs.Slice(1)) {", lines)
+        self.assertIn("for (const auto y : ys.Slice(1)) {", lines)
+
+    def test_slices_of_aliased_containers_are_copies(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f() -> None:
+                ws: list[int] = [1, 2, 3]
+                vs: list[int] = ws
+                for y in ws[1:]:
+                    vs.append(y)
+            """
+        )
+
+        self.assertIn("for (const auto y : ws->Slice(1)) {", lines)
+
+    def test_slices_of_parameters_are_copies(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def k(xs: list[int], ys: list[int]) -> None:
+                for y in xs[1:]:
+                    ys.append(y)
+            """
+        )
+
+        self.assertIn("for (const auto y : xs->Slice(1)) {", lines)
+
+    def test_slices_alive_across_yield_are_copies(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def g(xs: list[int]) -> Iterator[int]:
+                for y in xs[1:]:
+                    yield y
+            """
+        )
+
+        # The caller may change xs while the generator is suspended
+        self.assertIn("for (const auto y : xs->Slice(1)) {", lines)
+
+    def test_slices_that_outlive_their_statement_are_copies(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def f(xs: list[int]) -> Iterator[int]:
+                return (x * 2 for x in xs[1:])
+            """
+        )
+
+        self.assertIn(
+            "for (const auto elem : Map([=](auto x) { return x * 2; }, "
+            "xs->Slice(1))) {",
+            lines,
+        )
+
+
+class GeneratorTest(unittest.TestCase):
+    def test_yield(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def count(n: int) -> Iterator[int]:
+                for i in range(n):
+                    yield i
+            """
+        )
+
+        self.assertIn(
+            "mamba::handle_t<mamba::generator_t<mamba::int_t>> "
+            "count(mamba::int_t n) {",
+            lines,
+        )
+        self.assertIn("co_yield i;", lines)
+
+    def test_return_in_generator(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def first(xs: list[int]) -> Iterator[int]:
+                for x in xs:
+                    yield x
+                    return
+            """
+        )
+
+        self.assertIn("co_yield x;", lines)
+        self.assertIn("co_return;", lines)
+        self.assertNotIn("return;", lines)
+
+    def test_return_with_a_value_in_generator(self) -> None:
+        errors = io.StringIO()
+
+        with contextlib.redirect_stderr(errors):
+            lines: "list[str]" = transpile_source(
+                """
+                from typing import Iterator
+
+                def first(xs: list[int]) -> Iterator[int]:
+                    yield 1
+                    return 2
+                """
+            )
+
+        self.assertIn("Unsupported return with a value", errors.getvalue())
+        self.assertIn("co_return;", lines)
+
+    def test_generator_over_parameter(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def doubled(xs: list[int]) -> Iterator[int]:
+                for x in xs:
+                    yield x * 2
+            """
+        )
+
+        # The coroutine frame keeps its own handle to the list
+        self.assertIn(
+            "mamba::handle_t<mamba::generator_t<mamba::int_t>> "
+            "doubled(mamba::handle_t<mamba::list_t<mamba::int_t>> xs) {",
+            lines,
+        )
+        self.assertIn("for (const auto x : *xs) {", lines)
+        self.assertIn("co_yield x * 2;", lines)
+
+    def test_iterator_parameters_are_type_erased(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def total(it: Iterator[int]) -> int:
+                return sum(it)
+            """
+        )
+
+        self.assertIn(
+            "mamba::int_t total(mamba::handle_t<mamba::iterator_t<mamba::int_t>> "
+            "it) {",
+            lines,
+        )
+
+
+class ClosureTest(unittest.TestCase):
+    def test_closures_used_by_their_statement_capture_by_reference(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(xs: list[int]) -> None:
+                k: int = 2
+                s: int = sum(v * k for v in xs)
+                b: bool = any(map(lambda v: v > k, xs))
+            """
+        )
+
+        self.assertIn(
+            "mamba::int_t s = sum(Map([&](auto v) { return v * k; }, xs));",
+            lines,
+        )
+        self.assertIn(
+            "mamba::bool_t b = any(Map([&](auto v) { return v > k; }, xs));",
+            lines,
+        )
+
+    def test_escaping_closures_capture_by_value(self) -> None:
+        lines: "list[str]" = transpile_source(
+            """
+            def f(xs: list[int]) -> None:
+                k: int = 2
+                consume(map(lambda v: v * k, xs))
+            """
+        )
+
+        # consume() may keep the iterator, and the lambda with it
+        self.assertIn("consume(Map([=](auto v) { return v * k; }, xs));", lines)
+
+    def test_returned_pipeline(self) -> None:
+        # Kept in sync with Adaptors.ReturnedPipeline in
+        # cpp/test/test_adaptors.cpp, which compiles and runs this generator
+        lines: "list[str]" = transpile_source(
+            """
+            from typing import Iterator
+
+            def scaled(xs: list[int], k: int) -> Iterator[int]:
+                return map(lambda v: v * k, (v + k for v in xs))
+            """
+        )
+
+        self.assertIn(
+            "mamba::handle_t<mamba::generator_t<mamba::int_t>> "
+            "scaled(mamba::handle_t<mamba::list_t<mamba::int_t>> xs, "
+            "mamba::int_t k) {",
+            lines,
+        )
+        self.assertIn(
+            "for (const auto elem : Map([=](auto v) { return v * k; }, "
+            "Map([=](auto v) { return v + k; }, xs))) {",
+            lines,
+        )
+        self.assertIn("co_yield elem;", lines)
+        self.assertIn("co_return;", lines)
+
+if __name__ == "__main__":
+    unittest.main()